@@ -0,0 +1,191 @@
+/*
+   ----------------------------------------------------------------------------
+   | mg-dbx: Mock DB Superserver for network benchmarks                       |
+   | Author: Chris Munt cmunt@mgateway.com                                    |
+   |                    chris.e.munt@gmail.com                                |
+   | Copyright (c) 2019-2026 MGateway Ltd                                     |
+   | Surrey UK.                                                               |
+   | All rights reserved.                                                     |
+   |                                                                          |
+   | http://www.mgateway.com                                                  |
+   |                                                                          |
+   | Licensed under the Apache License, Version 2.0 (the "License"); you may  |
+   | not use this file except in compliance with the License.                 |
+   | You may obtain a copy of the License at                                  |
+   |                                                                          |
+   | http://www.apache.org/licenses/LICENSE-2.0                               |
+   |                                                                          |
+   | Unless required by applicable law or agreed to in writing, software      |
+   | distributed under the License is distributed on an "AS IS" BASIS,        |
+   | WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. |
+   | See the License for the specific language governing permissions and      |
+   | limitations under the License.                                           |
+   ----------------------------------------------------------------------------
+*/
+
+/*
+   A stand-in for the DB Superserver that speaks enough of the mg-dbx wire protocol to measure the network
+   code of mg-dbx without a database:
+
+      node mock-superserver.js [<tcp_port> [<delay_ms>]]
+
+   Global set, get, next and previous are held in memory; all other commands return an empty result.
+   Each response is sent <delay_ms> (default 0) after its command is received, to stand in for the time
+   taken by a remote server.  Commands that arrive in the meantime are read and answered in order, so
+   several requests can be in flight on one connection (as with the 'pipeline' and 'net_async' options).
+*/
+
+var net = require('net');
+
+var DBX_CMND_CLOSE = 2;
+var DBX_CMND_GSET = 11;
+var DBX_CMND_GGET = 12;
+var DBX_CMND_GNEXT = 13;
+var DBX_CMND_GPREVIOUS = 14;
+
+var DBX_DSORT_DATA = 1;
+var DBX_DSORT_EOD = 9;
+var DBX_DTYPE_STR8 = 2;
+
+var DBX_IBUFFER_OFFSET = 15;
+
+function block(value) {
+   var head = Buffer.alloc(5);
+
+   head.writeUInt32LE(value.length, 0);
+   head[4] = (DBX_DSORT_DATA * 20) + DBX_DTYPE_STR8;
+   return Buffer.concat([head, value]);
+}
+
+function collate(key) {
+   return (key !== '' && isFinite(key)) ? [0, Number(key), ''] : [1, 0, key];
+}
+
+function compare(a, b) {
+   var x = collate(a), y = collate(b);
+
+   if (x[0] !== y[0]) return x[0] - y[0];
+   if (x[1] !== y[1]) return x[1] - y[1];
+   return x[2] < y[2] ? -1 : (x[2] > y[2] ? 1 : 0);
+}
+
+function order(data, keys, dir) {
+   var n, ref, result = '';
+   var prefix = JSON.stringify(keys.slice(0, -1)).slice(0, -1);
+   var seed = keys[keys.length - 1];
+
+   for (ref in data) {
+      if (ref.indexOf(prefix) !== 0) continue;
+      n = JSON.parse(ref);
+      if (n.length < keys.length) continue;
+      n = n[keys.length - 1];
+      if (seed !== '' && compare(n, seed) * dir <= 0) continue;
+      if (result === '' || compare(n, result) * dir < 0) result = n;
+   }
+   return result;
+}
+
+function command(data, cmnd, keys) {
+   var ref;
+
+   if (cmnd === DBX_CMND_GSET) {
+      ref = JSON.stringify(keys.slice(0, -1));
+      data[ref] = keys[keys.length - 1];
+      return '';
+   }
+   ref = JSON.stringify(keys);
+   if (cmnd === DBX_CMND_GGET) {
+      return data.hasOwnProperty(ref) ? data[ref] : '';
+   }
+   if (cmnd === DBX_CMND_GNEXT) {
+      return order(data, keys, 1);
+   }
+   if (cmnd === DBX_CMND_GPREVIOUS) {
+      return order(data, keys, -1);
+   }
+   return '';
+}
+
+function serve(socket, data, delay) {
+   var input = Buffer.alloc(0);
+   var greeted = false;
+
+   socket.setNoDelay(true);
+
+   function respond(output, close) {
+      if (delay > 0) {
+         setTimeout(function () {
+            socket.write(output);
+            if (close) socket.end();
+         }, delay);
+         return;
+      }
+      socket.write(output);
+      if (close) socket.end();
+   }
+
+   socket.on('data', function (chunk) {
+      var n, len, cmnd, pos, size, keys, output = [];
+
+      input = input.length ? Buffer.concat([input, chunk]) : chunk;
+
+      if (!greeted) {
+         n = input.indexOf(10);
+         if (n < 0) return;
+         input = input.slice(n + 1);
+         greeted = true;
+         size = Buffer.from('IRIS for UNIX (Ubuntu) 2023.1 (Build 229U) Mock');
+         len = Buffer.alloc(5);
+         len.writeUInt32LE(size.length, 0);
+         socket.write(Buffer.concat([len, size]));
+      }
+
+      while (input.length >= 5) {
+         len = input.readUInt32LE(0);
+         if (input.length < len) break;
+         cmnd = input[4];
+         keys = [];
+         for (pos = DBX_IBUFFER_OFFSET; pos + 5 <= len; pos += 5 + size) {
+            size = input.readUInt32LE(pos);
+            if (Math.floor(input[pos + 4] / 20) === DBX_DSORT_EOD) break;
+            keys.push(input.toString('latin1', pos + 5, pos + 5 + size));
+         }
+         input = input.slice(len);
+
+         if (cmnd === DBX_CMND_CLOSE) {
+            output.push(block(Buffer.alloc(0)));
+            respond(Buffer.concat(output), true);
+            return;
+         }
+         output.push(block(Buffer.from(command(data, cmnd, keys), 'latin1')));
+      }
+
+      /* the responses to all commands read in this pass go back in one write */
+      if (output.length) {
+         respond(output.length === 1 ? output[0] : Buffer.concat(output), false);
+      }
+   });
+
+   socket.on('error', function () {});
+}
+
+function start(port, delay, callback) {
+   var data = {};
+   var server = net.createServer(function (socket) {
+      serve(socket, data, delay);
+   });
+
+   server.listen(port, '127.0.0.1', callback);
+   return server;
+}
+
+module.exports = {start: start};
+
+if (require.main === module) {
+   var port = parseInt(process.argv[2] || '7041', 10);
+   var delay = parseInt(process.argv[3] || '0', 10);
+
+   start(port, delay, function () {
+      console.log('mock DB Superserver listening on 127.0.0.1:' + port + ' (response delay ' + delay + ' ms)');
+   });
+}
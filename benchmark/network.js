@@ -0,0 +1,148 @@
+/*
+   ----------------------------------------------------------------------------
+   | mg-dbx: Network benchmarks (against the mock DB Superserver)             |
+   | Author: Chris Munt cmunt@mgateway.com                                    |
+   |                    chris.e.munt@gmail.com                                |
+   | Copyright (c) 2019-2026 MGateway Ltd                                     |
+   | Surrey UK.                                                               |
+   | All rights reserved.                                                     |
+   |                                                                          |
+   | http://www.mgateway.com                                                  |
+   |                                                                          |
+   | Licensed under the Apache License, Version 2.0 (the "License"); you may  |
+   | not use this file except in compliance with the License.                 |
+   | You may obtain a copy of the License at                                  |
+   |                                                                          |
+   | http://www.apache.org/licenses/LICENSE-2.0                               |
+   |                                                                          |
+   | Unless required by applicable law or agreed to in writing, software      |
+   | distributed under the License is distributed on an "AS IS" BASIS,        |
+   | WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. |
+   | See the License for the specific language governing permissions and      |
+   | limitations under the License.                                           |
+   ----------------------------------------------------------------------------
+*/
+
+/*
+   node network.js <test> [<requests> [<delay_ms>]]
+
+   Each test starts the mock DB Superserver (mock-superserver.js) in a child process on 127.0.0.1:7041 (or on the
+   port in the MG_DBX_PORT environment variable), adding <delay_ms> to each response, and connects to it as it
+   would to an InterSystems IRIS server.
+   The mg-dbx module is loaded from ../build/Release (or from the path in the MG_DBX environment variable).
+
+   Tests:
+
+      gets:      <requests> (default 50000) small synchronous gets, one after the other.  Default delay: 0 ms.
+      pipeline:  <requests> (default 2000) asynchronous gets issued at once over 8 pool threads, first with and
+                 then without the 'pipeline' open() option.  Default delay: 2 ms.
+*/
+
+var path = require('path');
+var child_process = require('child_process');
+
+var mg_dbx = require(process.env.MG_DBX || path.join(__dirname, '..', 'build', 'Release', 'mg-dbx.node'));
+
+var TCP_PORT = parseInt(process.env.MG_DBX_PORT || '7041', 10);
+
+var tests = {
+   gets: {requests: 50000, delay: 0, run: gets},
+   pipeline: {requests: 2000, delay: 2, run: pipeline}
+};
+
+function gets(requests, done) {
+   var db, n, t, errors;
+
+   db = new mg_dbx.dbx();
+   db.open({type: "IRIS", host: "127.0.0.1", tcp_port: TCP_PORT});
+   for (n = 0; n < 100; n ++) {
+      db.set("Bench", n, "value " + n);
+   }
+
+   errors = 0;
+   t = process.hrtime();
+   for (n = 0; n < requests; n ++) {
+      if (db.get("Bench", n % 100) !== "value " + (n % 100)) {
+         errors ++;
+      }
+   }
+   t = process.hrtime(t);
+   t = t[0] * 1e3 + t[1] / 1e6;
+   db.close();
+
+   done([{test: "gets", requests: requests, ms: Math.round(t), requests_per_second: Math.round(requests * 1000 / t), errors: errors}]);
+}
+
+function pipeline(requests, done) {
+   var modes = [true, false];
+   var results = [];
+
+   function next() {
+      var db, n, t, mode, completed, errors, stats;
+
+      if (!modes.length) {
+         return done(results);
+      }
+      mode = modes.shift();
+      db = new mg_dbx.dbx();
+      db.open({type: "IRIS", host: "127.0.0.1", tcp_port: TCP_PORT, pool_async: true, pool_size: 8, pipeline: mode});
+      for (n = 0; n < 100; n ++) {
+         db.set("Bench", n, "value " + n);
+      }
+
+      completed = 0;
+      errors = 0;
+      t = process.hrtime();
+      for (n = 0; n < requests; n ++) {
+         db.get("Bench", n % 100, (function (key) {
+            return function (err, result) {
+               if (err || result !== "value " + key) {
+                  errors ++;
+               }
+               if (++ completed === requests) {
+                  t = process.hrtime(t);
+                  t = t[0] * 1e3 + t[1] / 1e6;
+                  stats = db.poolstats();
+                  db.close();
+                  results.push({pipeline: mode, requests: requests, ms: Math.round(t), requests_per_second: Math.round(requests * 1000 / t), max_depth: stats.pipeline_max_depth, errors: errors});
+                  next();
+               }
+            };
+         })(n % 100));
+      }
+   }
+   next();
+}
+
+function main() {
+   var name = process.argv[2];
+   var test = tests[name];
+   var requests, delay, server;
+
+   if (!test) {
+      console.log('usage: node network.js <test> [<requests> [<delay_ms>]]; tests: ' + Object.keys(tests).join(', '));
+      process.exit(1);
+   }
+   requests = parseInt(process.argv[3] || test.requests, 10);
+   delay = parseInt(process.argv[4] || test.delay, 10);
+
+   server = child_process.fork(path.join(__dirname, 'mock-superserver.js'), [String(TCP_PORT), String(delay)], {silent: true});
+   server.stderr.pipe(process.stderr);
+   server.on('exit', function (code) {
+      if (code) {
+         console.log('The mock DB Superserver could not be started on port ' + TCP_PORT);
+         process.exit(1);
+      }
+   });
+   server.stdout.once('data', function () {
+      test.run(requests, function (results) {
+         results.forEach(function (result) {
+            result.delay_ms = delay;
+            console.log(JSON.stringify(result));
+         });
+         server.kill();
+      });
+   });
+}
+
+main();
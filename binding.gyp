@@ -7,7 +7,10 @@
                     "src/mg-global.cpp",
                     "src/mg-cursor.cpp",
                     "src/mg-class.cpp",
-                    "src/mg-net.cpp"
+                    "src/mg-bulk.cpp",
+                    "src/mg-function.cpp",
+                    "src/mg-net.cpp",
+                    "src/mg-char16.cpp"
                  ]
     }
   ]
@@ -0,0 +1,421 @@
+/*
+   ----------------------------------------------------------------------------
+   | mg-dbx.node                                                              |
+   | Author: Chris Munt cmunt@mgateway.com                                    |
+   |                    chris.e.munt@gmail.com                                |
+   | Copyright (c) 2019-2026 MGateway Ltd                                     |
+   | Surrey UK.                                                               |
+   | All rights reserved.                                                     |
+   |                                                                          |
+   | http://www.mgateway.com                                                  |
+   |                                                                          |
+   | Licensed under the Apache License, Version 2.0 (the "License"); you may  |
+   | not use this file except in compliance with the License.                 |
+   | You may obtain a copy of the License at                                  |
+   |                                                                          |
+   | http://www.apache.org/licenses/LICENSE-2.0                               |
+   |                                                                          |
+   | Unless required by applicable law or agreed to in writing, software      |
+   | distributed under the License is distributed on an "AS IS" BASIS,        |
+   | WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. |
+   | See the License for the specific language governing permissions and      |
+   | limitations under the License.                                           |
+   |                                                                          |
+   ----------------------------------------------------------------------------
+*/
+
+#include "mg-dbx.h"
+#include "mg-bulk.h"
+ 
+using namespace v8;
+using namespace node;
+
+Persistent<Function> mbulk::constructor;
+
+mbulk::mbulk(int value) : dbx_count(value)
+{
+}
+
+
+mbulk::~mbulk()
+{
+   /* records not flushed are discarded */
+   if (pmeth && c && c->pcon) {
+      dbx_request_memory_free(c->pcon, pmeth, 0);
+      pmeth = NULL;
+   }
+}
+
+
+#if DBX_NODE_VERSION >= 100000
+void mbulk::Init(Local<Object> exports)
+#else
+void mbulk::Init(Handle<Object> exports)
+#endif
+{
+#if DBX_NODE_VERSION >= 120000
+#if DBX_NODE_VERSION >= 250000
+   Isolate* isolate = Isolate::GetCurrent();
+#else
+   Isolate* isolate = exports->GetIsolate();
+#endif
+   Local<Context> icontext = isolate->GetCurrentContext();
+
+   Local<FunctionTemplate> tpl = FunctionTemplate::New(isolate, New);
+   tpl->SetClassName(String::NewFromUtf8(isolate, (char *) "mbulk", NewStringType::kNormal).ToLocalChecked());
+   tpl->InstanceTemplate()->SetInternalFieldCount(3);
+#else
+   Isolate* isolate = Isolate::GetCurrent();
+
+   /* Prepare constructor template */
+   Local<FunctionTemplate> tpl = FunctionTemplate::New(isolate, New);
+   tpl->SetClassName(String::NewFromUtf8(isolate, "mbulk"));
+   tpl->InstanceTemplate()->SetInternalFieldCount(3);
+#endif
+
+   /* Prototypes */
+
+   DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "set", Set);
+   DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "flush", Flush);
+   DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "close", Close);
+
+#if DBX_NODE_VERSION >= 120000
+   constructor.Reset(isolate, tpl->GetFunction(icontext).ToLocalChecked());
+   exports->Set(icontext, String::NewFromUtf8(isolate, "mbulk", NewStringType::kNormal).ToLocalChecked(), tpl->GetFunction(icontext).ToLocalChecked()).FromJust();
+#else
+   constructor.Reset(isolate, tpl->GetFunction());
+#endif
+
+}
+
+
+void mbulk::New(const FunctionCallbackInfo<Value>& args)
+{
+   Isolate* isolate = args.GetIsolate();
+#if DBX_NODE_VERSION >= 100000
+   Local<Context> icontext = isolate->GetCurrentContext();
+#endif
+   HandleScope scope(isolate);
+   int fc, mn, argc, otype;
+   DBX_DBNAME *c = NULL;
+   Local<Object> obj;
+
+   argc = args.Length();
+   if (argc > 0) {
+      obj = dbx_is_object(args[0], &otype);
+      if (otype) {
+         fc = obj->InternalFieldCount();
+         if (fc == 3) {
+#if DBX_NODE_VERSION >= 220000
+            mn = obj->GetInternalField(2).As<v8::Value>().As<v8::External>()->Int32Value(icontext).FromJust();
+#else
+            mn = DBX_INT32_VALUE(obj->GetInternalField(2));
+#endif
+            if (mn == DBX_MAGIC_NUMBER) {
+               c = ObjectWrap::Unwrap<DBX_DBNAME>(obj);
+            }
+         }
+      }
+   }
+
+   if (args.IsConstructCall()) {
+      /* Invoked as constructor: `new mbulk(db[, options])` */
+      mbulk * obj = new mbulk(0);
+      obj->c = NULL;
+      obj->pmeth = NULL;
+      obj->batch_size = DBX_BULK_BATCH_SIZE;
+      obj->buffer_size = DBX_BULK_BUFFER_SIZE;
+
+      if (c) {
+         if (c->pcon == NULL) {
+            isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "No Connection to the database", 1)));
+            return;
+         }
+         obj->c = c;
+         if (argc > 1 && mbulk::options(obj, args, 1) < 0) {
+            isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "Invalid option on mbulk::New()", 1)));
+            return;
+         }
+      }
+
+      obj->Wrap(args.This());
+      args.This()->SetInternalField(2, DBX_INTEGER_NEW(DBX_MAGIC_NUMBER_MBULK));
+      args.GetReturnValue().Set(args.This());
+   }
+   else {
+      /* Invoked as plain function `mbulk(...)`, turn into construct call. */
+      const int argc = 1;
+      Local<Value> argv[argc] = { args[0] };
+      Local<Function> cons = Local<Function>::New(isolate, constructor);
+      args.GetReturnValue().Set(cons->NewInstance(isolate->GetCurrentContext(), argc, argv).ToLocalChecked());
+   }
+
+}
+
+
+mbulk * mbulk::NewInstance(const FunctionCallbackInfo<Value>& args)
+{
+   Isolate* isolate = args.GetIsolate();
+   Local<Context> icontext = isolate->GetCurrentContext();
+   HandleScope scope(isolate);
+
+   /* the dbx object is attached by the caller */
+   Local<Function> cons = Local<Function>::New(isolate, constructor);
+   Local<Object> instance = cons->NewInstance(icontext, 0, NULL).ToLocalChecked(); /* Invoke mbulk::New */
+ 
+   mbulk *bx = ObjectWrap::Unwrap<mbulk>(instance);
+
+   args.GetReturnValue().Set(instance);
+
+   return bx;
+}
+
+
+int mbulk::async_callback(mbulk *bx)
+{
+   bx->Unref();
+   return 0;
+}
+
+
+/* { batch_size: <records per flush>, buffer_size: <bytes per flush> } */
+int mbulk::options(mbulk *bx, const FunctionCallbackInfo<Value>& args, int argn)
+{
+   int n, otype, key_len;
+   char name[64];
+   Local<Object> obj;
+   Local<String> key;
+   DBX_DBNAME *c = bx->c;
+   DBX_GET_ICONTEXT;
+
+   obj = dbx_is_object(args[argn], &otype);
+   if (!otype) {
+      return -1;
+   }
+
+#if DBX_NODE_VERSION >= 120000
+   Local<Array> a = obj->GetPropertyNames(icontext).ToLocalChecked();
+#else
+   Local<Array> a = obj->GetPropertyNames();
+#endif
+
+   for (n = 0; n < (int) a->Length(); n ++) {
+      key = DBX_TO_STRING(DBX_GET(a, n));
+      key_len = dbx_string8_length(isolate, key, 0);
+      if (key_len > 60) {
+         return -1;
+      }
+      DBX_WRITE_UTF8(key, (char *) name, sizeof(name));
+
+      if (!strcmp(name, (char *) "batch_size")) {
+         bx->batch_size = (int) DBX_INT32_VALUE(DBX_GET(obj, key));
+         if (bx->batch_size < 1) {
+            bx->batch_size = 1;
+         }
+      }
+      else if (!strcmp(name, (char *) "buffer_size")) {
+         bx->buffer_size = (unsigned int) DBX_INT32_VALUE(DBX_GET(obj, key));
+         if (bx->buffer_size < CACHE_MAXSTRLEN) {
+            bx->buffer_size = CACHE_MAXSTRLEN;
+         }
+      }
+      else {
+         return -1;
+      }
+   }
+
+   return 0;
+}
+
+
+/* Write the records buffered so far and release the request object holding them */
+int mbulk::flush_batch(mbulk *bx, int *count)
+{
+   int rc;
+   DBXCON *pcon = bx->c->pcon;
+   DBXMETH *pmeth = bx->pmeth;
+
+   *count = 0;
+   if (!pmeth) {
+      return CACHE_SUCCESS;
+   }
+   bx->pmeth = NULL;
+
+   rc = CACHE_SUCCESS;
+   if (!pcon->open) {
+      strcpy(pcon->error, "Database not open");
+      rc = CACHE_FAILURE;
+   }
+   else if (pmeth->pbatch->no_items > 0) {
+      if (!pcon->net_connection && pcon->dbtype == DBX_DBTYPE_YOTTADB && pcon->tlevel) {
+         rc = ydb_transaction_task(pmeth, YDB_TPCTX_DB);
+      }
+      else {
+         rc = dbx_setmany(pmeth);
+      }
+   }
+   *count = pmeth->pbatch->no_items - pmeth->pbatch->no_errors;
+
+   dbx_request_memory_free(pcon, pmeth, 0);
+
+   return rc;
+}
+
+
+void mbulk::Set(const FunctionCallbackInfo<Value>& args)
+{
+   int rc, argc, count;
+   unsigned int ibuffer_used;
+   DBXCON *pcon;
+   DBXMETH *pmeth;
+   DBXBATCH *pbatch;
+   mbulk *bx = ObjectWrap::Unwrap<mbulk>(args.This());
+   MG_BULK_CHECK_CLASS(bx);
+   DBX_DBNAME *c = bx->c;
+   DBX_GET_ISOLATE;
+   bx->dbx_count ++;
+
+   pcon = c->pcon;
+   if (pcon->log_functions) {
+      c->LogFunction(c, args, (void *) bx, (char *) "mbulk::set");
+   }
+
+   argc = args.Length();
+   if (argc < 2 || argc >= DBX_MAXARGS) {
+      isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "The mbulk::set method takes a global name, optional keys and a data value", 1)));
+      return;
+   }
+   if (!pcon->open) {
+      isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, pcon->error[0] ? pcon->error : (char *) "Database not open", 1)));
+      return;
+   }
+
+   if (!bx->pmeth) {
+      pmeth = dbx_request_memory(pcon, 0, 2);
+      pbatch = dbx_batch_alloc(DBX_CMND_GSET, bx->batch_size, 2);
+      if (!pmeth || !pbatch) {
+         dbx_batch_free(pbatch);
+         dbx_request_memory_free(pcon, pmeth, 0);
+         isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "No memory available for mbulk::set", 1)));
+         return;
+      }
+      pmeth->pbatch = pbatch;
+      pmeth->ibuffer_used = 0;
+      pmeth->cargc = 0;
+      pmeth->p_dbxfun = dbx_setmany;
+      bx->pmeth = pmeth;
+   }
+   pmeth = bx->pmeth;
+   pbatch = pmeth->pbatch;
+
+   ibuffer_used = pmeth->ibuffer_used;
+   rc = c->BatchReference(c, args, pmeth, pbatch, Local<Array>(), argc);
+   if (rc != CACHE_SUCCESS) {
+      pmeth->ibuffer_used = ibuffer_used; /* discard any part of the rejected record already encoded */
+      isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "Invalid global reference on mbulk::set", 1)));
+      return;
+   }
+
+   if (pbatch->no_items >= pbatch->no_alloc || pmeth->ibuffer_used >= bx->buffer_size) {
+      rc = flush_batch(bx, &count);
+      if (rc != CACHE_SUCCESS && pcon->error_mode == 1) {
+         isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) pcon->error, 1)));
+         return;
+      }
+   }
+
+   /* number of records waiting to be written */
+   args.GetReturnValue().Set(DBX_INTEGER_NEW(bx->pmeth ? bx->pmeth->pbatch->no_items : 0));
+   return;
+}
+
+
+void mbulk::Flush(const FunctionCallbackInfo<Value>& args)
+{
+   short async;
+   int rc, argc, count;
+   DBXCON *pcon;
+   DBXMETH *pmeth;
+   mbulk *bx = ObjectWrap::Unwrap<mbulk>(args.This());
+   MG_BULK_CHECK_CLASS(bx);
+   DBX_DBNAME *c = bx->c;
+   DBX_GET_ISOLATE;
+   bx->dbx_count ++;
+
+   pcon = c->pcon;
+   if (pcon->log_functions) {
+      c->LogFunction(c, args, (void *) bx, (char *) "mbulk::flush");
+   }
+
+   DBX_CALLBACK_FUN(argc, async);
+
+   if (async) {
+      if (!bx->pmeth) {
+         pmeth = dbx_request_memory(pcon, 0, 2);
+         pmeth->pbatch = dbx_batch_alloc(DBX_CMND_GSET, 0, 2);
+         if (!pmeth->pbatch) {
+            dbx_request_memory_free(pcon, pmeth, 0);
+            isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "No memory available for mbulk::flush", 1)));
+            return;
+         }
+         pmeth->p_dbxfun = dbx_setmany;
+      }
+      else {
+         pmeth = bx->pmeth;
+         bx->pmeth = NULL;
+      }
+
+      /* the request object (and the records it holds) passes to the task */
+      DBX_DBNAME::dbx_baton_t *baton = c->dbx_make_baton(c, pmeth);
+      baton->bx = (void *) bx;
+      baton->isolate = isolate;
+      Local<Function> cb = Local<Function>::Cast(args[argc]);
+      baton->cb.Reset(isolate, cb);
+      bx->Ref();
+      if (c->dbx_queue_task((void *) c->dbx_process_task, (void *) c->dbx_invoke_callback_batch, baton, 0)) {
+         char error[DBX_ERROR_SIZE];
+         T_STRCPY(error, _dbxso(error), pcon->error);
+         c->dbx_destroy_baton(baton, pmeth);
+         isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, error, 1)));
+         dbx_request_memory_free(pcon, pmeth, 0);
+         return;
+      }
+      return;
+   }
+
+   rc = flush_batch(bx, &count);
+   if (rc != CACHE_SUCCESS && pcon->error_mode == 1) {
+      isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) pcon->error, 1)));
+      return;
+   }
+
+   args.GetReturnValue().Set(DBX_INTEGER_NEW(count));
+   return;
+}
+
+
+void mbulk::Close(const FunctionCallbackInfo<Value>& args)
+{
+   int rc, count;
+   DBXCON *pcon;
+   mbulk *bx = ObjectWrap::Unwrap<mbulk>(args.This());
+   MG_BULK_CHECK_CLASS(bx);
+   DBX_DBNAME *c = bx->c;
+   DBX_GET_ISOLATE;
+   bx->dbx_count ++;
+
+   pcon = c->pcon;
+   if (pcon->log_functions) {
+      c->LogFunction(c, args, (void *) bx, (char *) "mbulk::close");
+   }
+
+   rc = flush_batch(bx, &count);
+   if (rc != CACHE_SUCCESS && pcon->error_mode == 1) {
+      isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) pcon->error, 1)));
+      return;
+   }
+
+   args.GetReturnValue().Set(DBX_INTEGER_NEW(count));
+   return;
+}
+
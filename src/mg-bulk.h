@@ -0,0 +1,74 @@
+/*
+   ----------------------------------------------------------------------------
+   | mg-dbx.node                                                              |
+   | Author: Chris Munt cmunt@mgateway.com                                    |
+   |                    chris.e.munt@gmail.com                                |
+   | Copyright (c) 2019-2026 MGateway Ltd                                     |
+   | Surrey UK.                                                               |
+   | All rights reserved.                                                     |
+   |                                                                          |
+   | http://www.mgateway.com                                                  |
+   |                                                                          |
+   | Licensed under the Apache License, Version 2.0 (the "License"); you may  |
+   | not use this file except in compliance with the License.                 |
+   | You may obtain a copy of the License at                                  |
+   |                                                                          |
+   | http://www.apache.org/licenses/LICENSE-2.0                               |
+   |                                                                          |
+   | Unless required by applicable law or agreed to in writing, software      |
+   | distributed under the License is distributed on an "AS IS" BASIS,        |
+   | WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. |
+   | See the License for the specific language governing permissions and      |
+   | limitations under the License.                                           |
+   |                                                                          |
+   ----------------------------------------------------------------------------
+*/
+
+#ifndef MG_BULK_H
+#define MG_BULK_H
+
+#define MG_BULK_CHECK_CLASS(a) \
+   if (a->c == NULL) { \
+      v8::Isolate* isolatex = args.GetIsolate(); \
+      isolatex->ThrowException(v8::Exception::Error(dbx_new_string8(isolatex, (char *) "Error in the instantiation of the mbulk class", 1))); \
+      return; \
+   } \
+
+/* v2.5.35 Bulk loader: buffers sets and writes them to the database a batch at a time */
+class mbulk : public node::ObjectWrap
+{
+public:
+
+   int            dbx_count;
+   int            batch_size;
+   unsigned int   buffer_size;
+   DBXMETH        *pmeth;
+   DBX_DBNAME     *c;
+
+   static v8::Persistent<v8::Function>       constructor;
+
+#if DBX_NODE_VERSION >= 100000
+   static void       Init                    (v8::Local<v8::Object> exports);
+#else
+   static void       Init                    (v8::Handle<v8::Object> exports);
+#endif
+   explicit          mbulk                   (int value = 0);
+                     ~mbulk                  ();
+
+   static mbulk *    NewInstance             (const v8::FunctionCallbackInfo<v8::Value>& args);
+   static int        options                 (mbulk *bx, const v8::FunctionCallbackInfo<v8::Value>& args, int argn);
+   static int        flush_batch             (mbulk *bx, int *count);
+   static int        async_callback          (mbulk *bx);
+
+   static void       Set         (const v8::FunctionCallbackInfo<v8::Value>& args);
+   static void       Flush       (const v8::FunctionCallbackInfo<v8::Value>& args);
+   static void       Close       (const v8::FunctionCallbackInfo<v8::Value>& args);
+
+private:
+
+   static void       New         (const v8::FunctionCallbackInfo<v8::Value>& args);
+};
+
+
+#endif
+
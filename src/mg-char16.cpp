@@ -0,0 +1,92 @@
+/*
+   ----------------------------------------------------------------------------
+   | mg-dbx.node                                                              |
+   | Author: Chris Munt cmunt@mgateway.com                                    |
+   |                    chris.e.munt@gmail.com                                |
+   | Copyright (c) 2019-2026 MGateway Ltd                                     |
+   | Surrey UK.                                                               |
+   | All rights reserved.                                                     |
+   |                                                                          |
+   | http://www.mgateway.com                                                  |
+   |                                                                          |
+   | Licensed under the Apache License, Version 2.0 (the "License"); you may  |
+   | not use this file except in compliance with the License.                 |
+   | You may obtain a copy of the License at                                  |
+   |                                                                          |
+   | http://www.apache.org/licenses/LICENSE-2.0                               |
+   |                                                                          |
+   | Unless required by applicable law or agreed to in writing, software      |
+   | distributed under the License is distributed on an "AS IS" BASIS,        |
+   | WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. |
+   | See the License for the specific language governing permissions and      |
+   | limitations under the License.                                           |
+   |                                                                          |
+   ----------------------------------------------------------------------------
+*/
+
+#include "mg-char16.h"
+
+
+/* v2.5.35 Widen 8-bit characters to 16-bit characters: sixteen at a time where SSE2 is available */
+int dbx_char8_to_char16(unsigned short * to, unsigned char * from, unsigned int len)
+{
+   unsigned int n;
+
+   n = 0;
+#if defined(DBX_SSE2)
+   __m128i zero, v;
+
+   zero = _mm_setzero_si128();
+   for (; (n + 16) <= len; n += 16) {
+      v = _mm_loadu_si128((const __m128i *) (from + n));
+      _mm_storeu_si128((__m128i *) (to + n), _mm_unpacklo_epi8(v, zero));
+      _mm_storeu_si128((__m128i *) (to + n + 8), _mm_unpackhi_epi8(v, zero));
+   }
+#endif
+   dbx_char8_to_char16_scalar(to + n, from + n, len - n);
+   return (int) len;
+}
+
+
+/* v2.5.35 Narrow 16-bit characters to 8-bit characters (the low byte of each, as for a cast): sixteen at a time where SSE2 is available */
+int dbx_char16_to_char8(unsigned char * to, unsigned short * from, unsigned int len)
+{
+   unsigned int n;
+
+   n = 0;
+#if defined(DBX_SSE2)
+   __m128i mask, v1, v2;
+
+   mask = _mm_set1_epi16(0x00ff);
+   for (; (n + 16) <= len; n += 16) {
+      v1 = _mm_and_si128(_mm_loadu_si128((const __m128i *) (from + n)), mask);
+      v2 = _mm_and_si128(_mm_loadu_si128((const __m128i *) (from + n + 8)), mask);
+      _mm_storeu_si128((__m128i *) (to + n), _mm_packus_epi16(v1, v2));
+   }
+#endif
+   dbx_char16_to_char8_scalar(to + n, from + n, len - n);
+   return (int) len;
+}
+
+
+/* v2.5.35 The scalar code: used for the remainder of a buffer (and for the whole of it without SSE2) */
+int dbx_char8_to_char16_scalar(unsigned short * to, unsigned char * from, unsigned int len)
+{
+   unsigned int n;
+
+   for (n = 0; n < len; n ++) {
+      to[n] = (unsigned short) from[n];
+   }
+   return (int) len;
+}
+
+
+int dbx_char16_to_char8_scalar(unsigned char * to, unsigned short * from, unsigned int len)
+{
+   unsigned int n;
+
+   for (n = 0; n < len; n ++) {
+      to[n] = (unsigned char) from[n];
+   }
+   return (int) len;
+}
@@ -0,0 +1,44 @@
+/*
+   ----------------------------------------------------------------------------
+   | mg-dbx.node                                                              |
+   | Author: Chris Munt cmunt@mgateway.com                                    |
+   |                    chris.e.munt@gmail.com                                |
+   | Copyright (c) 2019-2026 MGateway Ltd                                     |
+   | Surrey UK.                                                               |
+   | All rights reserved.                                                     |
+   |                                                                          |
+   | http://www.mgateway.com                                                  |
+   |                                                                          |
+   | Licensed under the Apache License, Version 2.0 (the "License"); you may  |
+   | not use this file except in compliance with the License.                 |
+   | You may obtain a copy of the License at                                  |
+   |                                                                          |
+   | http://www.apache.org/licenses/LICENSE-2.0                               |
+   |                                                                          |
+   | Unless required by applicable law or agreed to in writing, software      |
+   | distributed under the License is distributed on an "AS IS" BASIS,        |
+   | WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. |
+   | See the License for the specific language governing permissions and      |
+   | limitations under the License.                                           |
+   |                                                                          |
+   ----------------------------------------------------------------------------
+*/
+
+
+#ifndef MG_CHAR16_H
+#define MG_CHAR16_H
+
+/* v2.5.35 Conversion between 8-bit and 16-bit characters (UTF-16 mode) */
+
+/* SSE2 is part of the x86-64 baseline: elsewhere 8-bit/16-bit conversions use the scalar code */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DBX_SSE2                 1
+#endif
+
+int                        dbx_char8_to_char16           (unsigned short * to, unsigned char * from, unsigned int len);
+int                        dbx_char16_to_char8           (unsigned char * to, unsigned short * from, unsigned int len);
+int                        dbx_char8_to_char16_scalar    (unsigned short * to, unsigned char * from, unsigned int len);
+int                        dbx_char16_to_char8_scalar    (unsigned char * to, unsigned short * from, unsigned int len);
+
+#endif
@@ -268,6 +268,7 @@ void mclass::ClassMethodEx(const FunctionCallbackInfo<Value>& args, int binary)
    pmeth = dbx_request_memory(pcon, 1, 0);
 
    pmeth->binary = binary;
+   pmeth->typed = pcon->typed; /* v2.5.35 */
    cref.class_name = clx->class_name;
    cref.class_name_len = clx->class_name_len;
    cref.class_name16 = clx->class_name16;
@@ -336,11 +337,14 @@ void mclass::ClassMethodEx(const FunctionCallbackInfo<Value>& args, int binary)
 
    if (pmeth->output_val.type != DBX_DTYPE_OREF) {
       if (binary) {
-         Local<Object> bx = node::Buffer::New(isolate, (char *) pmeth->output_val.svalue.buf_addr, (size_t) pmeth->output_val.svalue.len_used).ToLocalChecked();
+         Local<Object> bx = dbx_new_buffer(isolate, pmeth);
          args.GetReturnValue().Set(bx);
       }
+      else if (pmeth->typed && DBX_DTYPE_NUMERIC(pmeth->output_val.type)) { /* v2.5.35 */
+         args.GetReturnValue().Set(dbx_new_number(isolate, pmeth));
+      }
       else {
-         str = pcon->utf16 ? dbx_new_string16n(isolate, pmeth->output_val.cvalue.buf16_addr, pmeth->output_val.cvalue.len_used) : dbx_new_string8n(isolate, pmeth->output_val.svalue.buf_addr, pmeth->output_val.svalue.len_used, pcon->utf8);
+         str = pcon->utf16 ? dbx_new_string16n(isolate, pmeth->output_val.cvalue.buf16_addr, pmeth->output_val.cvalue.len_used) : dbx_new_string8v(isolate, pmeth, pcon->utf8);
          args.GetReturnValue().Set(str);
       }
       dbx_request_memory_free(pcon, pmeth, 0);
@@ -396,6 +400,7 @@ void mclass::MethodEx(const FunctionCallbackInfo<Value>& args, int binary)
    pmeth = dbx_request_memory(pcon, 1, 0);
 
    pmeth->binary = binary;
+   pmeth->typed = pcon->typed; /* v2.5.35 */
    cref.class_name = clx->class_name;
    cref.class_name_len = clx->class_name_len;
    cref.class_name16 = clx->class_name16;
@@ -464,11 +469,14 @@ void mclass::MethodEx(const FunctionCallbackInfo<Value>& args, int binary)
 
    if (pmeth->output_val.type != DBX_DTYPE_OREF) {
       if (binary) {
-         Local<Object> bx = node::Buffer::New(isolate, (char *) pmeth->output_val.svalue.buf_addr, (size_t) pmeth->output_val.svalue.len_used).ToLocalChecked();
+         Local<Object> bx = dbx_new_buffer(isolate, pmeth);
          args.GetReturnValue().Set(bx);
       }
+      else if (pmeth->typed && DBX_DTYPE_NUMERIC(pmeth->output_val.type)) { /* v2.5.35 */
+         args.GetReturnValue().Set(dbx_new_number(isolate, pmeth));
+      }
       else {
-         str = pcon->utf16 ? dbx_new_string16n(isolate, pmeth->output_val.cvalue.buf16_addr, pmeth->output_val.cvalue.len_used) : dbx_new_string8n(isolate, pmeth->output_val.svalue.buf_addr, pmeth->output_val.svalue.len_used, pcon->utf8);
+         str = pcon->utf16 ? dbx_new_string16n(isolate, pmeth->output_val.cvalue.buf16_addr, pmeth->output_val.cvalue.len_used) : dbx_new_string8v(isolate, pmeth, pcon->utf8);
          args.GetReturnValue().Set(str);
       }
       dbx_request_memory_free(pcon, pmeth, 0);
@@ -577,7 +585,7 @@ void mclass::SetProperty(const FunctionCallbackInfo<Value>& args)
       dbx_log_response(pcon, (char *) pmeth->output_val.svalue.buf_addr, (int) pmeth->output_val.svalue.len_used, (char *) "mclass::setproperty");
    }
 
-   str = dbx_new_string8n(isolate, pmeth->output_val.svalue.buf_addr, pmeth->output_val.svalue.len_used, pcon->utf8);
+   str = dbx_new_string8v(isolate, pmeth, pcon->utf8);
    args.GetReturnValue().Set(str);
    dbx_request_memory_free(pcon, pmeth, 0);
    return;
@@ -617,6 +625,7 @@ void mclass::GetPropertyEx(const FunctionCallbackInfo<Value>& args, int binary)
    pmeth = dbx_request_memory(pcon, 1, 0);
 
    pmeth->binary = binary;
+   pmeth->typed = pcon->typed; /* v2.5.35 */
    cref.class_name = clx->class_name;
    cref.class_name_len = clx->class_name_len;
    cref.class_name16 = clx->class_name16;
@@ -685,11 +694,14 @@ void mclass::GetPropertyEx(const FunctionCallbackInfo<Value>& args, int binary)
 
    if (pmeth->output_val.type != DBX_DTYPE_OREF) {
       if (binary) {
-         Local<Object> bx = node::Buffer::New(isolate, (char *) pmeth->output_val.svalue.buf_addr, (size_t) pmeth->output_val.svalue.len_used).ToLocalChecked();
+         Local<Object> bx = dbx_new_buffer(isolate, pmeth);
          args.GetReturnValue().Set(bx);
       }
+      else if (pmeth->typed && DBX_DTYPE_NUMERIC(pmeth->output_val.type)) { /* v2.5.35 */
+         args.GetReturnValue().Set(dbx_new_number(isolate, pmeth));
+      }
       else {
-         str = pcon->utf16 ? dbx_new_string16n(isolate, pmeth->output_val.cvalue.buf16_addr, pmeth->output_val.cvalue.len_used) : dbx_new_string8n(isolate, pmeth->output_val.svalue.buf_addr, pmeth->output_val.svalue.len_used, pcon->utf8);
+         str = pcon->utf16 ? dbx_new_string16n(isolate, pmeth->output_val.cvalue.buf16_addr, pmeth->output_val.cvalue.len_used) : dbx_new_string8v(isolate, pmeth, pcon->utf8);
          args.GetReturnValue().Set(str);
       }
       dbx_request_memory_free(pcon, pmeth, 0);
@@ -785,7 +797,7 @@ void mclass::Reset(const FunctionCallbackInfo<Value>& args)
    DBX_DB_UNLOCK();
 
    if (pmeth->output_val.type != DBX_DTYPE_OREF) {
-      str = dbx_new_string8n(isolate, pmeth->output_val.svalue.buf_addr, pmeth->output_val.svalue.len_used, pcon->utf8);
+      str = dbx_new_string8v(isolate, pmeth, pcon->utf8);
       args.GetReturnValue().Set(str);
       dbx_request_memory_free(pcon, pmeth, 0);
       return;
@@ -76,6 +76,8 @@ void mcursor::Init(Handle<Object> exports)
    DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "cleanup", Cleanup);
    DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "next", Next);
    DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "previous", Previous);
+   DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "nextbatch", NextBatch); /* v2.5.35 */
+   DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "previousbatch", PreviousBatch);
    DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "reset", Reset);
    DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "_close", Close);
 
@@ -351,7 +353,7 @@ void mcursor::Cleanup(const FunctionCallbackInfo<Value>& args)
 
    DBX_DBFUN_END(c);
 
-   result = dbx_new_string8n(isolate, pmeth->output_val.svalue.buf_addr, pmeth->output_val.svalue.len_used, pcon->utf8);
+   result = dbx_new_string8v(isolate, pmeth, pcon->utf8);
    args.GetReturnValue().Set(result);
    dbx_request_memory_free(pcon, pmeth, 0);
    return;
@@ -361,7 +363,7 @@ void mcursor::Cleanup(const FunctionCallbackInfo<Value>& args)
 void mcursor::Next(const FunctionCallbackInfo<Value>& args)
 {
    short async;
-   int n, eod;
+   int rc, n, eod, served;
    DBXCON *pcon;
    DBXMETH *pmeth;
    Local<Object> obj;
@@ -392,6 +394,8 @@ void mcursor::Next(const FunctionCallbackInfo<Value>& args)
       return;
    }
 
+   cx->batch_eod = 0; /* v2.5.35 */
+
    if (cx->context == 1) {
    
       if (cx->pqr_prev->keyn < 1) {
@@ -400,13 +404,64 @@ void mcursor::Next(const FunctionCallbackInfo<Value>& args)
          return;
       }
 
-      DBX_DBFUN_START(c, pcon, pmeth);
-      DBX_DB_LOCK(0);
+      /* v2.5.35 read-ahead: fetch up to 'prefetch' keys under one lock and serve them from the cursor's buffer */
+      served = 0;
+      if (cx->prefetch > 0 && !pcon->utf16) {
+         if (cx->prefetch_pos >= cx->prefetch_buf.len_used && !cx->prefetch_eod) {
+            dbx_prefetch_reset(cx);
+
+            DBX_DBFUN_START(c, pcon, pmeth);
+            DBX_DB_LOCK(0);
+
+            rc = CACHE_SUCCESS;
+            for (n = 0; n < cx->prefetch; n ++) {
+               rc = dbx_global_order(pmeth, cx->pqr_prev, 1, cx->getdata);
+               if (cx->pqr_prev->ykeys[cx->pqr_prev->keyn - 1].len_used == 0) {
+                  cx->prefetch_eod = (n > 0);
+                  break;
+               }
+               if (rc != CACHE_SUCCESS) {
+                  break; /* the keys read so far are served: the step that failed is taken again after them */
+               }
+               if (dbx_prefetch_add(cx, cx->pqr_prev, 1) != CACHE_SUCCESS) {
+                  strcpy(pcon->error, "No memory available for the read-ahead buffer");
+                  rc = CACHE_FAILURE;
+                  break;
+               }
+            }
 
-      eod = dbx_global_order(pmeth, cx->pqr_prev, 1, cx->getdata);
+            DBX_DBFUN_END(c);
+            DBX_DB_UNLOCK();
 
-      DBX_DBFUN_END(c);
-      DBX_DB_UNLOCK();
+            if (rc != CACHE_SUCCESS && cx->prefetch_buf.len_used == 0) {
+               char error[DBX_ERROR_SIZE];
+
+               T_STRCPY(error, _dbxso(error), pcon->error);
+               isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, error, 1)));
+               dbx_request_memory_free(pcon, pmeth, 0);
+               return;
+            }
+            served = 1; /* the end was reached by the first step, as for a single step */
+         }
+         if (dbx_prefetch_get(cx, cx->pqr_prev, 1) == CACHE_SUCCESS) {
+            served = 1;
+         }
+         else if (cx->prefetch_eod) {
+            /* buffer used up at the end of the data: step on from the last key served */
+            dbx_prefetch_reset(cx);
+            served = 0;
+         }
+      }
+
+      if (!served) {
+         DBX_DBFUN_START(c, pcon, pmeth);
+         DBX_DB_LOCK(0);
+
+         eod = dbx_global_order(pmeth, cx->pqr_prev, 1, cx->getdata);
+
+         DBX_DBFUN_END(c);
+         DBX_DB_UNLOCK();
+      }
 
       if (pcon->utf16 && cx->pqr_prev->keys[cx->pqr_prev->keyn - 1].cvalue.len_used == 0) {
          args.GetReturnValue().Set(DBX_NULL());
@@ -414,6 +469,13 @@ void mcursor::Next(const FunctionCallbackInfo<Value>& args)
       else if (!pcon->utf16 && cx->pqr_prev->ykeys[cx->pqr_prev->keyn - 1].len_used == 0) {
          args.GetReturnValue().Set(DBX_NULL());
       }
+      else if (cx->format > 1) { /* v2.5.35 JSON or binary */
+         cx->data.len_used = 0;
+         if (dbx_cursor_output_row(cx, cx->pqr_prev, 1, 0) != CACHE_SUCCESS) {
+            isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "No memory available for the cursor output", 1)));
+         }
+         args.GetReturnValue().Set(dbx_cursor_output(isolate, pcon, cx));
+      }
       else if (cx->getdata == 0) {
 /*
          if (cx->pqr_prev->ykeys[cx->pqr_prev->keyn - 1].len_used && cx->pqr_prev->ykeys[cx->pqr_prev->keyn - 1].len_used < 10) {
@@ -451,14 +513,52 @@ void mcursor::Next(const FunctionCallbackInfo<Value>& args)
       }
    }
    else if (cx->context == 2) {
-   
-      DBX_DBFUN_START(c, pcon, pmeth);
-      DBX_DB_LOCK(0);
 
-      eod = dbx_global_query(pmeth, cx->pqr_next, cx->pqr_prev, 1, cx->getdata);
+      /* v2.5.35 read-ahead */
+      eod = CACHE_FAILURE;
+      served = 0;
+      if (cx->prefetch > 0 && !pcon->utf16) {
+         if (cx->prefetch_pos >= cx->prefetch_buf.len_used && !cx->prefetch_eod) {
+            dbx_prefetch_reset(cx);
+
+            DBX_DBFUN_START(c, pcon, pmeth);
+            DBX_DB_LOCK(0);
+
+            for (n = 0; n < cx->prefetch; n ++) {
+               eod = dbx_global_query(pmeth, cx->pqr_next, cx->pqr_prev, 1, cx->getdata);
+               if (eod != CACHE_SUCCESS) {
+                  cx->prefetch_eod = (n > 0);
+                  break;
+               }
+               dbx_prefetch_add(cx, cx->pqr_next, 2);
+               pqr = cx->pqr_next;
+               cx->pqr_next = cx->pqr_prev;
+               cx->pqr_prev = pqr;
+            }
 
-      DBX_DBFUN_END(c);
-      DBX_DB_UNLOCK();
+            DBX_DBFUN_END(c);
+            DBX_DB_UNLOCK();
+            served = 1;
+         }
+         if (dbx_prefetch_get(cx, cx->pqr_next, 2) == CACHE_SUCCESS) {
+            eod = CACHE_SUCCESS;
+            served = 1;
+         }
+         else if (cx->prefetch_eod) {
+            dbx_prefetch_reset(cx);
+            served = 0;
+         }
+      }
+
+      if (!served) {
+         DBX_DBFUN_START(c, pcon, pmeth);
+         DBX_DB_LOCK(0);
+
+         eod = dbx_global_query(pmeth, cx->pqr_next, cx->pqr_prev, 1, cx->getdata);
+
+         DBX_DBFUN_END(c);
+         DBX_DB_UNLOCK();
+      }
 
       if (cx->format == 1) {
          char buffer[32], delim[4];
@@ -480,6 +580,12 @@ void mcursor::Next(const FunctionCallbackInfo<Value>& args)
          key = dbx_new_string8n(isolate, (char *) cx->data.buf_addr, cx->data.len_used, 0);
          args.GetReturnValue().Set(key);
       }
+      else if (cx->format > 1) { /* v2.5.35 JSON or binary */
+         cx->data.len_used = 0;
+         if (dbx_cursor_output_row(cx, cx->pqr_next, 2, 0) != CACHE_SUCCESS) {
+            isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "No memory available for the cursor output", 1)));
+         }
+      }
       else {
          obj = DBX_OBJECT_NEW();
          key = dbx_new_string8(isolate, (char *) "key", 0);
@@ -502,6 +608,8 @@ void mcursor::Next(const FunctionCallbackInfo<Value>& args)
       if (eod == CACHE_SUCCESS) {
          if (cx->format == 1)
             args.GetReturnValue().Set(key);
+         else if (cx->format > 1)
+            args.GetReturnValue().Set(dbx_cursor_output(isolate, pcon, cx));
          else
             args.GetReturnValue().Set(obj);
       }
@@ -525,6 +633,13 @@ void mcursor::Next(const FunctionCallbackInfo<Value>& args)
       if (eod) {
          args.GetReturnValue().Set(DBX_NULL());
       }
+      else if (cx->format > 1) { /* v2.5.35 JSON or binary */
+         cx->data.len_used = 0;
+         if (dbx_cursor_output_row(cx, cx->pqr_prev, 9, 0) != CACHE_SUCCESS) {
+            isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "No memory available for the cursor output", 1)));
+         }
+         args.GetReturnValue().Set(dbx_cursor_output(isolate, pcon, cx));
+      }
       else {
          key = pcon->utf16 ? dbx_new_string16n(isolate, cx->pqr_prev->global_name16.cvalue.buf16_addr, cx->pqr_prev->global_name16.cvalue.len_used) : dbx_new_string8n(isolate, cx->pqr_prev->global_name.buf_addr, cx->pqr_prev->global_name.len_used, pcon->utf8);
          args.GetReturnValue().Set(key);
@@ -614,6 +729,10 @@ void mcursor::Previous(const FunctionCallbackInfo<Value>& args)
       return;
    }
 
+   /* v2.5.35 keys read ahead are discarded: the cursor's position is the last key served */
+   dbx_prefetch_reset(cx);
+   cx->batch_eod = 0;
+
    if (cx->context == 1) {
    
       if (cx->pqr_prev->keyn < 1) {
@@ -636,6 +755,13 @@ void mcursor::Previous(const FunctionCallbackInfo<Value>& args)
       else if (!pcon->utf16 && cx->pqr_prev->ykeys[cx->pqr_prev->keyn - 1].len_used == 0) {
          args.GetReturnValue().Set(DBX_NULL());
       }
+      else if (cx->format > 1) { /* v2.5.35 JSON or binary */
+         cx->data.len_used = 0;
+         if (dbx_cursor_output_row(cx, cx->pqr_prev, 1, 0) != CACHE_SUCCESS) {
+            isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "No memory available for the cursor output", 1)));
+         }
+         args.GetReturnValue().Set(dbx_cursor_output(isolate, pcon, cx));
+      }
       else if (cx->getdata == 0) {
          key = pcon->utf16 ? dbx_new_string16n(isolate, cx->pqr_prev->keys[cx->pqr_prev->keyn - 1].cvalue.buf16_addr, cx->pqr_prev->keys[cx->pqr_prev->keyn - 1].cvalue.len_used) : dbx_new_string8n(isolate, cx->pqr_prev->ykeys[cx->pqr_prev->keyn - 1].buf_addr, cx->pqr_prev->ykeys[cx->pqr_prev->keyn - 1].len_used, pcon->utf8);
          args.GetReturnValue().Set(key);
@@ -691,6 +817,12 @@ void mcursor::Previous(const FunctionCallbackInfo<Value>& args)
          key = dbx_new_string8n(isolate, (char *) cx->data.buf_addr, cx->data.len_used, 0);
          args.GetReturnValue().Set(key);
       }
+      else if (cx->format > 1) { /* v2.5.35 JSON or binary */
+         cx->data.len_used = 0;
+         if (dbx_cursor_output_row(cx, cx->pqr_next, 2, 0) != CACHE_SUCCESS) {
+            isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "No memory available for the cursor output", 1)));
+         }
+      }
       else {
          obj = DBX_OBJECT_NEW();
 /*
@@ -716,6 +848,8 @@ void mcursor::Previous(const FunctionCallbackInfo<Value>& args)
       if (eod == CACHE_SUCCESS) {
          if (cx->format == 1)
             args.GetReturnValue().Set(key);
+         else if (cx->format > 1)
+            args.GetReturnValue().Set(dbx_cursor_output(isolate, pcon, cx));
          else
             args.GetReturnValue().Set(obj);
       }
@@ -739,6 +873,13 @@ void mcursor::Previous(const FunctionCallbackInfo<Value>& args)
       if (eod) {
          args.GetReturnValue().Set(DBX_NULL());
       }
+      else if (cx->format > 1) { /* v2.5.35 JSON or binary */
+         cx->data.len_used = 0;
+         if (dbx_cursor_output_row(cx, cx->pqr_prev, 9, 0) != CACHE_SUCCESS) {
+            isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "No memory available for the cursor output", 1)));
+         }
+         args.GetReturnValue().Set(dbx_cursor_output(isolate, pcon, cx));
+      }
       else {
          key = pcon->utf16 ? dbx_new_string16n(isolate, cx->pqr_prev->global_name16.cvalue.buf16_addr, cx->pqr_prev->global_name16.cvalue.len_used) : dbx_new_string8n(isolate, cx->pqr_prev->global_name.buf_addr, cx->pqr_prev->global_name.len_used, pcon->utf8);
          args.GetReturnValue().Set(key);
@@ -792,6 +933,273 @@ void mcursor::Previous(const FunctionCallbackInfo<Value>& args)
 }
 
 
+/* v2.5.35 */
+void mcursor::NextBatch(const FunctionCallbackInfo<Value>& args)
+{
+   return BatchEx(args, 1);
+}
+
+
+/* v2.5.35 */
+void mcursor::PreviousBatch(const FunctionCallbackInfo<Value>& args)
+{
+   return BatchEx(args, -1);
+}
+
+
+/* v2.5.35 Return up to 'n' results in one call: an array of the values next()/previous() would return, or parallel keys[]/data[] arrays */
+/* With format "json" the array is returned as one JSON string, and with format "binary" as one Buffer of records */
+void mcursor::BatchEx(const FunctionCallbackInfo<Value>& args, short dir)
+{
+   short async, columns, packed;
+   int rc, n, nr, max, eod, len, dsort, dtype;
+   DBXCON *pcon;
+   DBXMETH *pmeth;
+   DBXQR *pqr;
+   Local<Object> obj;
+   Local<String> key;
+   Local<Value> item;
+   Local<Array> result;
+   Local<Array> keys;
+   Local<Array> data;
+   mcursor *cx = ObjectWrap::Unwrap<mcursor>(args.This());
+   MG_CURSOR_CHECK_CLASS(cx);
+   DBX_DBNAME *c = cx->c;
+   DBX_GET_ICONTEXT;
+   cx->dbx_count ++;
+
+   pcon = c->pcon;
+   if (pcon->log_functions) {
+      c->LogFunction(c, args, (void *) cx, (dir == 1) ? (char *) "mcursor::nextbatch" : (char *) "mcursor::previousbatch");
+   }
+   pmeth = dbx_request_memory(pcon, 1, 0);
+
+   DBX_CALLBACK_FUN(pmeth->argc, async);
+
+   if (async) {
+      isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "Cursor based operations cannot be invoked asynchronously", 1)));
+      dbx_request_memory_free(pcon, pmeth, 0);
+      return;
+   }
+   if (pmeth->argc < 1 || !args[0]->IsNumber() || (max = (int) DBX_INT32_VALUE(args[0])) < 1) {
+      isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "The number of results to return must be specified", 1)));
+      dbx_request_memory_free(pcon, pmeth, 0);
+      return;
+   }
+
+   columns = 0;
+   if (pmeth->argc > 1 && args[1]->IsObject() && cx->context != 11) {
+      obj = DBX_TO_OBJECT(args[1]);
+      key = dbx_new_string8(isolate, (char *) "columns", 1);
+      if (DBX_GET(obj, key)->IsBoolean() && DBX_TO_BOOLEAN(DBX_GET(obj, key))->IsTrue()) {
+         columns = 1;
+      }
+   }
+
+   /* records read ahead by 'prefetch' are discarded: the cursor is positioned at the last record returned */
+   dbx_prefetch_reset(cx);
+
+   /* the previous batch in this direction ended with the last record: return an empty batch to mark the end, as next() returns null */
+   if (cx->batch_eod == dir) {
+      max = 0;
+   }
+
+   result = DBX_ARRAY_NEW(0);
+   keys = DBX_ARRAY_NEW(0);
+   data = DBX_ARRAY_NEW(0);
+   nr = 0;
+
+   packed = (cx->format > 1 && !columns && cx->context != 11);
+   if (packed) {
+      cx->data.len_used = 0;
+      if (cx->format == 2) {
+         if (dbx_output_reserve(&(cx->data), 2) != CACHE_SUCCESS) {
+            isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "No memory available for the cursor output", 1)));
+            dbx_request_memory_free(pcon, pmeth, 0);
+            return;
+         }
+         cx->data.buf_addr[cx->data.len_used ++] = '[';
+      }
+   }
+   rc = CACHE_SUCCESS;
+
+   if (cx->context == 1 || cx->context == 2 || cx->context == 9) {
+
+      if (cx->context == 1 && cx->pqr_prev->keyn < 1) {
+         max = 0;
+      }
+
+      DBX_DBFUN_START(c, pcon, pmeth);
+      DBX_DB_LOCK(0);
+
+      for (nr = 0; nr < max; nr ++) {
+         if (cx->context == 1) {
+            eod = dbx_global_order(pmeth, cx->pqr_prev, dir, cx->getdata);
+            pqr = cx->pqr_prev;
+            if ((pcon->utf16 && pqr->keys[pqr->keyn - 1].cvalue.len_used == 0) || (!pcon->utf16 && pqr->ykeys[pqr->keyn - 1].len_used == 0)) {
+               break;
+            }
+            if (packed) {
+               rc = dbx_cursor_output_row(cx, pqr, 1, nr);
+               if (rc != CACHE_SUCCESS) {
+                  break;
+               }
+               continue;
+            }
+            key = pcon->utf16 ? dbx_new_string16n(isolate, pqr->keys[pqr->keyn - 1].cvalue.buf16_addr, pqr->keys[pqr->keyn - 1].cvalue.len_used) : dbx_new_string8n(isolate, pqr->ykeys[pqr->keyn - 1].buf_addr, pqr->ykeys[pqr->keyn - 1].len_used, pcon->utf8);
+            if (columns || !cx->getdata) {
+               item = key;
+            }
+            else if (cx->format == 1) {
+               cx->data.len_used = 0;
+               dbx_escape_output(&(cx->data), (char *) "key=", 4, 0);
+               pcon->utf16 ? dbx_escape_output16(&(cx->data), pqr->keys[pqr->keyn - 1].cvalue.buf16_addr, pqr->keys[pqr->keyn - 1].cvalue.len_used, 1) : dbx_escape_output(&(cx->data), pqr->ykeys[pqr->keyn - 1].buf_addr, pqr->ykeys[pqr->keyn - 1].len_used, 1);
+               dbx_escape_output(&(cx->data), (char *) "&data=", 6, 0);
+               pcon->utf16 ? dbx_escape_output16(&(cx->data), pqr->data.cvalue.buf16_addr, pqr->data.cvalue.len_used, 1) : dbx_escape_output(&(cx->data), pqr->data.svalue.buf_addr, pqr->data.svalue.len_used, 1);
+               item = dbx_new_string8n(isolate, (char *) cx->data.buf_addr, cx->data.len_used, 0);
+            }
+            else {
+               obj = DBX_OBJECT_NEW();
+               DBX_SET(obj, dbx_new_string8(isolate, (char *) "key", 0), key);
+               DBX_SET(obj, dbx_new_string8(isolate, (char *) "data", 0), pcon->utf16 ? dbx_new_string16n(isolate, pqr->data.cvalue.buf16_addr, pqr->data.cvalue.len_used) : dbx_new_string8n(isolate, pqr->data.svalue.buf_addr, pqr->data.svalue.len_used, 0));
+               item = obj;
+            }
+         }
+         else if (cx->context == 2) {
+            eod = dbx_global_query(pmeth, cx->pqr_next, cx->pqr_prev, dir, cx->getdata);
+            pqr = cx->pqr_next;
+            cx->pqr_next = cx->pqr_prev;
+            cx->pqr_prev = pqr;
+            if (eod != CACHE_SUCCESS) {
+               break;
+            }
+            if (packed) {
+               rc = dbx_cursor_output_row(cx, pqr, 2, nr);
+               if (rc != CACHE_SUCCESS) {
+                  break;
+               }
+               continue;
+            }
+            if (cx->format == 1 && !columns) {
+               char buffer[32], delim[4];
+
+               cx->data.len_used = 0;
+               *delim = '\0';
+               for (n = 0; n < pqr->keyn; n ++) {
+                  sprintf(buffer, (char *) "%skey%d=", delim, n + 1);
+                  dbx_escape_output(&(cx->data), buffer, (int) strlen(buffer), 0);
+                  pcon->utf16 ? dbx_escape_output16(&(cx->data), pqr->keys[n].cvalue.buf16_addr, pqr->keys[n].cvalue.len_used, 1) : dbx_escape_output(&(cx->data), pqr->ykeys[n].buf_addr, pqr->ykeys[n].len_used, 1);
+                  strcpy(delim, (char *) "&");
+               }
+               if (cx->getdata) {
+                  sprintf(buffer, (char *) "%sdata=", delim);
+                  dbx_escape_output(&(cx->data), buffer, (int) strlen(buffer), 0);
+                  pcon->utf16 ? dbx_escape_output16(&(cx->data), pqr->data.cvalue.buf16_addr, pqr->data.cvalue.len_used, 1) : dbx_escape_output(&(cx->data), pqr->data.svalue.buf_addr, pqr->data.svalue.len_used, 1);
+               }
+               item = dbx_new_string8n(isolate, (char *) cx->data.buf_addr, cx->data.len_used, 0);
+            }
+            else {
+               Local<Array> a = DBX_ARRAY_NEW(pqr->keyn);
+               for (n = 0; n < pqr->keyn; n ++) {
+                  DBX_SET(a, n, pcon->utf16 ? dbx_new_string16n(isolate, pqr->keys[n].cvalue.buf16_addr, pqr->keys[n].cvalue.len_used) : dbx_new_string8n(isolate, pqr->ykeys[n].buf_addr, pqr->ykeys[n].len_used, 0));
+               }
+               if (columns) {
+                  item = a;
+               }
+               else {
+                  obj = DBX_OBJECT_NEW();
+                  DBX_SET(obj, dbx_new_string8(isolate, (char *) "key", 0), a);
+                  if (cx->getdata) {
+                     DBX_SET(obj, dbx_new_string8(isolate, (char *) "data", 0), pcon->utf16 ? dbx_new_string16n(isolate, pqr->data.cvalue.buf16_addr, pqr->data.cvalue.len_used) : dbx_new_string8n(isolate, pqr->data.svalue.buf_addr, pqr->data.svalue.len_used, 0));
+                  }
+                  item = obj;
+               }
+            }
+         }
+         else {
+            eod = dbx_global_directory(pmeth, cx->pqr_prev, dir, &(cx->counter));
+            if (eod) {
+               break;
+            }
+            pqr = cx->pqr_prev;
+            if (packed) {
+               rc = dbx_cursor_output_row(cx, pqr, 9, nr);
+               if (rc != CACHE_SUCCESS) {
+                  break;
+               }
+               continue;
+            }
+            item = pcon->utf16 ? dbx_new_string16n(isolate, pqr->global_name16.cvalue.buf16_addr, pqr->global_name16.cvalue.len_used) : dbx_new_string8n(isolate, pqr->global_name.buf_addr, pqr->global_name.len_used, pcon->utf8);
+         }
+
+         if (columns) {
+            DBX_SET(keys, nr, item);
+            if (cx->getdata && cx->context != 9) {
+               DBX_SET(data, nr, pcon->utf16 ? dbx_new_string16n(isolate, pqr->data.cvalue.buf16_addr, pqr->data.cvalue.len_used) : dbx_new_string8n(isolate, pqr->data.svalue.buf_addr, pqr->data.svalue.len_used, 0));
+            }
+         }
+         else {
+            DBX_SET(result, nr, item);
+         }
+      }
+
+      DBX_DBFUN_END(c);
+      DBX_DB_UNLOCK();
+   }
+   else if (cx->context == 11 && cx->psql) {
+
+      pmeth->psql = cx->psql;
+
+      for (nr = 0; nr < max; nr ++) {
+         eod = dbx_sql_row(pmeth, pmeth->psql->row_no, dir);
+         if (eod) {
+            break;
+         }
+         obj = DBX_OBJECT_NEW();
+         for (n = 0; n < pmeth->psql->no_cols; n ++) {
+            len = (int) dbx_get_block_size((unsigned char *) pmeth->output_val.svalue.buf_addr, pmeth->output_val.offs, &dsort, &dtype);
+            pmeth->output_val.offs += 5;
+            if (dsort == DBX_DSORT_EOD || dsort == DBX_DSORT_ERROR) {
+               break;
+            }
+            key = dbx_new_string8n(isolate, (char *) pmeth->psql->cols[n]->name.buf_addr, pmeth->psql->cols[n]->name.len_used, 0);
+            DBX_SET(obj, key, dbx_new_string8n(isolate,  pmeth->output_val.svalue.buf_addr + pmeth->output_val.offs, len, pcon->utf8));
+            pmeth->output_val.offs += len;
+         }
+         DBX_SET(result, nr, obj);
+      }
+   }
+
+   if (rc != CACHE_SUCCESS) {
+      isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "No memory available for the cursor output", 1)));
+      dbx_request_memory_free(pcon, pmeth, 0);
+      return;
+   }
+
+   cx->batch_eod = (nr > 0 && nr < max) ? dir : 0;
+
+   if (columns) {
+      obj = DBX_OBJECT_NEW();
+      DBX_SET(obj, dbx_new_string8(isolate, (char *) "keys", 0), keys);
+      if (cx->getdata && cx->context != 9) {
+         DBX_SET(obj, dbx_new_string8(isolate, (char *) "data", 0), data);
+      }
+      args.GetReturnValue().Set(obj);
+   }
+   else if (packed) {
+      if (cx->format == 2 && dbx_output_reserve(&(cx->data), 1) == CACHE_SUCCESS) {
+         cx->data.buf_addr[cx->data.len_used ++] = ']';
+      }
+      args.GetReturnValue().Set(dbx_cursor_output(isolate, pcon, cx));
+   }
+   else {
+      args.GetReturnValue().Set(result);
+   }
+   dbx_request_memory_free(pcon, pmeth, 0);
+   return;
+}
+
+
 void mcursor::Reset(const FunctionCallbackInfo<Value>& args)
 {
    int rc;
@@ -882,6 +1290,13 @@ void mcursor::Close(const FunctionCallbackInfo<Value>& args)
       cx->pqr_prev = NULL;
    }
 
+   if (cx->prefetch_buf.buf_addr) { /* v2.5.35 */
+      dbx_free((void *) cx->prefetch_buf.buf_addr, 0);
+      cx->prefetch_buf.buf_addr = NULL;
+      cx->prefetch_buf.len_alloc = 0;
+   }
+   dbx_prefetch_reset(cx);
+
    if (cx->psql) {
       for (cn = 0; cn < cx->psql->no_cols; cn ++) {
          if (cx->psql->cols[cn]) {
@@ -904,6 +1319,8 @@ int dbx_escape_output(DBXSTR *pdata, char *item, int item_len, short context)
 {
    int n;
 
+   dbx_output_reserve(pdata, (unsigned int) item_len * 3); /* v2.5.35 */
+
    if (context == 0) {
       for (n = 0; n < item_len; n ++) {
          pdata->buf_addr[pdata->len_used ++] = item[n];
@@ -934,11 +1351,12 @@ int dbx_escape_output16(DBXSTR *pdata, unsigned short *item, int item_len, short
 {
    int n;
 
+   dbx_output_reserve(pdata, (unsigned int) item_len * 3); /* v2.5.35 */
+
    /* TODO escape Unicode characters */
    if (context == 0) {
-      for (n = 0; n < item_len; n ++) {
-         pdata->buf_addr[pdata->len_used ++] = (char) item[n];
-      }
+      dbx_char16_to_char8((unsigned char *) (pdata->buf_addr + pdata->len_used), item, (unsigned int) item_len);
+      pdata->len_used += item_len;
       return pdata->len_used;
    }
 
@@ -959,3 +1377,343 @@ int dbx_escape_output16(DBXSTR *pdata, unsigned short *item, int item_len, short
    }
    return pdata->len_used;
 }
+
+
+/* v2.5.35 Append the key(s) (and data) held in 'pqr' to the cursor's read-ahead buffer */
+/* Each entry is: number of keys, then length and value of each key, then length and value of the data */
+/* For $Order based cursors (context 1) only the last key is recorded */
+int dbx_prefetch_add(mcursor *cx, DBXQR *pqr, short context)
+{
+   int n, n1, keyn, len;
+   unsigned int size;
+   char *p;
+
+   keyn = (context == 1) ? 1 : pqr->keyn;
+   n1 = (context == 1) ? (pqr->keyn - 1) : 0;
+
+   size = sizeof(int) * (keyn + 2) + (cx->getdata ? pqr->data.svalue.len_used : 0);
+   for (n = 0; n < keyn; n ++) {
+      size += pqr->ykeys[n1 + n].len_used;
+   }
+
+   if ((cx->prefetch_buf.len_used + size) > cx->prefetch_buf.len_alloc) {
+      p = (char *) dbx_malloc((cx->prefetch_buf.len_used + size) * 2, 0);
+      if (!p) {
+         return CACHE_FAILURE;
+      }
+      if (cx->prefetch_buf.buf_addr) {
+         memcpy((void *) p, (void *) cx->prefetch_buf.buf_addr, (size_t) cx->prefetch_buf.len_used);
+         dbx_free((void *) cx->prefetch_buf.buf_addr, 0);
+      }
+      cx->prefetch_buf.buf_addr = p;
+      cx->prefetch_buf.len_alloc = (cx->prefetch_buf.len_used + size) * 2;
+   }
+
+   p = cx->prefetch_buf.buf_addr + cx->prefetch_buf.len_used;
+   memcpy((void *) p, (void *) &keyn, sizeof(int));
+   p += sizeof(int);
+   for (n = 0; n < keyn; n ++) {
+      len = (int) pqr->ykeys[n1 + n].len_used;
+      memcpy((void *) p, (void *) &len, sizeof(int));
+      p += sizeof(int);
+      memcpy((void *) p, (void *) pqr->ykeys[n1 + n].buf_addr, (size_t) len);
+      p += len;
+   }
+   len = cx->getdata ? (int) pqr->data.svalue.len_used : 0;
+   memcpy((void *) p, (void *) &len, sizeof(int));
+   p += sizeof(int);
+   if (len) {
+      memcpy((void *) p, (void *) pqr->data.svalue.buf_addr, (size_t) len);
+   }
+   cx->prefetch_buf.len_used += size;
+
+   return CACHE_SUCCESS;
+}
+
+
+/* v2.5.35 Copy the next entry in the read-ahead buffer into 'pqr' */
+int dbx_prefetch_get(mcursor *cx, DBXQR *pqr, short context)
+{
+   int n, n1, keyn, len;
+   char *p;
+
+   if (cx->prefetch_pos >= cx->prefetch_buf.len_used) {
+      return CACHE_FAILURE;
+   }
+
+   p = cx->prefetch_buf.buf_addr + cx->prefetch_pos;
+   memcpy((void *) &keyn, (void *) p, sizeof(int));
+   p += sizeof(int);
+   if (context == 1) {
+      n1 = pqr->keyn - 1;
+   }
+   else {
+      n1 = 0;
+      pqr->keyn = keyn;
+   }
+   for (n = 0; n < keyn; n ++) {
+      memcpy((void *) &len, (void *) p, sizeof(int));
+      p += sizeof(int);
+      memcpy((void *) pqr->ykeys[n1 + n].buf_addr, (void *) p, (size_t) len);
+      pqr->ykeys[n1 + n].buf_addr[len] = '\0';
+      pqr->ykeys[n1 + n].len_used = len;
+      pqr->keys[n1 + n].svalue.len_used = len;
+      p += len;
+   }
+   memcpy((void *) &len, (void *) p, sizeof(int));
+   p += sizeof(int);
+   if (len && dbx_dbxqr_data_size(pqr, (unsigned int) len) != CACHE_SUCCESS) {
+      return CACHE_FAILURE;
+   }
+   if (len) {
+      memcpy((void *) pqr->data.svalue.buf_addr, (void *) p, (size_t) len);
+      p += len;
+   }
+   pqr->data.svalue.len_used = len;
+
+   cx->prefetch_pos = (unsigned int) (p - cx->prefetch_buf.buf_addr);
+
+   return CACHE_SUCCESS;
+}
+
+
+/* v2.5.35 Discard any keys read ahead */
+int dbx_prefetch_reset(mcursor *cx)
+{
+   cx->prefetch_buf.len_used = 0;
+   cx->prefetch_pos = 0;
+   cx->prefetch_eod = 0;
+
+   return 0;
+}
+
+
+/* v2.5.35 Make room for at least 'len' more bytes in an output buffer */
+int dbx_output_reserve(DBXSTR *pdata, unsigned int len)
+{
+   unsigned int size;
+   char *p;
+
+   if ((pdata->len_used + len) <= pdata->len_alloc) {
+      return CACHE_SUCCESS;
+   }
+
+   size = (pdata->len_used + len) * 2;
+   p = (char *) dbx_malloc(size, 0);
+   if (!p) {
+      return CACHE_FAILURE;
+   }
+   if (pdata->buf_addr) {
+      memcpy((void *) p, (void *) pdata->buf_addr, (size_t) pdata->len_used);
+      dbx_free((void *) pdata->buf_addr, 0);
+   }
+   pdata->buf_addr = p;
+   pdata->len_alloc = size;
+
+   return CACHE_SUCCESS;
+}
+
+
+/* v2.5.35 Append 'item' to an output buffer as a quoted JSON string */
+/* The caller must reserve (item_len * 6) + 2 bytes: eight bytes are tested at a time and copied as they are unless one of them must be escaped */
+/* Bytes of 0x80 and above are copied unchanged: UTF-8 (or Latin-1) text remains valid in the JSON string */
+int dbx_escape_json(DBXSTR *pdata, char *item, int item_len)
+{
+   int n, len;
+   unsigned char c;
+   unsigned long long w;
+   char *p;
+   static const char hex[] = "0123456789abcdef";
+
+   p = pdata->buf_addr + pdata->len_used;
+   *p ++ = '"';
+
+   n = 0;
+   while (n < item_len) {
+      len = item_len - n;
+      if (len >= 8) {
+         memcpy((void *) &w, (void *) (item + n), 8);
+         if (!DBX_SWAR_JSON_ESCAPE(w)) {
+            memcpy((void *) p, (void *) (item + n), 8);
+            p += 8;
+            n += 8;
+            continue;
+         }
+         len = 8;
+      }
+      for (; len > 0; len --, n ++) {
+         c = (unsigned char) item[n];
+         if (c >= 0x20 && c != '"' && c != '\\') {
+            *p ++ = (char) c;
+            continue;
+         }
+         *p ++ = '\\';
+         switch (c) {
+            case '"':
+            case '\\':
+               *p ++ = (char) c;
+               break;
+            case '\n':
+               *p ++ = 'n';
+               break;
+            case '\r':
+               *p ++ = 'r';
+               break;
+            case '\t':
+               *p ++ = 't';
+               break;
+            case '\b':
+               *p ++ = 'b';
+               break;
+            case '\f':
+               *p ++ = 'f';
+               break;
+            default:
+               *p ++ = 'u';
+               *p ++ = '0';
+               *p ++ = '0';
+               *p ++ = hex[c >> 4];
+               *p ++ = hex[c & 0xf];
+               break;
+         }
+      }
+   }
+   *p ++ = '"';
+
+   pdata->len_used = (unsigned int) (p - pdata->buf_addr);
+   return pdata->len_used;
+}
+
+
+/* v2.5.35 Append a 32-bit integer (little-endian) to an output buffer: the caller must reserve 4 bytes */
+int dbx_output_int32(DBXSTR *pdata, int value)
+{
+   unsigned char *p;
+
+   p = (unsigned char *) pdata->buf_addr + pdata->len_used;
+   p[0] = (unsigned char) (value & 0xff);
+   p[1] = (unsigned char) ((value >> 8) & 0xff);
+   p[2] = (unsigned char) ((value >> 16) & 0xff);
+   p[3] = (unsigned char) ((value >> 24) & 0xff);
+   pdata->len_used += 4;
+
+   return pdata->len_used;
+}
+
+
+/* v2.5.35 Append one cursor result to the cursor's output buffer in JSON (format 2) or binary (format 3) form */
+/* JSON: the value next() would return: "key", {"key":"key","data":"data"}, {"key":["key1","key2"],"data":"data"} or "global" */
+/* Binary: number of keys, then length and value of each key, then length and value of the data (32-bit little-endian integers) */
+/* The space required is reserved before anything is written; for JSON a comma precedes all but the first result ('row') of a batch */
+int dbx_cursor_output_row(mcursor *cx, DBXQR *pqr, short context, int row)
+{
+   int n, n1, keyn, getdata;
+   unsigned int size;
+   DBXSTR *pdata;
+
+   pdata = &(cx->data);
+
+   if (context == 9) {
+      n1 = 0;
+      keyn = 1;
+      getdata = 0;
+   }
+   else {
+      n1 = (context == 1) ? (pqr->keyn - 1) : 0;
+      keyn = (context == 1) ? 1 : pqr->keyn;
+      getdata = cx->getdata;
+   }
+
+   if (cx->format == 2) {
+      size = 32 + (keyn * 3) + (getdata ? ((pqr->data.svalue.len_used * 6) + 2) : 0);
+      if (context == 9) {
+         size += pqr->global_name.len_used * 6;
+      }
+      else {
+         for (n = 0; n < keyn; n ++) {
+            size += pqr->ykeys[n1 + n].len_used * 6;
+         }
+      }
+      if (dbx_output_reserve(pdata, size) != CACHE_SUCCESS) {
+         return CACHE_FAILURE;
+      }
+
+      if (row > 0) {
+         pdata->buf_addr[pdata->len_used ++] = ',';
+      }
+      if (context == 9) {
+         dbx_escape_json(pdata, pqr->global_name.buf_addr, (int) pqr->global_name.len_used);
+         return CACHE_SUCCESS;
+      }
+      if (context == 1 && !getdata) {
+         dbx_escape_json(pdata, pqr->ykeys[n1].buf_addr, (int) pqr->ykeys[n1].len_used);
+         return CACHE_SUCCESS;
+      }
+
+      memcpy((void *) (pdata->buf_addr + pdata->len_used), (void *) "{\"key\":", 7);
+      pdata->len_used += 7;
+      if (context == 2) {
+         pdata->buf_addr[pdata->len_used ++] = '[';
+      }
+      for (n = 0; n < keyn; n ++) {
+         if (n > 0) {
+            pdata->buf_addr[pdata->len_used ++] = ',';
+         }
+         dbx_escape_json(pdata, pqr->ykeys[n1 + n].buf_addr, (int) pqr->ykeys[n1 + n].len_used);
+      }
+      if (context == 2) {
+         pdata->buf_addr[pdata->len_used ++] = ']';
+      }
+      if (getdata) {
+         memcpy((void *) (pdata->buf_addr + pdata->len_used), (void *) ",\"data\":", 8);
+         pdata->len_used += 8;
+         dbx_escape_json(pdata, pqr->data.svalue.buf_addr, (int) pqr->data.svalue.len_used);
+      }
+      pdata->buf_addr[pdata->len_used ++] = '}';
+      return CACHE_SUCCESS;
+   }
+
+   size = 4 * (keyn + 2) + (getdata ? pqr->data.svalue.len_used : 0);
+   if (context == 9) {
+      size += pqr->global_name.len_used;
+   }
+   else {
+      for (n = 0; n < keyn; n ++) {
+         size += pqr->ykeys[n1 + n].len_used;
+      }
+   }
+   if (dbx_output_reserve(pdata, size) != CACHE_SUCCESS) {
+      return CACHE_FAILURE;
+   }
+
+   dbx_output_int32(pdata, keyn);
+   if (context == 9) {
+      dbx_output_int32(pdata, (int) pqr->global_name.len_used);
+      memcpy((void *) (pdata->buf_addr + pdata->len_used), (void *) pqr->global_name.buf_addr, (size_t) pqr->global_name.len_used);
+      pdata->len_used += pqr->global_name.len_used;
+   }
+   else {
+      for (n = 0; n < keyn; n ++) {
+         dbx_output_int32(pdata, (int) pqr->ykeys[n1 + n].len_used);
+         memcpy((void *) (pdata->buf_addr + pdata->len_used), (void *) pqr->ykeys[n1 + n].buf_addr, (size_t) pqr->ykeys[n1 + n].len_used);
+         pdata->len_used += pqr->ykeys[n1 + n].len_used;
+      }
+   }
+   dbx_output_int32(pdata, getdata ? (int) pqr->data.svalue.len_used : 0);
+   if (getdata) {
+      memcpy((void *) (pdata->buf_addr + pdata->len_used), (void *) pqr->data.svalue.buf_addr, (size_t) pqr->data.svalue.len_used);
+      pdata->len_used += pqr->data.svalue.len_used;
+   }
+
+   return CACHE_SUCCESS;
+}
+
+
+/* v2.5.35 Return the cursor's output buffer: a string for JSON (format 2) or a Buffer for binary (format 3) */
+v8::Local<v8::Value> dbx_cursor_output(v8::Isolate * isolate, DBXCON *pcon, mcursor *cx)
+{
+   if (cx->format == 2) {
+      return dbx_new_string8n(isolate, (char *) cx->data.buf_addr, cx->data.len_used, pcon->utf8);
+   }
+   return node::Buffer::Copy(isolate, (char *) cx->data.buf_addr, (size_t) cx->data.len_used).ToLocalChecked();
+}
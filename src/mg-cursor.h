@@ -51,6 +51,11 @@ public:
    DBXQR          *pqr_prev;
    DBXQR          *pqr_next;
    DBXSTR         data;
+   int            prefetch; /* v2.5.35 */
+   int            prefetch_eod;
+   unsigned int   prefetch_pos;
+   DBXSTR         prefetch_buf;
+   short          batch_eod;
    DBXSQL         *psql;
    DBX_DBNAME     *c;
 
@@ -71,6 +76,9 @@ public:
    static void       Cleanup                 (const v8::FunctionCallbackInfo<v8::Value>& args);
    static void       Next                    (const v8::FunctionCallbackInfo<v8::Value>& args);
    static void       Previous                (const v8::FunctionCallbackInfo<v8::Value>& args);
+   static void       NextBatch               (const v8::FunctionCallbackInfo<v8::Value>& args);
+   static void       PreviousBatch           (const v8::FunctionCallbackInfo<v8::Value>& args);
+   static void       BatchEx                 (const v8::FunctionCallbackInfo<v8::Value>& args, short dir);
    static void       Reset                   (const v8::FunctionCallbackInfo<v8::Value>& args);
    static void       Close                   (const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -82,6 +90,14 @@ private:
 
 int                  dbx_escape_output       (DBXSTR *pdata, char *item, int item_len, short context);
 int                  dbx_escape_output16     (DBXSTR *pdata, unsigned short *item, int item_len, short context);
+int                  dbx_prefetch_add        (mcursor *cx, DBXQR *pqr, short context);
+int                  dbx_prefetch_get        (mcursor *cx, DBXQR *pqr, short context);
+int                  dbx_prefetch_reset      (mcursor *cx);
+int                  dbx_output_reserve      (DBXSTR *pdata, unsigned int len);
+int                  dbx_escape_json         (DBXSTR *pdata, char *item, int item_len);
+int                  dbx_output_int32        (DBXSTR *pdata, int value);
+int                  dbx_cursor_output_row   (mcursor *cx, DBXQR *pqr, short context, int row);
+v8::Local<v8::Value> dbx_cursor_output       (v8::Isolate * isolate, DBXCON *pcon, mcursor *cx);
 
 #endif
 
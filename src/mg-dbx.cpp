@@ -200,6 +200,78 @@ Version 2.5.33 18 February 2026:
 Version 2.5.34 24 May 2026:
    Verify that mg-dbx will build and work with Node.js v26.x.x. (ABI: 147).
 
+Version 2.5.35 18 October 2026:
+   Replace the mutex protected (and per-task allocated) thread pool queue with a bounded lock-free ring of preallocated task slots.
+      Idle pool threads are parked on a futex (Linux) or condition variable (other UNIX systems).
+      Queue depth and contention counters are returned by the new dbx.poolstats() method.
+   Signal the completion of a pooled task to its own waiting thread instead of broadcasting to all waiting threads.
+      db.benchmark({test: "completion"}) measures the wakeups per completion for both schemes.
+   Introduce a 'pool_async' option for the open() method.
+      When set, asynchronous requests are passed directly to the mg-dbx thread pool and completed through an event loop async handle.
+      No Node.js (libuv) worker threads are used.
+   Allow the mg-dbx thread pool to be configured through the open() method: 'pool_size', 'pool_max', 'pool_stack_size', 'pool_idle_timeout' and 'pool_affinity'.
+      The pool grows (up to 'pool_max' threads) when tasks are queued and no thread is idle, and shrinks back when threads are idle.
+      Per-thread statistics are returned by dbx.poolstats().
+   In multithreaded mode, reuse request objects (and their buffers) from a cache instead of allocating and freeing them for every call.
+      The cache is sized by the recent peak number of concurrent requests, and oversized buffers are released rather than cached.
+      Cache counters are returned by the new dbx.memorystats() method.
+   Only reset the argument slots used by the previous request (a high-water mark) rather than all DBX_MAXARGS slots on every call.
+      db.benchmark({test: "request"}) measures the cost of setting up a request, with and without the high-water mark.
+   Introduce a db.getmany() method to retrieve a set of records in a single operation.
+      All references are processed under one lock and, for network connections, pipelined to the DB Superserver a window at a time.
+   Introduce a db.setmany() method and a bulk loader class (mbulk) that buffers sets and writes them in batches.
+   Introduce a 'pipeline' option for the open() method (network connections).
+      When set, a request's command is sent and the DB lock released while it waits for its response, so that commands from other threads can be in flight on the same connection.
+      Responses are matched to requests in the order in which the commands were sent.
+   Read network responses through a connection-level receive buffer, so that one recv() normally returns a response's header and data together.
+      On UNIX systems, poll() replaces select() for read and connect timeouts (select() cannot be used for descriptors >= FD_SETSIZE).
+   Introduce a connection pool for network connections: open() options 'connection_pool_size', 'connection_pool_max' and 'connection_health_check'.
+      Stateless requests are sent over one of a pool of sessions to the DB Superserver (opened on demand up to the maximum) with the DB lock released for the round trip.
+      Requests that depend on server process state (locks, transactions, classes and SQL) use the primary session.
+      So do functions, unless the 'connection_pool_functions' option is set.
+      Idle sessions are checked before reuse and reconnected if the server has closed them.
+   Introduce a 'net_async' option for the open() method (network connections).
+      When set, asynchronous global and function requests are written to a dedicated socket driven by the Node.js event loop (uv_tcp_t).
+      Responses are framed as data arrives and the callbacks invoked directly on the event loop: no thread is occupied for the round trip.
+      The socket is opened by a worker thread: requests are passed to the thread pool until it is ready.
+      Functions use the event loop transport only if the 'connection_pool_functions' option is set.
+   Introduce a 'buffer_zero_copy' option for the open() method.
+      Values of at least the size given are returned by the _bx methods without a copy: the output buffer is handed over to the Node.js Buffer and the request takes a fresh one from a cache.
+   Correct a fault in the _bx methods: node::Buffer::New() took ownership of an output buffer that the request went on to use and free.
+   For API based connectivity, Buffer and TypedArray arguments of at least 'buffer_zero_copy' Bytes are referenced in place rather than copied into the input buffer.
+      The request holds a reference to the ArrayBuffer's backing store until it is freed.
+   The mglobal class encodes its global name and fixed keys once (on first use after creation or reset()) and copies the encoded block into each request.
+   Correct a fault in mglobal::reset() (and close()) whereby integer and Buffer keys set by a previous reset could be freed incorrectly.
+   Introduce a 'prefetch' option for global based mcursor objects.
+      next() fetches up to the number of records given under one lock and serves subsequent calls from a buffer held by the cursor.
+   Correct a fault in mcursor::next() for network connections: without 'getdata' the next key was not returned.
+   Correct a fault in mcursor::next() (multilevel, getdata) for network connections: the data buffer was replaced by a pointer into the request's output buffer.
+   Introduce nextbatch() and previousbatch() methods for the mcursor class.
+      Up to the number of results given are retrieved under one lock and returned in a single array (or as parallel 'keys' and 'data' arrays with the 'columns' option).
+   Introduce a getdocument() method for the mglobal class.
+      The subtree below a node is walked ($Query) under one lock and returned as a nested object, or as an array of {key, data} records with format "flat".
+   Introduce a setdocument() method for the mglobal class.
+      The object is flattened into one set request for each node and the requests are processed as a batch (as for setmany()).
+   Introduce "json" and "binary" output formats for mcursor objects based on a global.
+      JSON strings are escaped eight bytes at a time.  The output buffer used for the "url" format is also extended as necessary.
+   Only internalize short strings (keys and property names) when the character set is ASCII: values are created as normal strings.
+   Introduce a 'string_external' option for the open() method.
+      Values of at least this size that can be held as one-byte characters are returned as external strings backed by the output buffer.
+      db.benchmark({test: "string", size: <bytes>}) measures the cost of creating internalized, normal and external strings.
+   Convert between 8-bit and 16-bit characters (UTF-16 mode) sixteen characters at a time with SSE2 where available.
+      The conversions are held in mg-char16.cpp (with their scalar counterparts) and tested by test/test-char16.cpp.
+      Correct a fault whereby 8-bit characters above 127 were sign-extended when added to the 16-bit input buffer.
+      Correct faults in the logging of UTF-16 requests (log_transmissions): the wrong length was logged and the buffer was not freed.
+   Introduce a 'typed' option for the open() method.
+      When set, results of numeric type (integer, 64-bit integer and double) are returned as JavaScript numbers (or BigInts) rather than strings.
+      For InterSystems API based connectivity, whole number arguments are pushed with CachePushInt64() rather than as strings.
+   Introduce prepared functions (mfunction class): db.mfunction("label^routine") parses the function reference once.
+      For YottaDB, prepared functions are invoked through ydb_cip() with a call-in handle that is resolved on the first call.
+   Introduce a db.batch() method to process a mixed group of global operations (set, get, delete, defined and increment) in a single operation.
+      For YottaDB, a batch issued within a transaction (as for db.getmany() and db.setmany()) is handed to the transaction thread in one exchange.
+   Hand YottaDB transaction requests to the transaction thread through a pair of completion words (spin then futex) instead of condition variables.
+      This also closes a window in which a response could be signalled before the caller started waiting for it, stalling the caller for the 3 second wait timeout.
+
 */
 
 
@@ -208,6 +280,8 @@ Version 2.5.34 24 May 2026:
 #include "mg-global.h"
 #include "mg-cursor.h"
 #include "mg-class.h"
+#include "mg-bulk.h"
+#include "mg-function.h"
 
 
 #if defined(_WIN32)
@@ -219,27 +293,26 @@ extern int errno;
 
 static int     dbx_counter             = 0;
 static int     dbx_sql_counter         = 0;
-int            dbx_total_tasks         = 0;
 int            dbx_request_errors      = 0;
 
+DBXMETHCACHE   dbx_meth_cache; /* v2.5.35 */
+
 #if defined(_WIN32)
 CRITICAL_SECTION  dbx_async_mutex;
+CRITICAL_SECTION  dbx_meth_mutex; /* v2.5.35 */
 #else
 pthread_mutex_t   dbx_async_mutex        = PTHREAD_MUTEX_INITIALIZER;
 pthread_mutex_t   dbx_pool_mutex         = PTHREAD_MUTEX_INITIALIZER;
-pthread_mutex_t   dbx_result_mutex       = PTHREAD_MUTEX_INITIALIZER;
-pthread_mutex_t   dbx_task_queue_mutex   = PTHREAD_MUTEX_INITIALIZER;
+pthread_mutex_t   dbx_meth_mutex         = PTHREAD_MUTEX_INITIALIZER; /* v2.5.35 */
+pthread_once_t    dbx_task_queue_once    = PTHREAD_ONCE_INIT;
 
 pthread_cond_t    dbx_pool_cond           = PTHREAD_COND_INITIALIZER;
-pthread_cond_t    dbx_result_cond         = PTHREAD_COND_INITIALIZER;
 
-DBXTID            dbx_thr_id[DBX_THREADPOOL_MAX];
-pthread_t         dbx_p_threads[DBX_THREADPOOL_MAX];
+DBXTASKQ          dbx_task_queue; /* v2.5.35 */
+DBXPOOL           dbx_pool;
+DBXBENCH *        dbx_bench_active       = NULL;
 #endif
 
-struct dbx_pool_task * tasks           = NULL;
-struct dbx_pool_task * bottom_task     = NULL;
-
 DBXCON * pcon_api = NULL;
 
 DBXISCSO *  p_isc_so_global = NULL;
@@ -281,6 +354,7 @@ BOOL WINAPI DllMain(HINSTANCE hinstDLL, DWORD fdwReason, LPVOID lpReserved)
          oldHandler = _set_invalid_parameter_handler(newHandler);
 #endif
          InitializeCriticalSection(&dbx_async_mutex);
+         InitializeCriticalSection(&dbx_meth_mutex); /* v2.5.35 */
          break;
       case DLL_THREAD_ATTACH:
          break;
@@ -288,6 +362,7 @@ BOOL WINAPI DllMain(HINSTANCE hinstDLL, DWORD fdwReason, LPVOID lpReserved)
          break;
       case DLL_PROCESS_DETACH:
          DeleteCriticalSection(&dbx_async_mutex);
+         DeleteCriticalSection(&dbx_meth_mutex);
          break;
    }
    return TRUE;
@@ -333,7 +408,10 @@ void DBX_DBNAME::Init(Handle<Object> exports)
    DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "namespace", Namespace);
    DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "get", Get);
    DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "get_bx", Get_bx);
+   DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "getmany", GetMany);
    DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "set", Set);
+   DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "setmany", SetMany);
+   DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "batch", Batch);
    DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "defined", Defined);
    DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "delete", Delete);
    DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "next", Next);
@@ -342,6 +420,8 @@ void DBX_DBNAME::Init(Handle<Object> exports)
    DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "lock", Lock);
    DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "unlock", Unlock);
    DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "mglobal", MGlobal);
+   DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "mbulk", MBulk);
+   DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "mfunction", MFunction);
    DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "mglobal_close", MGlobal_Close);
    DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "mglobalquery", MGlobalQuery);
    DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "mglobalquery_close", MGlobalQuery_Close);
@@ -360,6 +440,8 @@ void DBX_DBNAME::Init(Handle<Object> exports)
 
    DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "sleep", Sleep);
    DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "benchmark", Benchmark);
+   DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "poolstats", PoolStats);
+   DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "memorystats", MemoryStats);
 
 #if DBX_NODE_VERSION >= 120000
    constructor.Reset(isolate, tpl->GetFunction(icontext).ToLocalChecked());
@@ -378,6 +460,11 @@ DBX_DBNAME::DBX_DBNAME(int value) : dbx_count(value)
 
 DBX_DBNAME::~DBX_DBNAME()
 {
+#if !defined(_WIN32)
+   if (pcon) {
+      pthread_mutex_destroy(&(pcon->pipe_mutex)); /* v2.5.35 */
+   }
+#endif
 }
 
 
@@ -440,6 +527,21 @@ void DBX_DBNAME::New(const FunctionCallbackInfo<Value>& args)
    c->pcon->error_mode = 0;
 
    c->pcon->timeout = DBX_DEFAULT_TIMEOUT;
+   c->pcon->pool_idle_timeout = -1; /* v2.5.35 */
+   c->pcon->net_pipeline = 0;
+   c->pcon->net_pool_size = 0;
+   c->pcon->net_pool_max = 0;
+   c->pcon->net_health_check = DBX_NETPOOL_HEALTH_CHECK;
+   c->pcon->net_pool_functions = 0;
+   c->pcon->p_netpool = NULL;
+   c->pcon->net_async = 0;
+   c->pcon->buffer_zero_copy = 0; /* v2.5.35 */
+   c->pcon->string_external = 0;
+   c->pcon->typed = 0;
+   c->pcon->p_netuv = NULL;
+#if !defined(_WIN32)
+   pthread_mutex_init(&(c->pcon->pipe_mutex), NULL);
+#endif
 
    c->pcon->log_errors = 0;
    c->pcon->log_functions = 0;
@@ -467,6 +569,8 @@ DBX_DBNAME::dbx_baton_t * DBX_DBNAME::dbx_make_baton(DBX_DBNAME *c, DBXMETH *pme
    baton->gx = NULL;
    baton->cx = NULL;
    baton->clx = NULL;
+   baton->bx = NULL;
+   baton->fx = NULL;
    baton->pmeth = pmeth;
    return baton;
 }
@@ -487,6 +591,41 @@ int DBX_DBNAME::dbx_queue_task(void * work_cb, void * after_work_cb, DBX_DBNAME:
    uv_work_t *_req = new uv_work_t;
    _req->data = baton;
 
+#if !defined(_WIN32)
+   /* v2.5.35 stateless network requests are written to the event loop transport's socket: no thread is used */
+   if (work_cb == (void *) dbx_process_task && baton->pmeth->pcon->net_async && baton->pmeth->pcon->net_connection && baton->pmeth->pcon->open) {
+      DBXCON *pcon = baton->pmeth->pcon;
+      int command = netx_uv_command(baton->pmeth);
+
+      if (command && pcon->p_netuv && (((DBXNETUV *) pcon->p_netuv)->broken || ((DBXNETUV *) pcon->p_netuv)->generation != DBX_ATOMIC_LOAD(&(pcon->net_generation)))) {
+         netx_uv_close(pcon); /* reconnect (to the current namespace) */
+      }
+      if (command && !pcon->p_netuv) {
+#if DBX_NODE_VERSION >= 120000
+         if (netx_uv_init(pcon, GetCurrentEventLoop(baton->isolate)) != CACHE_SUCCESS) {
+#else
+         if (netx_uv_init(pcon, uv_default_loop()) != CACHE_SUCCESS) {
+#endif
+            pcon->net_async = 0; /* fall back to the thread pool */
+         }
+      }
+      /* until the session is open the request goes to the thread pool */
+      if (command && pcon->p_netuv && !((DBXNETUV *) pcon->p_netuv)->opening) {
+         baton->c->dbx_count += 1;
+         return netx_uv_submit(baton->pmeth, command, (void *) _req, after_work_cb);
+      }
+   }
+
+   /* v2.5.35 bypass the libuv worker pool: the dbx pool thread completes the request straight back to the event loop */
+   /* if the pool's queue is full the request goes to a libuv worker, which can afford to wait for a free slot */
+   if (work_cb == (void *) dbx_process_task && baton->pmeth->pcon->p_async && baton->pmeth->pcon->open) {
+      if (dbx_async_submit_task(baton->pmeth, (void *) _req, after_work_cb) == 0) {
+         baton->c->dbx_count += 1;
+         return 0;
+      }
+   }
+#endif
+
    /* v2.1.17 */
 #if DBX_NODE_VERSION >= 120000
    uv_queue_work(GetCurrentEventLoop(baton->isolate), _req, (uv_work_cb) work_cb, (uv_after_work_cb) after_work_cb);
@@ -504,6 +643,13 @@ async_rtn DBX_DBNAME::dbx_process_task(uv_work_t *req)
 
    dbx_launch_thread(baton->pmeth);
 
+#if !defined(_WIN32)
+   /* v2.5.35 request passed here because the pool's queue was full */
+   if (baton->pmeth->pcon->p_async && !baton->pmeth->p_async) {
+      dbx_async_overflow_done(baton->pmeth->pcon);
+   }
+#endif
+
    baton->c->dbx_count += 1;
 
    return;
@@ -535,22 +681,34 @@ async_rtn DBX_DBNAME::dbx_invoke_callback(uv_work_t *req)
       ((mcursor *) baton->cx)->async_callback((mcursor *) baton->cx);
    else if (baton->clx)
       ((mclass *) baton->clx)->async_callback((mclass *) baton->clx);
+   else if (baton->fx) /* v2.5.35 */
+      ((mfunction *) baton->fx)->async_callback((mfunction *) baton->fx);
    else
       baton->c->Unref();
 
    Local<Value> argv[2];
 
-   if (baton->pmeth->pcon->error[0])
+   /* v2.5.35 requests completed by the event loop transport carry their own error: it is passed as the error argument */
+   if (baton->pmeth->net_command) {
+      if (baton->pmeth->net_error[0])
+         argv[0] = dbx_new_string8(isolate, baton->pmeth->net_error, 0);
+      else
+         argv[0] = DBX_INTEGER_NEW(false);
+   }
+   else if (baton->pmeth->pcon->error[0])
       argv[0] = DBX_INTEGER_NEW(true);
    else
       argv[0] = DBX_INTEGER_NEW(false);
 
    if (baton->pmeth->binary) {
-      baton->result_obj = node::Buffer::New(isolate, (char *) baton->pmeth->output_val.svalue.buf_addr, (size_t) baton->pmeth->output_val.svalue.len_used).ToLocalChecked();
+      baton->result_obj = dbx_new_buffer(isolate, baton->pmeth);
       argv[1] = baton->result_obj;
    }
+   else if (baton->pmeth->typed && DBX_DTYPE_NUMERIC(baton->pmeth->output_val.type)) { /* v2.5.35 */
+      argv[1] = dbx_new_number(isolate, baton->pmeth);
+   }
    else {
-      baton->result_str = baton->pmeth->pcon->utf16 ? dbx_new_string16n(isolate, baton->pmeth->output_val.cvalue.buf16_addr, baton->pmeth->output_val.cvalue.len_used) : dbx_new_string8n(isolate, baton->pmeth->output_val.svalue.buf_addr, baton->pmeth->output_val.svalue.len_used, baton->c->pcon->utf8);
+      baton->result_str = baton->pmeth->pcon->utf16 ? dbx_new_string16n(isolate, baton->pmeth->output_val.cvalue.buf16_addr, baton->pmeth->output_val.cvalue.len_used) : dbx_new_string8v(isolate, baton->pmeth, baton->c->pcon->utf8);
       argv[1] = baton->result_str;
    }
 
@@ -674,6 +832,58 @@ async_rtn DBX_DBNAME::dbx_invoke_callback_sql_execute(uv_work_t *req)
    return;
 }
 
+/* v2.5.35 */
+async_rtn DBX_DBNAME::dbx_invoke_callback_batch(uv_work_t *req)
+{
+   Isolate* isolate = Isolate::GetCurrent();
+   HandleScope scope(isolate);
+
+   dbx_baton_t *baton = static_cast<dbx_baton_t *>(req->data);
+
+   if (baton->bx)
+      ((mbulk *) baton->bx)->async_callback((mbulk *) baton->bx);
+   else
+      baton->c->Unref();
+
+   Local<Value> argv[2];
+
+   if (baton->pmeth->pcon->error[0])
+      argv[0] = DBX_INTEGER_NEW(true);
+   else
+      argv[0] = DBX_INTEGER_NEW(false);
+
+   argv[1] = dbx_batch_result(isolate, baton->pmeth->pcon, baton->pmeth->pbatch);
+
+#if DBX_NODE_VERSION < 80000
+   TryCatch try_catch;
+#endif
+
+   Local<Function> cb = Local<Function>::New(isolate, baton->cb);
+
+#if DBX_NODE_VERSION >= 120000
+   cb->Call(isolate->GetCurrentContext(), Null(isolate), 2, argv).ToLocalChecked();
+#else
+   cb->Call(isolate->GetCurrentContext()->Global(), 2, argv);
+#endif
+
+#if DBX_NODE_VERSION < 80000
+   if (try_catch.HasCaught()) {
+      node::FatalException(isolate, try_catch);
+   }
+#endif
+
+   baton->cb.Reset();
+
+   DBX_DBFUN_END(baton->c);
+
+   dbx_destroy_baton(baton, baton->pmeth);
+   dbx_request_memory_free(baton->pmeth->pcon, baton->pmeth, 0);
+
+   delete req;
+   return;
+}
+
+
 
 void DBX_DBNAME::Version(const FunctionCallbackInfo<Value>& args)
 {
@@ -963,7 +1173,7 @@ void DBX_DBNAME::Charset(const FunctionCallbackInfo<Value>& args)
 void DBX_DBNAME::Open(const FunctionCallbackInfo<Value>& args)
 {
    short async;
-   int rc, n, js_narg, error_code, key_len;
+   int rc, n, n1, js_narg, error_code, key_len;
    char name[256];
    DBXCON *pcon;
    DBXMETH *pmeth;
@@ -1115,6 +1325,86 @@ void DBX_DBNAME::Open(const FunctionCallbackInfo<Value>& args)
             }
          }
       }
+      else if (!strcmp(name, (char *) "pool_async")) { /* v2.5.35 */
+        if (DBX_GET(obj, key)->IsBoolean()) {
+            pcon->pool_async = DBX_TO_BOOLEAN(DBX_GET(obj, key))->IsTrue() ? 1 : 0;
+         }
+      }
+      else if (!strcmp(name, (char *) "pipeline")) { /* v2.5.35 */
+        if (DBX_GET(obj, key)->IsBoolean()) {
+            pcon->net_pipeline = DBX_TO_BOOLEAN(DBX_GET(obj, key))->IsTrue() ? 1 : 0;
+         }
+      }
+      else if (!strcmp(name, (char *) "net_async")) { /* v2.5.35 */
+        if (DBX_GET(obj, key)->IsBoolean()) {
+            pcon->net_async = DBX_TO_BOOLEAN(DBX_GET(obj, key))->IsTrue() ? 1 : 0;
+         }
+      }
+      else if (!strcmp(name, (char *) "buffer_zero_copy")) { /* v2.5.35 */
+         if (DBX_GET(obj, key)->IsBoolean()) {
+            pcon->buffer_zero_copy = DBX_TO_BOOLEAN(DBX_GET(obj, key))->IsTrue() ? DBX_BUFFER_ZERO_COPY : 0;
+         }
+         else {
+            pcon->buffer_zero_copy = DBX_INT32_VALUE(DBX_GET(obj, key));
+         }
+      }
+      else if (!strcmp(name, (char *) "string_external")) { /* v2.5.35 */
+         if (DBX_GET(obj, key)->IsBoolean()) {
+            pcon->string_external = DBX_TO_BOOLEAN(DBX_GET(obj, key))->IsTrue() ? DBX_STRING_EXTERNAL : 0;
+         }
+         else {
+            pcon->string_external = DBX_INT32_VALUE(DBX_GET(obj, key));
+         }
+      }
+      else if (!strcmp(name, (char *) "typed")) { /* v2.5.35 */
+        if (DBX_GET(obj, key)->IsBoolean()) {
+            pcon->typed = DBX_TO_BOOLEAN(DBX_GET(obj, key))->IsTrue() ? 1 : 0;
+         }
+      }
+      else if (!strcmp(name, (char *) "connection_pool_size")) {
+         pcon->net_pool_size = DBX_INT32_VALUE(DBX_GET(obj, key));
+      }
+      else if (!strcmp(name, (char *) "connection_pool_max")) {
+         pcon->net_pool_max = DBX_INT32_VALUE(DBX_GET(obj, key));
+      }
+      else if (!strcmp(name, (char *) "connection_health_check")) {
+         pcon->net_health_check = DBX_INT32_VALUE(DBX_GET(obj, key));
+      }
+      else if (!strcmp(name, (char *) "connection_pool_functions")) {
+        if (DBX_GET(obj, key)->IsBoolean()) {
+            pcon->net_pool_functions = DBX_TO_BOOLEAN(DBX_GET(obj, key))->IsTrue() ? 1 : 0;
+         }
+      }
+      else if (!strcmp(name, (char *) "pool_size")) { /* v2.5.35 */
+         pcon->pool_size = DBX_INT32_VALUE(DBX_GET(obj, key));
+      }
+      else if (!strcmp(name, (char *) "pool_max")) {
+         pcon->pool_max = DBX_INT32_VALUE(DBX_GET(obj, key));
+      }
+      else if (!strcmp(name, (char *) "pool_stack_size")) {
+         pcon->pool_stack_size = DBX_INT32_VALUE(DBX_GET(obj, key));
+      }
+      else if (!strcmp(name, (char *) "pool_idle_timeout")) {
+         pcon->pool_idle_timeout = DBX_INT32_VALUE(DBX_GET(obj, key));
+      }
+      else if (!strcmp(name, (char *) "pool_affinity")) {
+         pcon->pool_no_cpus = 0;
+         if (DBX_GET(obj, key)->IsArray()) {
+            Local<Array> cpus = Local<Array>::Cast(DBX_GET(obj, key));
+            for (n1 = 0; n1 < (int) cpus->Length() && pcon->pool_no_cpus < DBX_THREADPOOL_CPUS; n1 ++) {
+               pcon->pool_cpus[pcon->pool_no_cpus ++] = DBX_INT32_VALUE(DBX_GET(cpus, n1));
+            }
+         }
+         else if (DBX_GET(obj, key)->IsBoolean() && DBX_TO_BOOLEAN(DBX_GET(obj, key))->IsTrue()) {
+#if !defined(_WIN32)
+            /* spread the pool threads over all online CPUs */
+            n1 = (int) sysconf(_SC_NPROCESSORS_ONLN);
+            for (pcon->pool_no_cpus = 0; pcon->pool_no_cpus < n1 && pcon->pool_no_cpus < DBX_THREADPOOL_CPUS; pcon->pool_no_cpus ++) {
+               pcon->pool_cpus[pcon->pool_no_cpus] = pcon->pool_no_cpus;
+            }
+#endif
+         }
+      }
       else if (!strcmp(name, (char *) "debug")) {
          ; /* TODO */
       }
@@ -1168,6 +1458,17 @@ void DBX_DBNAME::Open(const FunctionCallbackInfo<Value>& args)
       dbx_log_transmission(pcon, pmeth, (char *) DBX_DBNAME_STR "::open");
    }
 
+#if !defined(_WIN32)
+   /* v2.5.35 */
+   if (pcon->pool_async && !pcon->p_async) {
+#if DBX_NODE_VERSION >= 120000
+      dbx_async_init(pcon, GetCurrentEventLoop(isolate));
+#else
+      dbx_async_init(pcon, uv_default_loop());
+#endif
+   }
+#endif
+
    if (async) {
       dbx_baton_t *baton = dbx_make_baton(c, pmeth);
       baton->isolate = isolate;
@@ -1230,6 +1531,7 @@ void DBX_DBNAME::Close(const FunctionCallbackInfo<Value>& args)
 
    DBX_DBFUN_START(c, pcon, pmeth);
 
+   dbx_async_drain(pcon); /* v2.5.35 outstanding requests still need the connection */
    pcon->open = 0;
 
    DBX_CALLBACK_FUN(js_narg, async);
@@ -1245,6 +1547,10 @@ void DBX_DBNAME::Close(const FunctionCallbackInfo<Value>& args)
       baton->pmeth->p_dbxfun = (int (*) (struct tagDBXMETH * pmeth)) dbx_do_nothing;
 
       dbx_close(baton->pmeth);
+      dbx_async_close(pcon); /* v2.5.35 */
+#if !defined(_WIN32)
+      netx_uv_close(pcon);
+#endif
 
       Local<Function> cb = Local<Function>::Cast(args[js_narg]);
 
@@ -1265,6 +1571,10 @@ void DBX_DBNAME::Close(const FunctionCallbackInfo<Value>& args)
    }
 
    dbx_close(pmeth);
+   dbx_async_close(pcon); /* v2.5.35 */
+#if !defined(_WIN32)
+   netx_uv_close(pcon);
+#endif
 
 Close_Exit:
 
@@ -1351,7 +1661,7 @@ void DBX_DBNAME::Namespace(const FunctionCallbackInfo<Value>& args)
       dbx_log_response(pcon, (char *) pmeth->output_val.svalue.buf_addr, (int) pmeth->output_val.svalue.len_used, (char *) DBX_DBNAME_STR "::namespace");
    }
 
-   result = dbx_new_string8n(isolate, pmeth->output_val.svalue.buf_addr, pmeth->output_val.svalue.len_used, pcon->utf8);
+   result = dbx_new_string8v(isolate, pmeth, pcon->utf8);
    dbx_request_memory_free(pcon, pmeth, 0);
    args.GetReturnValue().Set(result);
 }
@@ -1446,8 +1756,7 @@ Local<String> DBX_DBNAME::StringifyJSON(DBX_DBNAME *c, Local<Object> json)
 
 int DBX_DBNAME::GlobalReference(DBX_DBNAME *c, const FunctionCallbackInfo<Value>& args, DBXMETH *pmeth, DBXGREF *pgref, short context)
 {
-   int n, nx, rc, otype, len;
-   char *p;
+   int n, nx, rc, otype, prefix;
    char buffer[64];
    DBXVAL *pval;
    Local<Object> obj;
@@ -1467,7 +1776,13 @@ int DBX_DBNAME::GlobalReference(DBX_DBNAME *c, const FunctionCallbackInfo<Value>
    nx = 0;
    n = 0;
    pmeth->args[nx].cvalue.pstr = 0;
-   if (pgref) {
+
+   /* v2.5.35 an mglobal object's name and fixed keys are encoded once and then copied in as a block */
+   prefix = (pgref && pgref->pprefix) ? dbx_gprefix_restore(pmeth, *(pgref->pprefix)) : 0;
+   if (prefix) {
+      nx = prefix - 1;
+   }
+   else if (pgref) {
       pgref->global16_len ? dbx_ibuffer_add(pmeth, isolate, nx, str, (void *) pgref->global16, (int) pgref->global16_len, 1, 0) : dbx_ibuffer_add(pmeth, isolate, nx, str, (void *) pgref->global, (int) pgref->global_len, 0, 0);
    }
    else {
@@ -1507,7 +1822,7 @@ int DBX_DBNAME::GlobalReference(DBX_DBNAME *c, const FunctionCallbackInfo<Value>
 */
 
    nx ++;
-   if (pgref && (pval = pgref->pkey)) {
+   if (!prefix && pgref && (pval = pgref->pkey)) {
       while (pval) {
          pmeth->args[nx].cvalue.pstr = 0;
          if (pval->type == DBX_DTYPE_INT) {
@@ -1542,6 +1857,9 @@ int DBX_DBNAME::GlobalReference(DBX_DBNAME *c, const FunctionCallbackInfo<Value>
          pval = pval->pnext;
       }
    }
+   if (!prefix && pgref && pgref->pprefix) {
+      dbx_gprefix_save(pmeth, pgref->pprefix, nx);
+   }
 
    for (; n < pmeth->argc; n ++, nx ++) {
 
@@ -1553,14 +1871,17 @@ int DBX_DBNAME::GlobalReference(DBX_DBNAME *c, const FunctionCallbackInfo<Value>
          dbx_ibuffer_add(pmeth, isolate, nx, str, (void *) buffer, (int) strlen(buffer), 0, 0);
          pmeth->args[nx].type = DBX_DTYPE_INT;
       }
+      else if (pcon->typed && args[n]->IsNumber() && dbx_number_int64(DBX_NUMBER_VALUE(args[n]), &(pmeth->args[nx].num.int64))) { /* v2.5.35 */
+         T_SPRINTF(buffer, _dbxso(buffer), "%lld", pmeth->args[nx].num.int64);
+         dbx_ibuffer_add(pmeth, isolate, nx, str, (void *) buffer, (int) strlen(buffer), 0, 0);
+         pmeth->args[nx].type = DBX_DTYPE_INT64;
+      }
       else {
          pmeth->args[nx].type = DBX_DTYPE_STR;
          obj = dbx_is_object(args[n], &otype);
 
          if (otype == 2) {
-            p = node::Buffer::Data(obj);
-            len = (int) node::Buffer::Length(obj);
-            dbx_ibuffer_add(pmeth, isolate, nx, str, (void *) p, (int) len, 0, 0);
+            dbx_ibuffer_add_buffer(pmeth, isolate, nx, obj, 0); /* v2.5.35 */
          }
          else {
             str = DBX_TO_STRING(args[n]);
@@ -1570,10 +1891,7 @@ int DBX_DBNAME::GlobalReference(DBX_DBNAME *c, const FunctionCallbackInfo<Value>
 
       if (pmeth->increment && n == (pmeth->argc - 1)) { /* v1.3.8 */
          if (pcon->utf16 && pmeth->args[nx].cvalue.len_used < 32) {
-            unsigned int n;
-            for (n = 0; n < pmeth->args[nx].cvalue.len_used; n ++) {
-               buffer[n] = (char) pmeth->args[nx].cvalue.buf16_addr[n];
-            }
+            dbx_char16_to_char8((unsigned char *) buffer, pmeth->args[nx].cvalue.buf16_addr, pmeth->args[nx].cvalue.len_used);
             buffer[pmeth->args[nx].cvalue.len_used] = '\0';
          }
          else if (!pcon->utf16 && pmeth->args[nx].svalue.len_used < 32) {
@@ -1682,6 +2000,7 @@ void DBX_DBNAME::GetEx(const FunctionCallbackInfo<Value>& args, int binary)
    pmeth = dbx_request_memory(pcon, 1, 0);
 
    pmeth->binary = binary;
+   pmeth->typed = pcon->typed; /* v2.5.35 */
 
    DBX_CALLBACK_FUN(pmeth->argc, async);
 
@@ -1764,11 +2083,14 @@ void DBX_DBNAME::GetEx(const FunctionCallbackInfo<Value>& args, int binary)
    }
 
    if (binary) {
-      Local<Object> bx = node::Buffer::New(isolate, (char *) pmeth->output_val.svalue.buf_addr, (size_t) pmeth->output_val.svalue.len_used).ToLocalChecked();
+      Local<Object> bx = dbx_new_buffer(isolate, pmeth);
       args.GetReturnValue().Set(bx);
    }
+   else if (pmeth->typed && DBX_DTYPE_NUMERIC(pmeth->output_val.type)) { /* v2.5.35 */
+      args.GetReturnValue().Set(dbx_new_number(isolate, pmeth));
+   }
    else {
-      result = pcon->utf16 ? dbx_new_string16n(isolate, pmeth->output_val.cvalue.buf16_addr, pmeth->output_val.cvalue.len_used) : dbx_new_string8n(isolate, pmeth->output_val.svalue.buf_addr, pmeth->output_val.svalue.len_used, pcon->utf8);
+      result = pcon->utf16 ? dbx_new_string16n(isolate, pmeth->output_val.cvalue.buf16_addr, pmeth->output_val.cvalue.len_used) : dbx_new_string8v(isolate, pmeth, pcon->utf8);
       args.GetReturnValue().Set(result);
    }
 
@@ -1776,55 +2098,250 @@ void DBX_DBNAME::GetEx(const FunctionCallbackInfo<Value>& args, int binary)
    return;
 }
 
+/* v2.5.35 Marshal one [global, key ...] reference into the batch held in the request's input buffer */
+/* The reference is taken from 'ref' or, if that is empty, from the first 'argc' arguments */
+/* For a mixed batch, the first element of 'ref' names the operation */
+int DBX_DBNAME::BatchReference(DBX_DBNAME *c, const FunctionCallbackInfo<Value>& args, DBXMETH *pmeth, DBXBATCH *pbatch, Local<Array> ref, int argc)
+{
+   int n, otype, len, command, min_args, first;
+   char *p;
+   char buffer[64];
+   DBXBITEM *pitem;
+   Local<Value> value;
+   Local<Object> obj;
+   Local<String> str;
+   DBX_GET_ICONTEXT;
+   DBXCON *pcon = pmeth->pcon;
+
+   if (!ref.IsEmpty()) {
+      argc = (int) ref->Length();
+   }
 
-void DBX_DBNAME::Set(const FunctionCallbackInfo<Value>& args)
+   first = 0;
+   command = pbatch->command;
+   min_args = pbatch->min_args;
+   if (command == DBX_CMND_GBATCH) {
+      if (ref.IsEmpty() || argc < 1) {
+         return CACHE_FAILURE;
+      }
+      str = DBX_TO_STRING(DBX_GET(ref, 0));
+      len = dbx_string8_length(isolate, str, 0);
+      if (len < 1 || len >= (int) sizeof(buffer)) {
+         return CACHE_FAILURE;
+      }
+      dbx_write_char8(isolate, str, buffer, sizeof(buffer), 0);
+      buffer[len] = '\0';
+      command = dbx_batch_command(buffer, &min_args);
+      if (!command) {
+         return CACHE_FAILURE;
+      }
+      first = 1;
+      argc --;
+   }
+
+   if (argc < min_args || argc >= DBX_MAXARGS || pbatch->no_items >= pbatch->no_alloc) {
+      return CACHE_FAILURE;
+   }
+
+   pitem = &(pbatch->items[pbatch->no_items]);
+   pitem->command = command;
+   pitem->offset = pmeth->ibuffer_used;
+
+   for (n = 0; n < argc; n ++) {
+      value = ref.IsEmpty() ? args[n] : DBX_GET(ref, n + first);
+      pmeth->args[n].cvalue.pstr = 0;
+      pmeth->args[n].type = DBX_DTYPE_STR;
+
+      if (n == 0) {
+         str = DBX_TO_STRING(value);
+         len = dbx_string8_length(isolate, str, pcon->utf8);
+         /* API connections: the '^' can't be prefixed in place once the block header is written */
+         if (!pcon->net_connection && len > 0 && len < (int) (sizeof(buffer) - 2)) {
+            dbx_write_char8(isolate, str, buffer + 1, sizeof(buffer) - 1, pcon->utf8);
+            if (buffer[1] == '^') {
+               dbx_ibuffer_add(pmeth, isolate, n, str, (void *) (buffer + 1), len, 0, 2);
+            }
+            else {
+               buffer[0] = '^';
+               dbx_ibuffer_add(pmeth, isolate, n, str, (void *) buffer, len + 1, 0, 2);
+            }
+         }
+         else {
+            dbx_ibuffer_add(pmeth, isolate, n, str, NULL, 0, 0, 2);
+         }
+      }
+      else if (value->IsInt32()) {
+         if (!pcon->net_connection) {
+            pmeth->args[n].type = DBX_DTYPE_INT; /* recorded in the block header */
+         }
+         T_SPRINTF(buffer, _dbxso(buffer), "%d", (int) DBX_INT32_VALUE(value));
+         dbx_ibuffer_add(pmeth, isolate, n, str, (void *) buffer, (int) strlen(buffer), 0, 2);
+      }
+      else {
+         obj = dbx_is_object(value, &otype);
+         if (otype == 2) {
+            p = node::Buffer::Data(obj);
+            len = (int) node::Buffer::Length(obj);
+            dbx_ibuffer_add(pmeth, isolate, n, str, (void *) p, len, 0, 2);
+         }
+         else {
+            str = DBX_TO_STRING(value);
+            dbx_ibuffer_add(pmeth, isolate, n, str, NULL, 0, 0, 2);
+         }
+      }
+   }
+
+   pitem->len = pmeth->ibuffer_used - pitem->offset;
+   pitem->argc = argc;
+   pitem->rc = CACHE_SUCCESS;
+   pitem->ooffset = 0;
+   pitem->olen = 0;
+   pbatch->no_items ++;
+
+   return CACHE_SUCCESS;
+}
+
+
+/* v2.5.35 */
+void DBX_DBNAME::GetMany(const FunctionCallbackInfo<Value>& args)
+{
+   return BatchEx(args, DBX_CMND_GGET);
+}
+
+
+/* v2.5.35 */
+void DBX_DBNAME::SetMany(const FunctionCallbackInfo<Value>& args)
+{
+   return BatchEx(args, DBX_CMND_GSET);
+}
+
+
+/* v2.5.35 */
+void DBX_DBNAME::Batch(const FunctionCallbackInfo<Value>& args)
+{
+   return BatchEx(args, DBX_CMND_GBATCH);
+}
+
+
+/* v2.5.35 */
+void DBX_DBNAME::BatchEx(const FunctionCallbackInfo<Value>& args, int command)
 {
    short async;
-   int rc;
+   int rc, n, no_items, min_args;
+   char *name, *log_name;
    DBXCON *pcon;
    DBXMETH *pmeth;
-   Local<String> result;
+   DBXBATCH *pbatch;
+   Local<Array> refs;
+   Local<Value> ref;
+   Local<Value> result;
    DBX_DBNAME *c = ObjectWrap::Unwrap<DBX_DBNAME>(args.This());
-   DBX_GET_ISOLATE;
+   DBX_GET_ICONTEXT;
    c->dbx_count ++;
 
+   /* a set needs at least the global name and the data value: a mixed batch checks each item against its own operation */
+   if (command == DBX_CMND_GSET) {
+      name = (char *) "SetMany";
+      log_name = (char *) DBX_DBNAME_STR "::setmany";
+      min_args = 2;
+   }
+   else if (command == DBX_CMND_GBATCH) {
+      name = (char *) "Batch";
+      log_name = (char *) DBX_DBNAME_STR "::batch";
+      min_args = 1;
+   }
+   else {
+      name = (char *) "GetMany";
+      log_name = (char *) DBX_DBNAME_STR "::getmany";
+      min_args = 1;
+   }
+
    pcon = c->pcon;
    if (pcon->log_functions) {
-      LogFunction(c, args, NULL, (char *) DBX_DBNAME_STR "::set");
+      LogFunction(c, args, NULL, log_name);
    }
-   pmeth = dbx_request_memory(pcon, 1, 0);
+   pmeth = dbx_request_memory(pcon, 0, 0);
 
    DBX_CALLBACK_FUN(pmeth->argc, async);
 
-   if (pmeth->argc >= DBX_MAXARGS) {
-      isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "Too many arguments on Set", 1)));
+   if (pmeth->argc == 0 || !args[0]->IsArray()) {
+      char error[DBX_ERROR_SIZE];
+
+      T_SPRINTF(error, _dbxso(error), "Missing or invalid array of global references on %s", name);
+      isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, error, 1)));
       dbx_request_memory_free(pcon, pmeth, 0);
       return;
    }
-   if (pmeth->argc == 0) {
-      isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "Missing or invalid global name on Set", 1)));
+
+   DBX_DBFUN_START(c, pcon, pmeth);
+
+   refs = Local<Array>::Cast(args[0]);
+   no_items = (int) refs->Length();
+
+   pbatch = dbx_batch_alloc(command, no_items, min_args);
+   if (!pbatch) {
+      char error[DBX_ERROR_SIZE];
+
+      T_SPRINTF(error, _dbxso(error), "No memory available for %s", name);
+      isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, error, 1)));
       dbx_request_memory_free(pcon, pmeth, 0);
       return;
    }
+   pmeth->pbatch = pbatch;
+   pmeth->ibuffer_used = 0;
+   pmeth->cargc = 0;
+   if (command == DBX_CMND_GSET) {
+      pmeth->p_dbxfun = dbx_setmany;
+   }
+   else if (command == DBX_CMND_GBATCH) {
+      pmeth->p_dbxfun = dbx_batch;
+   }
+   else {
+      pmeth->p_dbxfun = dbx_getmany;
+   }
 
-   DBX_DBFUN_START(c, pcon, pmeth);
+   rc = CACHE_SUCCESS;
+   for (n = 0; n < no_items; n ++) {
+      ref = DBX_GET(refs, n);
+      if (!ref->IsArray()) {
+         rc = CACHE_FAILURE;
+         break;
+      }
+      rc = BatchReference(c, args, pmeth, pbatch, Local<Array>::Cast(ref), 0);
+      if (rc != CACHE_SUCCESS) {
+         break;
+      }
+   }
+   if (rc != CACHE_SUCCESS) {
+      char error[DBX_ERROR_SIZE];
 
-   rc = GlobalReference(c, args, pmeth, NULL, (async || pcon->net_connection || pcon->tlevel));
-   DBX_DB_CHECK(rc);
+      if (command == DBX_CMND_GBATCH) {
+         T_SPRINTF(error, _dbxso(error), "Invalid operation at position %d on %s", n, name);
+      }
+      else {
+         T_SPRINTF(error, _dbxso(error), "Invalid global reference at position %d on %s", n, name);
+      }
+      isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, error, 1)));
+      dbx_request_memory_free(pcon, pmeth, 0);
+      return;
+   }
 
    if (pcon->log_transmissions) {
-      dbx_log_transmission(pcon, pmeth, (char *) DBX_DBNAME_STR "::set");
+      dbx_log_transmission(pcon, pmeth, log_name);
    }
 
    if (async) {
       dbx_baton_t *baton = dbx_make_baton(c, pmeth);
       baton->isolate = isolate;
-      baton->pmeth->p_dbxfun = (int (*) (struct tagDBXMETH * pmeth)) dbx_set;
       Local<Function> cb = Local<Function>::Cast(args[pmeth->argc]);
+
       baton->cb.Reset(isolate, cb);
+
       c->Ref();
-      if (dbx_queue_task((void *) dbx_process_task, (void *) dbx_invoke_callback, baton, 0)) {
+
+      if (dbx_queue_task((void *) dbx_process_task, (void *) dbx_invoke_callback_batch, baton, 0)) {
          char error[DBX_ERROR_SIZE];
+
          T_STRCPY(error, _dbxso(error), pcon->error);
          dbx_destroy_baton(baton, pmeth);
          isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, error, 1)));
@@ -1834,14 +2351,99 @@ void DBX_DBNAME::Set(const FunctionCallbackInfo<Value>& args)
       return;
    }
 
-   if (pcon->net_connection) {
-      rc = dbx_set(pmeth);
+   if (no_items == 0) {
+      rc = CACHE_SUCCESS;
    }
-   else if (pcon->dbtype == DBX_DBTYPE_YOTTADB) {
-      if (pcon->tlevel) {
-         pmeth->p_dbxfun = (int (*) (struct tagDBXMETH * pmeth)) dbx_set;
-         rc = ydb_transaction_task(pmeth, YDB_TPCTX_DB);
-      }
+   else if (!pcon->net_connection && pcon->dbtype == DBX_DBTYPE_YOTTADB && pcon->tlevel) {
+      /* the whole batch is one hand-off to the transaction thread */
+      rc = ydb_transaction_task(pmeth, YDB_TPCTX_DB);
+   }
+   else {
+      rc = pmeth->p_dbxfun(pmeth);
+   }
+
+   DBX_DBFUN_END(c);
+
+   if (rc != CACHE_SUCCESS && pcon->error_mode == 1) {
+      isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) pcon->error, 1)));
+      dbx_request_memory_free(pcon, pmeth, 0);
+      return;
+   }
+
+   result = dbx_batch_result(isolate, pcon, pbatch);
+   args.GetReturnValue().Set(result);
+
+   dbx_request_memory_free(pcon, pmeth, 0);
+   return;
+}
+
+
+
+void DBX_DBNAME::Set(const FunctionCallbackInfo<Value>& args)
+{
+   short async;
+   int rc;
+   DBXCON *pcon;
+   DBXMETH *pmeth;
+   Local<String> result;
+   DBX_DBNAME *c = ObjectWrap::Unwrap<DBX_DBNAME>(args.This());
+   DBX_GET_ISOLATE;
+   c->dbx_count ++;
+
+   pcon = c->pcon;
+   if (pcon->log_functions) {
+      LogFunction(c, args, NULL, (char *) DBX_DBNAME_STR "::set");
+   }
+   pmeth = dbx_request_memory(pcon, 1, 0);
+
+   DBX_CALLBACK_FUN(pmeth->argc, async);
+
+   if (pmeth->argc >= DBX_MAXARGS) {
+      isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "Too many arguments on Set", 1)));
+      dbx_request_memory_free(pcon, pmeth, 0);
+      return;
+   }
+   if (pmeth->argc == 0) {
+      isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "Missing or invalid global name on Set", 1)));
+      dbx_request_memory_free(pcon, pmeth, 0);
+      return;
+   }
+
+   DBX_DBFUN_START(c, pcon, pmeth);
+
+   rc = GlobalReference(c, args, pmeth, NULL, (async || pcon->net_connection || pcon->tlevel));
+   DBX_DB_CHECK(rc);
+
+   if (pcon->log_transmissions) {
+      dbx_log_transmission(pcon, pmeth, (char *) DBX_DBNAME_STR "::set");
+   }
+
+   if (async) {
+      dbx_baton_t *baton = dbx_make_baton(c, pmeth);
+      baton->isolate = isolate;
+      baton->pmeth->p_dbxfun = (int (*) (struct tagDBXMETH * pmeth)) dbx_set;
+      Local<Function> cb = Local<Function>::Cast(args[pmeth->argc]);
+      baton->cb.Reset(isolate, cb);
+      c->Ref();
+      if (dbx_queue_task((void *) dbx_process_task, (void *) dbx_invoke_callback, baton, 0)) {
+         char error[DBX_ERROR_SIZE];
+         T_STRCPY(error, _dbxso(error), pcon->error);
+         dbx_destroy_baton(baton, pmeth);
+         isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, error, 1)));
+         dbx_request_memory_free(pcon, pmeth, 0);
+         return;
+      }
+      return;
+   }
+
+   if (pcon->net_connection) {
+      rc = dbx_set(pmeth);
+   }
+   else if (pcon->dbtype == DBX_DBTYPE_YOTTADB) {
+      if (pcon->tlevel) {
+         pmeth->p_dbxfun = (int (*) (struct tagDBXMETH * pmeth)) dbx_set;
+         rc = ydb_transaction_task(pmeth, YDB_TPCTX_DB);
+      }
       else {
          rc = pcon->p_ydb_so->p_ydb_set_s(&(pmeth->args[0].svalue), pmeth->cargc - 2, &pmeth->yargs[0], &(pmeth->args[pmeth->cargc - 1].svalue));
       }
@@ -1867,7 +2469,7 @@ void DBX_DBNAME::Set(const FunctionCallbackInfo<Value>& args)
       dbx_log_response(pcon, (char *) pmeth->output_val.svalue.buf_addr, (int) pmeth->output_val.svalue.len_used, (char *) DBX_DBNAME_STR "::set");
    }
 
-   result = dbx_new_string8n(isolate, pmeth->output_val.svalue.buf_addr, pmeth->output_val.svalue.len_used, pcon->utf8);
+   result = dbx_new_string8v(isolate, pmeth, pcon->utf8);
    args.GetReturnValue().Set(result);
 
    dbx_request_memory_free(pcon, pmeth, 0);
@@ -1967,7 +2569,7 @@ void DBX_DBNAME::Defined(const FunctionCallbackInfo<Value>& args)
       dbx_log_response(pcon, (char *) pmeth->output_val.svalue.buf_addr, (int) pmeth->output_val.svalue.len_used, (char *) DBX_DBNAME_STR "::defined");
    }
 
-   result = dbx_new_string8n(isolate, pmeth->output_val.svalue.buf_addr, pmeth->output_val.svalue.len_used, pcon->utf8);
+   result = dbx_new_string8v(isolate, pmeth, pcon->utf8);
    args.GetReturnValue().Set(result);
    dbx_request_memory_free(pcon, pmeth, 0);
    return;
@@ -2065,7 +2667,7 @@ void DBX_DBNAME::Delete(const FunctionCallbackInfo<Value>& args)
       dbx_log_response(pcon, (char *) pmeth->output_val.svalue.buf_addr, (int) pmeth->output_val.svalue.len_used, (char *) DBX_DBNAME_STR "::delete");
    }
 
-   result = dbx_new_string8n(isolate, pmeth->output_val.svalue.buf_addr, pmeth->output_val.svalue.len_used, pcon->utf8);
+   result = dbx_new_string8v(isolate, pmeth, pcon->utf8);
    args.GetReturnValue().Set(result);
    dbx_request_memory_free(pcon, pmeth, 0);
    return;
@@ -2162,7 +2764,7 @@ void DBX_DBNAME::Next(const FunctionCallbackInfo<Value>& args)
       dbx_log_response(pcon, (char *) pmeth->output_val.svalue.buf_addr, (int) pmeth->output_val.svalue.len_used, (char *) DBX_DBNAME_STR "::next");
    }
 
-   result = pcon->utf16 ? dbx_new_string16n(isolate, pmeth->output_val.cvalue.buf16_addr, pmeth->output_val.cvalue.len_used) : dbx_new_string8n(isolate, pmeth->output_val.svalue.buf_addr, pmeth->output_val.svalue.len_used, pcon->utf8);
+   result = pcon->utf16 ? dbx_new_string16n(isolate, pmeth->output_val.cvalue.buf16_addr, pmeth->output_val.cvalue.len_used) : dbx_new_string8v(isolate, pmeth, pcon->utf8);
    args.GetReturnValue().Set(result);
    dbx_request_memory_free(pcon, pmeth, 0);
    return;
@@ -2259,7 +2861,7 @@ void DBX_DBNAME::Previous(const FunctionCallbackInfo<Value>& args)
       dbx_log_response(pcon, (char *) pmeth->output_val.svalue.buf_addr, (int) pmeth->output_val.svalue.len_used, (char *) DBX_DBNAME_STR "::previous");
    }
 
-   result = pcon->utf16 ? dbx_new_string16n(isolate, pmeth->output_val.cvalue.buf16_addr, pmeth->output_val.cvalue.len_used) : dbx_new_string8n(isolate, pmeth->output_val.svalue.buf_addr, pmeth->output_val.svalue.len_used, pcon->utf8);
+   result = pcon->utf16 ? dbx_new_string16n(isolate, pmeth->output_val.cvalue.buf16_addr, pmeth->output_val.cvalue.len_used) : dbx_new_string8v(isolate, pmeth, pcon->utf8);
 
    args.GetReturnValue().Set(result);
    dbx_request_memory_free(pcon, pmeth, 0);
@@ -2300,6 +2902,7 @@ void DBX_DBNAME::Increment(const FunctionCallbackInfo<Value>& args)
    DBX_DBFUN_START(c, pcon, pmeth);
 
    pmeth->increment = 1;
+   pmeth->typed = pcon->typed; /* v2.5.35 */
    rc = GlobalReference(c, args, pmeth, NULL, (async || pcon->net_connection || pcon->tlevel));
    DBX_DB_CHECK(rc);
 
@@ -2358,8 +2961,13 @@ void DBX_DBNAME::Increment(const FunctionCallbackInfo<Value>& args)
       dbx_log_response(pcon, (char *) pmeth->output_val.svalue.buf_addr, (int) pmeth->output_val.svalue.len_used, (char *) DBX_DBNAME_STR "::increment");
    }
 
-   result = pcon->utf16 ? dbx_new_string16n(isolate, pmeth->output_val.cvalue.buf16_addr, pmeth->output_val.cvalue.len_used) : dbx_new_string8n(isolate, pmeth->output_val.svalue.buf_addr, pmeth->output_val.svalue.len_used, pcon->utf8);
-   args.GetReturnValue().Set(result);
+   if (pmeth->typed && DBX_DTYPE_NUMERIC(pmeth->output_val.type)) { /* v2.5.35 */
+      args.GetReturnValue().Set(dbx_new_number(isolate, pmeth));
+   }
+   else {
+      result = pcon->utf16 ? dbx_new_string16n(isolate, pmeth->output_val.cvalue.buf16_addr, pmeth->output_val.cvalue.len_used) : dbx_new_string8v(isolate, pmeth, pcon->utf8);
+      args.GetReturnValue().Set(result);
+   }
    dbx_request_memory_free(pcon, pmeth, 0);
    return;
 }
@@ -2485,7 +3093,7 @@ void DBX_DBNAME::Lock(const FunctionCallbackInfo<Value>& args)
       dbx_log_response(pcon, (char *) pmeth->output_val.svalue.buf_addr, (int) pmeth->output_val.svalue.len_used, (char *) DBX_DBNAME_STR "::lock");
    }
 
-   result = dbx_new_string8n(isolate, pmeth->output_val.svalue.buf_addr, pmeth->output_val.svalue.len_used, pcon->utf8);
+   result = dbx_new_string8v(isolate, pmeth, pcon->utf8);
    args.GetReturnValue().Set(result);
    dbx_request_memory_free(pcon, pmeth, 0);
    return;
@@ -2592,7 +3200,7 @@ void DBX_DBNAME::Unlock(const FunctionCallbackInfo<Value>& args)
       dbx_log_response(pcon, (char *) pmeth->output_val.svalue.buf_addr, (int) pmeth->output_val.svalue.len_used, (char *) DBX_DBNAME_STR "::unlock");
    }
 
-   result = dbx_new_string8n(isolate, pmeth->output_val.svalue.buf_addr, pmeth->output_val.svalue.len_used, pcon->utf8);
+   result = dbx_new_string8v(isolate, pmeth, pcon->utf8);
    args.GetReturnValue().Set(result);
    dbx_request_memory_free(pcon, pmeth, 0);
    return;
@@ -2628,6 +3236,7 @@ void DBX_DBNAME::MGlobal(const FunctionCallbackInfo<Value>& args)
 
    gx->c = c;
    gx->pkey = NULL;
+   gx->pprefix = NULL; /* v2.5.35 */
    gx->global_name[0] = '\0';
    gx->global_name_len = 0;
    gx->global_name16[0] = 0;
@@ -2666,6 +3275,61 @@ void DBX_DBNAME::MGlobal(const FunctionCallbackInfo<Value>& args)
 }
 
 
+/* v2.5.35 */
+void DBX_DBNAME::MBulk(const FunctionCallbackInfo<Value>& args)
+{
+   DBXCON *pcon;
+   DBX_DBNAME *c = ObjectWrap::Unwrap<DBX_DBNAME>(args.This());
+   DBX_GET_ISOLATE;
+   c->dbx_count ++;
+
+   pcon = c->pcon;
+   if (pcon->log_functions) {
+      LogFunction(c, args, NULL, (char *) DBX_DBNAME_STR "::mbulk");
+   }
+
+   mbulk *bx = mbulk::NewInstance(args);
+
+   bx->c = c;
+   if (args.Length() > 0 && mbulk::options(bx, args, 0) < 0) {
+      isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "Invalid option on the mbulk method", 1)));
+      return;
+   }
+
+   return;
+}
+
+
+/* v2.5.35 */
+void DBX_DBNAME::MFunction(const FunctionCallbackInfo<Value>& args)
+{
+   DBXCON *pcon;
+   DBX_DBNAME *c = ObjectWrap::Unwrap<DBX_DBNAME>(args.This());
+   DBX_GET_ISOLATE;
+   c->dbx_count ++;
+
+   pcon = c->pcon;
+   if (pcon->log_functions) {
+      LogFunction(c, args, NULL, (char *) DBX_DBNAME_STR "::mfunction");
+   }
+
+   if (args.Length() < 1) {
+      isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "The mfunction method takes one argument (the function reference: label^routine)", 1)));
+      return;
+   }
+
+   mfunction *fx = mfunction::NewInstance(args);
+
+   fx->c = c;
+   if (mfunction::set_function(fx, isolate, args[0]) < 0) {
+      isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "Missing or invalid function name on the mfunction method", 1)));
+      return;
+   }
+
+   return;
+}
+
+
 void DBX_DBNAME::MGlobal_Close(const FunctionCallbackInfo<Value>& args)
 {
    int js_narg;
@@ -2763,8 +3427,7 @@ void DBX_DBNAME::MGlobalQuery_Close(const FunctionCallbackInfo<Value>& args)
 
 int DBX_DBNAME::ExtFunctionReference(DBX_DBNAME *c, const FunctionCallbackInfo<Value>& args, DBXMETH *pmeth, DBXFREF *pfref, DBXFUN *pfun, short context)
 {
-   int n, nx, rc, otype, len;
-   char *p;
+   int n, nx, rc, otype;
    char buffer[64];
    Local<Object> obj;
    Local<String> str;
@@ -2783,7 +3446,7 @@ int DBX_DBNAME::ExtFunctionReference(DBX_DBNAME *c, const FunctionCallbackInfo<V
    n = 0;
    pmeth->args[nx].cvalue.pstr = 0;
    if (pfref) {
-      pcon->utf16 ? dbx_ibuffer_add(pmeth, isolate, nx, str, (void *) pfref->function16, (int) pfref->function_len, 1, 1) : dbx_ibuffer_add(pmeth, isolate, nx, str, (void *) pfref->function, (int) pfref->function_len, 0, 1);
+      pcon->utf16 ? dbx_ibuffer_add(pmeth, isolate, nx, str, (void *) pfref->function16, (int) pfref->function16_len, 1, 1) : dbx_ibuffer_add(pmeth, isolate, nx, str, (void *) pfref->function, (int) pfref->function_len, 0, 1);
    }
    else {
       str = DBX_TO_STRING(args[n]);
@@ -2791,7 +3454,11 @@ int DBX_DBNAME::ExtFunctionReference(DBX_DBNAME *c, const FunctionCallbackInfo<V
       n ++;
    }
 
-   if (context == 0) {
+   if (pfref && pfref->pfun) { /* v2.5.35 prepared function (mfunction): the reference is parsed once, here in the main thread */
+      pmeth->pfref = pfref;
+      dbx_function_prepare(pmeth, pfun);
+   }
+   else if (context == 0) {
       if (pcon->utf16) {
          unsigned int n16, nc;
 
@@ -2823,9 +3490,9 @@ int DBX_DBNAME::ExtFunctionReference(DBX_DBNAME *c, const FunctionCallbackInfo<V
          pfun->label_len = (int) strlen(pfun->label);
          pfun->routine_len = (int) strlen(pfun->routine);
       }
-      if (pcon->dbtype != DBX_DBTYPE_YOTTADB) {
-         rc = pcon->utf16 ? pcon->p_isc_so->p_CachePushFuncW(&(pfun->rflag), (int) pfun->label_len, (const unsigned short *) pfun->label16, (int) pfun->routine_len, (const unsigned short *) pfun->routine16) : pcon->p_isc_so->p_CachePushFunc(&(pfun->rflag), (int) pfun->label_len, (const Callin_char_t *) pfun->label, (int) pfun->routine_len, (const Callin_char_t *) pfun->routine);
-      }
+   }
+   if (context == 0 && pcon->dbtype != DBX_DBTYPE_YOTTADB) {
+      rc = pcon->utf16 ? pcon->p_isc_so->p_CachePushFuncW(&(pfun->rflag), (int) pfun->label_len, (const unsigned short *) pfun->label16, (int) pfun->routine_len, (const unsigned short *) pfun->routine16) : pcon->p_isc_so->p_CachePushFunc(&(pfun->rflag), (int) pfun->label_len, (const Callin_char_t *) pfun->label, (int) pfun->routine_len, (const Callin_char_t *) pfun->routine);
    }
 
    nx ++;
@@ -2840,14 +3507,17 @@ int DBX_DBNAME::ExtFunctionReference(DBX_DBNAME *c, const FunctionCallbackInfo<V
          T_SPRINTF(buffer, _dbxso(buffer), "%d", pmeth->args[nx].num.int32);
          dbx_ibuffer_add(pmeth, isolate, nx, str, (void *) buffer, (int) strlen(buffer), 0, 1);
       }
+      else if (pcon->typed && args[n]->IsNumber() && dbx_number_int64(DBX_NUMBER_VALUE(args[n]), &(pmeth->args[nx].num.int64))) { /* v2.5.35 */
+         T_SPRINTF(buffer, _dbxso(buffer), "%lld", pmeth->args[nx].num.int64);
+         dbx_ibuffer_add(pmeth, isolate, nx, str, (void *) buffer, (int) strlen(buffer), 0, 1);
+         pmeth->args[nx].type = DBX_DTYPE_INT64;
+      }
       else {
          pmeth->args[nx].type = DBX_DTYPE_STR;
          obj = dbx_is_object(args[n], &otype);
 
          if (otype == 2) {
-            p = node::Buffer::Data(obj);
-            len = (int) node::Buffer::Length(obj);
-            dbx_ibuffer_add(pmeth, isolate, nx, str, (void *) p, (int) len, 0, 1);
+            dbx_ibuffer_add_buffer(pmeth, isolate, nx, obj, 1); /* v2.5.35 */
          }
          else {
             str = DBX_TO_STRING(args[n]);
@@ -2894,6 +3564,7 @@ void DBX_DBNAME::ExtFunctionEx(const FunctionCallbackInfo<Value>& args, int bina
    pmeth = dbx_request_memory(pcon, 1, 0);
 
    pmeth->binary = binary;
+   pmeth->typed = pcon->typed; /* v2.5.35 */
 
    DBX_CALLBACK_FUN(pmeth->argc, async);
 
@@ -2966,11 +3637,14 @@ void DBX_DBNAME::ExtFunctionEx(const FunctionCallbackInfo<Value>& args, int bina
    }
 
    if (binary) {
-      Local<Object> bx = node::Buffer::New(isolate, (char *) pmeth->output_val.svalue.buf_addr, (size_t) pmeth->output_val.svalue.len_used).ToLocalChecked();
+      Local<Object> bx = dbx_new_buffer(isolate, pmeth);
       args.GetReturnValue().Set(bx);
    }
+   else if (pmeth->typed && DBX_DTYPE_NUMERIC(pmeth->output_val.type)) { /* v2.5.35 */
+      args.GetReturnValue().Set(dbx_new_number(isolate, pmeth));
+   }
    else {
-      result = pcon->utf16 ? dbx_new_string16n(isolate, pmeth->output_val.cvalue.buf16_addr, pmeth->output_val.cvalue.len_used) : dbx_new_string8n(isolate, pmeth->output_val.svalue.buf_addr, pmeth->output_val.svalue.len_used, pcon->utf8);
+      result = pcon->utf16 ? dbx_new_string16n(isolate, pmeth->output_val.cvalue.buf16_addr, pmeth->output_val.cvalue.len_used) : dbx_new_string8v(isolate, pmeth, pcon->utf8);
       args.GetReturnValue().Set(result);
    }
    dbx_request_memory_free(pcon, pmeth, 0);
@@ -2981,8 +3655,7 @@ void DBX_DBNAME::ExtFunctionEx(const FunctionCallbackInfo<Value>& args, int bina
 
 int DBX_DBNAME::ClassReference(DBX_DBNAME *c, const FunctionCallbackInfo<Value>& args, DBXMETH *pmeth, DBXCREF *pcref, int argc_offset, short context)
 {
-   int n, nx, rc, otype, fc, mn, len;
-   char *p;
+   int n, nx, rc, otype, fc, mn;
    char buffer[64];
    Local<Object> obj;
    Local<String> str;
@@ -3059,15 +3732,18 @@ int DBX_DBNAME::ClassReference(DBX_DBNAME *c, const FunctionCallbackInfo<Value>&
          dbx_ibuffer_add(pmeth, isolate, nx, str, (void *) buffer, (int) strlen(buffer), 0, 0);
          pmeth->args[nx].type = DBX_DTYPE_INT;
       }
+      else if (pcon->typed && args[n]->IsNumber() && dbx_number_int64(DBX_NUMBER_VALUE(args[n]), &(pmeth->args[nx].num.int64))) { /* v2.5.35 */
+         T_SPRINTF(buffer, _dbxso(buffer), "%lld", pmeth->args[nx].num.int64);
+         dbx_ibuffer_add(pmeth, isolate, nx, str, (void *) buffer, (int) strlen(buffer), 0, 0);
+         pmeth->args[nx].type = DBX_DTYPE_INT64;
+      }
       else {
 
          pmeth->args[nx].type = DBX_DTYPE_STR;
          obj = dbx_is_object(args[n], &otype);
 
          if (otype == 2) {
-            p = node::Buffer::Data(obj);
-            len = (int) node::Buffer::Length(obj);
-            dbx_ibuffer_add(pmeth, isolate, nx, str, (void *) p, (int) len, 0, 0);
+            dbx_ibuffer_add_buffer(pmeth, isolate, nx, obj, 0); /* v2.5.35 */
          }
          else {
             clx = NULL;
@@ -3140,6 +3816,7 @@ void DBX_DBNAME::ClassMethodEx(const FunctionCallbackInfo<Value>& args, int bina
    pmeth = dbx_request_memory(pcon, 1, 0);
 
    pmeth->binary = binary;
+   pmeth->typed = pcon->typed; /* v2.5.35 */
 
    DBX_CALLBACK_FUN(pmeth->argc, async);
 
@@ -3221,11 +3898,14 @@ void DBX_DBNAME::ClassMethodEx(const FunctionCallbackInfo<Value>& args, int bina
 
    if (pmeth->output_val.type != DBX_DTYPE_OREF) {
       if (binary) {
-         Local<Object> bx = node::Buffer::New(isolate, (char *) pmeth->output_val.svalue.buf_addr, (size_t) pmeth->output_val.svalue.len_used).ToLocalChecked();
+         Local<Object> bx = dbx_new_buffer(isolate, pmeth);
          args.GetReturnValue().Set(bx);
       }
+      else if (pmeth->typed && DBX_DTYPE_NUMERIC(pmeth->output_val.type)) { /* v2.5.35 */
+         args.GetReturnValue().Set(dbx_new_number(isolate, pmeth));
+      }
       else {
-         str = pcon->utf16 ? dbx_new_string16n(isolate, pmeth->output_val.cvalue.buf16_addr, pmeth->output_val.cvalue.len_used) : dbx_new_string8n(isolate, pmeth->output_val.svalue.buf_addr, pmeth->output_val.svalue.len_used, pcon->utf8);
+         str = pcon->utf16 ? dbx_new_string16n(isolate, pmeth->output_val.cvalue.buf16_addr, pmeth->output_val.cvalue.len_used) : dbx_new_string8v(isolate, pmeth, pcon->utf8);
          args.GetReturnValue().Set(str);
       }
       dbx_request_memory_free(pcon, pmeth, 0);
@@ -3608,13 +4288,100 @@ void DBX_DBNAME::Benchmark(const FunctionCallbackInfo<Value>& args)
    DBX_DB_UNLOCK();
 
 #else
+   int n, otype, key_len, rc;
    char ibuffer[256];
    char obuffer[256];
+   DBXBENCH *pbench;
+   Local<Object> obj;
+   Local<Object> bresult;
+   Local<String> key;
    Local<String> result;
    DBX_DBNAME *c = ObjectWrap::Unwrap<DBX_DBNAME>(args.This());
    DBX_GET_ICONTEXT;
    c->dbx_count ++;
 
+   /* v2.5.35 db.benchmark({test: <name>, requests: <n>, threads: <n>, size: <bytes>}) */
+   obj = dbx_is_object(args[0], &otype);
+   if (otype == 1) {
+      pbench = (DBXBENCH *) dbx_malloc(sizeof(DBXBENCH), 0);
+      if (!pbench) {
+         isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "No memory available for benchmark", 1)));
+         return;
+      }
+      memset((void *) pbench, 0, sizeof(DBXBENCH));
+      pbench->pcon = c->pcon;
+      pbench->requests = 100000;
+      pbench->threads = 4;
+
+#if DBX_NODE_VERSION >= 120000
+      Local<Array> a = obj->GetPropertyNames(icontext).ToLocalChecked();
+#else
+      Local<Array> a = obj->GetPropertyNames();
+#endif
+      for (n = 0; n < (int) a->Length(); n ++) {
+         key = DBX_TO_STRING(DBX_GET(a, n));
+         key_len = dbx_string8_length(isolate, key, 0);
+         if (key_len > 60) {
+            continue;
+         }
+         DBX_WRITE_UTF8(key, (char *) ibuffer, sizeof(ibuffer));
+         if (!strcmp(ibuffer, (char *) "test")) {
+            dbx_write_char8(isolate, DBX_TO_STRING(DBX_GET(obj, key)), ibuffer, sizeof(ibuffer), 1);
+            ibuffer[31] = '\0';
+            strcpy(pbench->test, ibuffer);
+         }
+         else if (!strcmp(ibuffer, (char *) "requests")) {
+            pbench->requests = (int) DBX_INT32_VALUE(DBX_GET(obj, key));
+         }
+         else if (!strcmp(ibuffer, (char *) "threads")) {
+            pbench->threads = (int) DBX_INT32_VALUE(DBX_GET(obj, key));
+         }
+         else if (!strcmp(ibuffer, (char *) "size")) {
+            pbench->size = (int) DBX_INT32_VALUE(DBX_GET(obj, key));
+         }
+      }
+      if (pbench->requests < 1) {
+         pbench->requests = 1;
+      }
+      if (pbench->threads < 1) {
+         pbench->threads = 1;
+      }
+      if (pbench->threads > DBX_BENCH_THREADS) {
+         pbench->threads = DBX_BENCH_THREADS;
+      }
+
+      if (!strcmp(pbench->test, (char *) "completion")) {
+         rc = dbx_benchmark_completion(pbench);
+      }
+      else if (!strcmp(pbench->test, (char *) "request")) {
+         rc = dbx_benchmark_request(pbench, isolate);
+      }
+      else if (!strcmp(pbench->test, (char *) "string")) {
+         rc = dbx_benchmark_string(pbench, isolate);
+      }
+      else {
+         T_SPRINTF(pbench->error, _dbxso(pbench->error), "Unknown benchmark: '%s'", pbench->test);
+         rc = CACHE_FAILURE;
+      }
+
+      if (rc != CACHE_SUCCESS) {
+         isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, pbench->error, 1)));
+         dbx_free((void *) pbench, 0);
+         return;
+      }
+
+      bresult = DBX_OBJECT_NEW();
+      key = dbx_new_string8(isolate, (char *) "test", 0);
+      DBX_SET(bresult, key, dbx_new_string8(isolate, pbench->test, 0));
+      for (n = 0; n < pbench->no_results; n ++) {
+         key = dbx_new_string8(isolate, pbench->name[n], 0);
+         DBX_SET(bresult, key, DBX_NUMBER_NEW(pbench->value[n]));
+      }
+      dbx_free((void *) pbench, 0);
+      args.GetReturnValue().Set(bresult);
+      return;
+   }
+
    dbx_write_char8(isolate, DBX_TO_STRING(args[0]), ibuffer, sizeof(ibuffer), 1);
 
    strcpy(obuffer, "output string");
@@ -3624,6 +4391,203 @@ void DBX_DBNAME::Benchmark(const FunctionCallbackInfo<Value>& args)
 }
 
 
+/* v2.5.35 */
+void DBX_DBNAME::MemoryStats(const FunctionCallbackInfo<Value>& args)
+{
+   DBXMETHCACHE cache;
+   Local<String> key;
+   Local<Object> result;
+   DBX_DBNAME *c = ObjectWrap::Unwrap<DBX_DBNAME>(args.This());
+   DBX_GET_ICONTEXT;
+   c->dbx_count ++;
+
+   dbx_enter_critical_section((void *) &dbx_meth_mutex);
+   cache = dbx_meth_cache;
+   dbx_leave_critical_section((void *) &dbx_meth_mutex);
+
+   result = DBX_OBJECT_NEW();
+
+   key = dbx_new_string8(isolate, (char *) "requests_in_use", 0);
+   DBX_SET(result, key, DBX_INTEGER_NEW(cache.in_use));
+   key = dbx_new_string8(isolate, (char *) "requests_cached", 0);
+   DBX_SET(result, key, DBX_INTEGER_NEW(cache.no_free));
+   key = dbx_new_string8(isolate, (char *) "high_water_mark", 0);
+   DBX_SET(result, key, DBX_INTEGER_NEW(cache.hwm > cache.peak ? cache.hwm : cache.peak));
+   key = dbx_new_string8(isolate, (char *) "allocations", 0);
+   DBX_SET(result, key, DBX_NUMBER_NEW((double) cache.allocs));
+   key = dbx_new_string8(isolate, (char *) "reuses", 0);
+   DBX_SET(result, key, DBX_NUMBER_NEW((double) cache.reuses));
+   key = dbx_new_string8(isolate, (char *) "releases", 0);
+   DBX_SET(result, key, DBX_NUMBER_NEW((double) cache.releases));
+   key = dbx_new_string8(isolate, (char *) "frees", 0);
+   DBX_SET(result, key, DBX_NUMBER_NEW((double) cache.frees));
+   key = dbx_new_string8(isolate, (char *) "buffer_trims", 0);
+   DBX_SET(result, key, DBX_NUMBER_NEW((double) cache.buffer_trims));
+   key = dbx_new_string8(isolate, (char *) "buffers_detached", 0);
+   DBX_SET(result, key, DBX_NUMBER_NEW((double) cache.buffers_detached));
+   key = dbx_new_string8(isolate, (char *) "output_buffers_cached", 0);
+   DBX_SET(result, key, DBX_INTEGER_NEW(cache.no_obuffer_free));
+   key = dbx_new_string8(isolate, (char *) "output_buffer_reuses", 0);
+   DBX_SET(result, key, DBX_NUMBER_NEW((double) cache.obuffer_reuses));
+
+   args.GetReturnValue().Set(result);
+}
+
+
+/* v2.5.35 */
+void DBX_DBNAME::PoolStats(const FunctionCallbackInfo<Value>& args)
+{
+   Local<String> key;
+   Local<Object> result;
+   DBX_DBNAME *c = ObjectWrap::Unwrap<DBX_DBNAME>(args.This());
+   DBX_GET_ICONTEXT;
+   c->dbx_count ++;
+
+   result = DBX_OBJECT_NEW();
+
+#if !defined(_WIN32)
+   DBXTASKQ *pq = &dbx_task_queue;
+   unsigned long enqueue_pos, dequeue_pos;
+
+   enqueue_pos = DBX_ATOMIC_LOAD_RELAXED(&(pq->enqueue_pos));
+   dequeue_pos = DBX_ATOMIC_LOAD_RELAXED(&(pq->dequeue_pos));
+
+   key = dbx_new_string8(isolate, (char *) "queue_size", 0);
+   DBX_SET(result, key, DBX_INTEGER_NEW(DBX_TASK_QUEUE_SIZE));
+   key = dbx_new_string8(isolate, (char *) "queue_depth", 0);
+   DBX_SET(result, key, DBX_NUMBER_NEW((double) (enqueue_pos >= dequeue_pos ? enqueue_pos - dequeue_pos : 0)));
+   key = dbx_new_string8(isolate, (char *) "max_depth", 0);
+   DBX_SET(result, key, DBX_NUMBER_NEW((double) DBX_ATOMIC_LOAD_RELAXED(&(pq->max_depth))));
+   key = dbx_new_string8(isolate, (char *) "enqueued", 0);
+   DBX_SET(result, key, DBX_NUMBER_NEW((double) DBX_ATOMIC_LOAD_RELAXED(&(pq->enqueued))));
+   key = dbx_new_string8(isolate, (char *) "dequeued", 0);
+   DBX_SET(result, key, DBX_NUMBER_NEW((double) DBX_ATOMIC_LOAD_RELAXED(&(pq->dequeued))));
+   key = dbx_new_string8(isolate, (char *) "enqueue_retries", 0);
+   DBX_SET(result, key, DBX_NUMBER_NEW((double) DBX_ATOMIC_LOAD_RELAXED(&(pq->enqueue_retries))));
+   key = dbx_new_string8(isolate, (char *) "dequeue_retries", 0);
+   DBX_SET(result, key, DBX_NUMBER_NEW((double) DBX_ATOMIC_LOAD_RELAXED(&(pq->dequeue_retries))));
+   key = dbx_new_string8(isolate, (char *) "queue_full", 0);
+   DBX_SET(result, key, DBX_NUMBER_NEW((double) DBX_ATOMIC_LOAD_RELAXED(&(pq->queue_full))));
+   key = dbx_new_string8(isolate, (char *) "idle_threads", 0);
+   DBX_SET(result, key, DBX_INTEGER_NEW(DBX_ATOMIC_LOAD_RELAXED(&(pq->idle_threads))));
+   key = dbx_new_string8(isolate, (char *) "parks", 0);
+   DBX_SET(result, key, DBX_NUMBER_NEW((double) DBX_ATOMIC_LOAD_RELAXED(&(pq->parks))));
+   key = dbx_new_string8(isolate, (char *) "wakeups", 0);
+   DBX_SET(result, key, DBX_NUMBER_NEW((double) DBX_ATOMIC_LOAD_RELAXED(&(pq->wakeups))));
+   key = dbx_new_string8(isolate, (char *) "completions", 0);
+   DBX_SET(result, key, DBX_NUMBER_NEW((double) DBX_ATOMIC_LOAD_RELAXED(&(pq->completions))));
+   key = dbx_new_string8(isolate, (char *) "completion_waits", 0);
+   DBX_SET(result, key, DBX_NUMBER_NEW((double) DBX_ATOMIC_LOAD_RELAXED(&(pq->completion_waits))));
+   key = dbx_new_string8(isolate, (char *) "completion_wakeups", 0);
+   DBX_SET(result, key, DBX_NUMBER_NEW((double) DBX_ATOMIC_LOAD_RELAXED(&(pq->completion_wakeups))));
+
+   key = dbx_new_string8(isolate, (char *) "threads", 0);
+   DBX_SET(result, key, DBX_INTEGER_NEW(DBX_ATOMIC_LOAD_RELAXED(&(dbx_pool.threads))));
+   key = dbx_new_string8(isolate, (char *) "min_threads", 0);
+   DBX_SET(result, key, DBX_INTEGER_NEW(dbx_pool.min_threads));
+   key = dbx_new_string8(isolate, (char *) "max_threads", 0);
+   DBX_SET(result, key, DBX_INTEGER_NEW(dbx_pool.max_threads));
+   key = dbx_new_string8(isolate, (char *) "threads_created", 0);
+   DBX_SET(result, key, DBX_NUMBER_NEW((double) dbx_pool.created));
+   key = dbx_new_string8(isolate, (char *) "threads_retired", 0);
+   DBX_SET(result, key, DBX_NUMBER_NEW((double) dbx_pool.retired));
+   key = dbx_new_string8(isolate, (char *) "stack_size", 0);
+   DBX_SET(result, key, DBX_NUMBER_NEW((double) dbx_pool.stack_size));
+   key = dbx_new_string8(isolate, (char *) "idle_timeout", 0);
+   DBX_SET(result, key, DBX_INTEGER_NEW(dbx_pool.idle_timeout));
+
+   {
+      int n, tn;
+      DBXTID *ptid;
+      Local<Object> obj;
+      Local<Array> a = DBX_ARRAY_NEW(0);
+
+      key = dbx_new_string8(isolate, (char *) "thread_stats", 0);
+      DBX_SET(result, key, a);
+
+      for (n = 0, tn = 0; n < DBX_THREADPOOL_LIMIT; n ++) {
+         ptid = dbx_pool.ptid[n];
+         if (!ptid || !DBX_ATOMIC_LOAD(&(ptid->state))) {
+            continue;
+         }
+         obj = DBX_OBJECT_NEW();
+         DBX_SET(a, tn ++, obj);
+         key = dbx_new_string8(isolate, (char *) "thread_id", 0);
+         DBX_SET(obj, key, DBX_INTEGER_NEW(ptid->thread_id));
+         key = dbx_new_string8(isolate, (char *) "cpu", 0);
+         DBX_SET(obj, key, DBX_INTEGER_NEW(ptid->cpu));
+         key = dbx_new_string8(isolate, (char *) "tasks", 0);
+         DBX_SET(obj, key, DBX_NUMBER_NEW((double) DBX_ATOMIC_LOAD_RELAXED(&(ptid->tasks))));
+         key = dbx_new_string8(isolate, (char *) "parks", 0);
+         DBX_SET(obj, key, DBX_NUMBER_NEW((double) DBX_ATOMIC_LOAD_RELAXED(&(ptid->parks))));
+         key = dbx_new_string8(isolate, (char *) "busy_ms", 0);
+         DBX_SET(obj, key, DBX_NUMBER_NEW((double) DBX_ATOMIC_LOAD_RELAXED(&(ptid->busy_ns)) / 1000000.0));
+      }
+   }
+
+   if (c->pcon && c->pcon->p_async) {
+      DBXASYNC *pasync = (DBXASYNC *) c->pcon->p_async;
+
+      key = dbx_new_string8(isolate, (char *) "async_pending", 0);
+      DBX_SET(result, key, DBX_INTEGER_NEW(pasync->pending));
+      key = dbx_new_string8(isolate, (char *) "async_batches", 0);
+      DBX_SET(result, key, DBX_NUMBER_NEW((double) pasync->batches));
+      key = dbx_new_string8(isolate, (char *) "async_completions", 0);
+      DBX_SET(result, key, DBX_NUMBER_NEW((double) pasync->completions));
+      key = dbx_new_string8(isolate, (char *) "async_overflows", 0);
+      DBX_SET(result, key, DBX_NUMBER_NEW((double) pasync->overflows));
+   }
+
+   if (c->pcon && c->pcon->p_netpool) {
+      DBXNETPOOL *ppool = c->pcon->p_netpool;
+
+      key = dbx_new_string8(isolate, (char *) "connection_sessions", 0);
+      DBX_SET(result, key, DBX_INTEGER_NEW(ppool->no_sessions));
+      key = dbx_new_string8(isolate, (char *) "connection_idle", 0);
+      DBX_SET(result, key, DBX_INTEGER_NEW(ppool->no_idle));
+      key = dbx_new_string8(isolate, (char *) "connection_max", 0);
+      DBX_SET(result, key, DBX_INTEGER_NEW(ppool->max));
+      key = dbx_new_string8(isolate, (char *) "connection_acquired", 0);
+      DBX_SET(result, key, DBX_NUMBER_NEW((double) ppool->acquired));
+      key = dbx_new_string8(isolate, (char *) "connection_waits", 0);
+      DBX_SET(result, key, DBX_NUMBER_NEW((double) ppool->waits));
+      key = dbx_new_string8(isolate, (char *) "connection_connects", 0);
+      DBX_SET(result, key, DBX_NUMBER_NEW((double) ppool->connects));
+      key = dbx_new_string8(isolate, (char *) "connection_reconnects", 0);
+      DBX_SET(result, key, DBX_NUMBER_NEW((double) ppool->reconnects));
+      key = dbx_new_string8(isolate, (char *) "connection_failures", 0);
+      DBX_SET(result, key, DBX_NUMBER_NEW((double) ppool->failures));
+   }
+
+   if (c->pcon && c->pcon->p_netuv) {
+      DBXNETUV *pnetuv = (DBXNETUV *) c->pcon->p_netuv;
+
+      key = dbx_new_string8(isolate, (char *) "net_async_pending", 0);
+      DBX_SET(result, key, DBX_INTEGER_NEW(pnetuv->pending));
+      key = dbx_new_string8(isolate, (char *) "net_async_max_pending", 0);
+      DBX_SET(result, key, DBX_INTEGER_NEW(pnetuv->pending_max));
+      key = dbx_new_string8(isolate, (char *) "net_async_sent", 0);
+      DBX_SET(result, key, DBX_NUMBER_NEW((double) pnetuv->sent));
+      key = dbx_new_string8(isolate, (char *) "net_async_received", 0);
+      DBX_SET(result, key, DBX_NUMBER_NEW((double) pnetuv->received));
+      key = dbx_new_string8(isolate, (char *) "net_async_reads", 0);
+      DBX_SET(result, key, DBX_NUMBER_NEW((double) pnetuv->reads));
+   }
+
+   if (c->pcon && c->pcon->net_pipeline) {
+      key = dbx_new_string8(isolate, (char *) "pipeline_depth", 0);
+      DBX_SET(result, key, DBX_INTEGER_NEW(c->pcon->pipe_depth));
+      key = dbx_new_string8(isolate, (char *) "pipeline_max_depth", 0);
+      DBX_SET(result, key, DBX_INTEGER_NEW(c->pcon->pipe_depth_max));
+      key = dbx_new_string8(isolate, (char *) "pipeline_turns", 0);
+      DBX_SET(result, key, DBX_NUMBER_NEW((double) c->pcon->pipe_turns));
+   }
+#endif
+
+   args.GetReturnValue().Set(result);
+}
+
+
 #if DBX_NODE_VERSION >= 120000
 class dbxAddonData
 {
@@ -3688,6 +4652,8 @@ static void init (Handle<Object> exports)
    mglobal::Init(exports);
    mcursor::Init(exports);
    mclass::Init(exports);
+   mbulk::Init(exports); /* v2.5.35 */
+   mfunction::Init(exports);
 }
 
 #if DBX_NODE_VERSION >= 120000
@@ -3744,12 +4710,12 @@ DBXMETH * dbx_request_memory(DBXCON *pcon, short allow_char16, short context)
    }
 
    pmeth = NULL;
-   if (context) {
+   if (context == 1) {
       pmeth = (DBXMETH *) pcon->pmeth_base;
    }
    else {
-      if (pcon->use_mutex) {
-         pmeth = dbx_request_memory_alloc(pcon, alloc_char16, 0);
+      if (pcon->use_mutex || context == 2) { /* v2.5.35 context 2: held across calls (mbulk) */
+         pmeth = dbx_request_memory_get(pcon, alloc_char16); /* v2.5.35 */
       }
       else {
          pmeth = (DBXMETH *) pcon->pmeth_base;
@@ -3760,13 +4726,19 @@ DBXMETH * dbx_request_memory(DBXCON *pcon, short allow_char16, short context)
    pmeth->binary = 0;
    pmeth->lock = 0;
    pmeth->increment = 0;
+   pmeth->typed = 0; /* v2.5.35 */
    pmeth->done = 0;
-   for (n = 0; n < DBX_MAXARGS; n ++) {
+   pmeth->p_async = NULL; /* v2.5.35 */
+   pmeth->pfref = NULL;
+   pmeth->net_command = 0; /* v2.5.35 */
+   /* v2.5.35 only the slots dirtied by the previous request need resetting */
+   for (n = 0; n < pmeth->args_hwm; n ++) {
       pmeth->args[n].cvalue.pstr = NULL;
       /* v2.1.20 */
       pmeth->args[n].sort = DBX_DSORT_DATA;
       pmeth->args[n].type = DBX_DTYPE_STR;
    }
+   pmeth->args_hwm = 0;
 
    /* v2.2.21 */
    pcon->error[0] = '\0';
@@ -3778,7 +4750,7 @@ DBXMETH * dbx_request_memory(DBXCON *pcon, short allow_char16, short context)
 
 DBXMETH * dbx_request_memory_alloc(DBXCON *pcon, short alloc_char16, short context)
 {
-   int ibuffer_size, obuffer_size;
+   int n, ibuffer_size, obuffer_size;
    int ibuffer16_size, obuffer16_size;
    DBXMETH *pmeth;
 
@@ -3804,6 +4776,14 @@ DBXMETH * dbx_request_memory_alloc(DBXCON *pcon, short alloc_char16, short conte
       return NULL;
    }
    memset((void *) pmeth, 0, sizeof(DBXMETH));
+   dbx_completion_init(&(pmeth->completion)); /* v2.5.35 */
+   dbx_completion_init(&(pmeth->pipe_turn));
+   pmeth->alloc_char16 = alloc_char16;
+   for (n = 0; n < DBX_MAXARGS; n ++) {
+      pmeth->args[n].sort = DBX_DSORT_DATA;
+      pmeth->args[n].type = DBX_DTYPE_STR;
+   }
+   pmeth->args_hwm = 0;
    pmeth->output_val.svalue.buf_addr = NULL;
    pmeth->output_val.cvalue.buf16_addr = NULL;
    pmeth->ibuffer = NULL;
@@ -3862,6 +4842,8 @@ dbx_request_memory_alloc_error:
    if (pmeth->ibuffer16)
       dbx_free((void *) pmeth->ibuffer16, 0);
 
+   dbx_completion_destroy(&(pmeth->completion)); /* v2.5.35 */
+   dbx_completion_destroy(&(pmeth->pipe_turn));
    dbx_free((void *) pmeth, 0);
 
    return NULL;
@@ -3873,59 +4855,436 @@ int dbx_request_memory_free(DBXCON *pcon, DBXMETH *pmeth, short context)
    if (!pmeth) {
       return CACHE_SUCCESS;
    }
+   if (pmeth->pbatch) { /* v2.5.35 */
+      dbx_batch_free(pmeth->pbatch);
+      pmeth->pbatch = NULL;
+   }
+   if (pmeth->no_arg_store) {
+      dbx_arg_store_release(pmeth);
+   }
    if (pmeth != (DBXMETH *) pcon->pmeth_base) {
-      if (pmeth->ibuffer) {
-         pmeth->ibuffer -= DBX_IBUFFER_OFFSET;
-         dbx_free((void *) pmeth->ibuffer, 0);
-      }
-      if (pmeth->output_val.svalue.buf_addr) {
-         dbx_free((void *) pmeth->output_val.svalue.buf_addr, 0);
-      }
-
-      if (pmeth->ibuffer16) {
-         pmeth->ibuffer16 -= DBX_IBUFFER_OFFSET;
-         dbx_free((void *) pmeth->ibuffer16, 0);
-      }
-      if (pmeth->output_val.cvalue.buf16_addr) {
-         dbx_free((void *) pmeth->output_val.cvalue.buf16_addr, 0);
-      }
-
-      dbx_free((void *) pmeth, 0);
+      dbx_request_memory_release(pmeth); /* v2.5.35 */
    }
    return CACHE_SUCCESS;
 }
 
 
-#if DBX_NODE_VERSION >= 100000
-void dbx_set_prototype_method(v8::Local<v8::FunctionTemplate> t, v8::FunctionCallback callback, const char* name, const char* data)
-#else
-void dbx_set_prototype_method(v8::Handle<v8::FunctionTemplate> t, v8::FunctionCallback callback, const char* name, const char* data)
-#endif
+/* v2.5.35 Take a request object from the cache, allocating a new one only if the cache is empty */
+DBXMETH * dbx_request_memory_get(DBXCON *pcon, short alloc_char16)
 {
-#if DBX_NODE_VERSION >= 100000
+   int n;
+   DBXMETH *pmeth;
 
-   v8::Isolate* isolate = v8::Isolate::GetCurrent();
-   v8::HandleScope handle_scope(isolate);
-   v8::Local<v8::Signature> s = v8::Signature::New(isolate, t);
+   n = alloc_char16 ? 1 : 0;
 
-#if DBX_NODE_VERSION >= 120000
-   v8::Local<v8::String> data_str = v8::String::NewFromUtf8(isolate, data, NewStringType::kNormal).ToLocalChecked();
-#else
-   v8::Local<v8::String> data_str = v8::String::NewFromUtf8(isolate, data);
-#endif
+   dbx_enter_critical_section((void *) &dbx_meth_mutex);
+   pmeth = dbx_meth_cache.free[n];
+   if (pmeth) {
+      dbx_meth_cache.free[n] = pmeth->p_free_next;
+      dbx_meth_cache.no_free --;
+      dbx_meth_cache.reuses ++;
+   }
+   dbx_meth_cache.in_use ++;
+   if (dbx_meth_cache.in_use > dbx_meth_cache.peak) {
+      dbx_meth_cache.peak = dbx_meth_cache.in_use;
+   }
+   dbx_leave_critical_section((void *) &dbx_meth_mutex);
 
-#if 0
-   v8::Local<v8::FunctionTemplate> tx = v8::FunctionTemplate::New(isolate, callback, v8::Local<v8::Value>(), s);
-#else
-   v8::Local<v8::FunctionTemplate> tx = v8::FunctionTemplate::New(isolate, callback, data_str, s);
-#endif
+   if (!pmeth) {
+      pmeth = dbx_request_memory_alloc(pcon, alloc_char16, 0);
+      dbx_enter_critical_section((void *) &dbx_meth_mutex);
+      if (pmeth) {
+         dbx_meth_cache.allocs ++;
+      }
+      else {
+         dbx_meth_cache.in_use --;
+      }
+      dbx_leave_critical_section((void *) &dbx_meth_mutex);
+      return pmeth;
+   }
 
-#if DBX_NODE_VERSION >= 120000
-   v8::Local<v8::String> fn_name = String::NewFromUtf8(isolate, name, NewStringType::kNormal).ToLocalChecked();;
+   /* clear what the previous request left behind */
+   pmeth->p_free_next = NULL;
+   pmeth->argc = 0;
+   pmeth->cargc = 0;
+   pmeth->ibuffer_used = 0;
+   pmeth->ibuffer16_used = 0;
+   pmeth->output_val.svalue.len_used = 0;
+   pmeth->output_val.cvalue.len_used = 0;
+   pmeth->psql = NULL;
+   pmeth->p_dbxfun = NULL;
+   pmeth->pfun = NULL;
+   pmeth->completion.word = 0;
 
-#else
-   v8::Local<v8::String> fn_name = String::NewFromUtf8(isolate, name);
-#endif
+   return pmeth;
+}
+
+
+/* v2.5.35 Return a request object to the cache.  The cache holds no more objects than the
+   peak number of concurrent requests seen over the current and previous trim intervals */
+int dbx_request_memory_release(DBXMETH *pmeth)
+{
+   int n, limit;
+   DBXMETH *pfree, *pnext;
+
+   pfree = NULL;
+   n = pmeth->alloc_char16 ? 1 : 0;
+
+   if (pmeth->ibuffer_size > CACHE_MAXSTRLEN || pmeth->output_val.svalue.len_alloc > CACHE_MAXSTRLEN || pmeth->ibuffer16_size > CACHE_MAXSTRLEN || pmeth->output_val.cvalue.len_alloc > CACHE_MAXSTRLEN) {
+      /* buffers grown for an oversize value are not kept */
+      pfree = pmeth;
+      pmeth->p_free_next = NULL;
+      pmeth = NULL;
+   }
+
+   dbx_enter_critical_section((void *) &dbx_meth_mutex);
+
+   dbx_meth_cache.in_use --;
+   dbx_meth_cache.releases ++;
+   if (pfree) {
+      dbx_meth_cache.buffer_trims ++;
+   }
+
+   limit = dbx_meth_cache.hwm > dbx_meth_cache.peak ? dbx_meth_cache.hwm : dbx_meth_cache.peak;
+   if (limit > DBX_METH_CACHE_MAX) {
+      limit = DBX_METH_CACHE_MAX;
+   }
+
+   if (pmeth) {
+      if (dbx_meth_cache.no_free < limit) {
+         pmeth->p_free_next = dbx_meth_cache.free[n];
+         dbx_meth_cache.free[n] = pmeth;
+         dbx_meth_cache.no_free ++;
+      }
+      else {
+         pmeth->p_free_next = pfree;
+         pfree = pmeth;
+      }
+   }
+
+   if ((dbx_meth_cache.releases % DBX_METH_TRIM_INTERVAL) == 0) {
+      dbx_meth_cache.hwm = dbx_meth_cache.peak;
+      dbx_meth_cache.peak = dbx_meth_cache.in_use;
+      limit = dbx_meth_cache.hwm > dbx_meth_cache.peak ? dbx_meth_cache.hwm : dbx_meth_cache.peak;
+      while (dbx_meth_cache.no_free > limit) {
+         n = dbx_meth_cache.free[0] ? 0 : 1;
+         pmeth = dbx_meth_cache.free[n];
+         dbx_meth_cache.free[n] = pmeth->p_free_next;
+         dbx_meth_cache.no_free --;
+         pmeth->p_free_next = pfree;
+         pfree = pmeth;
+      }
+   }
+
+   dbx_leave_critical_section((void *) &dbx_meth_mutex);
+
+   while (pfree) {
+      pnext = pfree->p_free_next;
+      dbx_request_memory_destroy(pfree);
+      dbx_enter_critical_section((void *) &dbx_meth_mutex);
+      dbx_meth_cache.frees ++;
+      dbx_leave_critical_section((void *) &dbx_meth_mutex);
+      pfree = pnext;
+   }
+
+   return CACHE_SUCCESS;
+}
+
+
+int dbx_request_memory_destroy(DBXMETH *pmeth)
+{
+   if (pmeth->ibuffer) {
+      pmeth->ibuffer -= DBX_IBUFFER_OFFSET;
+      dbx_free((void *) pmeth->ibuffer, 0);
+   }
+   if (pmeth->output_val.svalue.buf_addr) {
+      dbx_free((void *) pmeth->output_val.svalue.buf_addr, 0);
+   }
+
+   if (pmeth->ibuffer16) {
+      pmeth->ibuffer16 -= DBX_IBUFFER_OFFSET;
+      dbx_free((void *) pmeth->ibuffer16, 0);
+   }
+   if (pmeth->output_val.cvalue.buf16_addr) {
+      dbx_free((void *) pmeth->output_val.cvalue.buf16_addr, 0);
+   }
+
+   dbx_completion_destroy(&(pmeth->completion)); /* v2.5.35 */
+   dbx_completion_destroy(&(pmeth->pipe_turn));
+   dbx_free((void *) pmeth, 0);
+
+   return CACHE_SUCCESS;
+}
+
+
+/* v2.5.35 Take a standard size output buffer from the cache to replace one handed over to a Buffer object */
+char * dbx_obuffer_get(void)
+{
+   char *p;
+
+   p = NULL;
+   dbx_enter_critical_section((void *) &dbx_meth_mutex);
+   if (dbx_meth_cache.no_obuffer_free > 0) {
+      p = dbx_meth_cache.obuffer_free[-- dbx_meth_cache.no_obuffer_free];
+      dbx_meth_cache.obuffer_reuses ++;
+   }
+   dbx_leave_critical_section((void *) &dbx_meth_mutex);
+
+   if (!p) {
+      p = (char *) dbx_malloc(CACHE_MAXSTRLEN, 0);
+   }
+   return p;
+}
+
+
+/* v2.5.35 Finalizer for Buffer objects that own a detached output buffer: 'hint' carries the allocated size */
+void dbx_obuffer_release(char *data, void *hint)
+{
+   if ((size_t) hint == CACHE_MAXSTRLEN) {
+      dbx_enter_critical_section((void *) &dbx_meth_mutex);
+      if (dbx_meth_cache.no_obuffer_free < DBX_OBUFFER_CACHE_MAX) {
+         dbx_meth_cache.obuffer_free[dbx_meth_cache.no_obuffer_free ++] = data;
+         data = NULL;
+      }
+      dbx_leave_critical_section((void *) &dbx_meth_mutex);
+   }
+   if (data) {
+      dbx_free((void *) data, 0);
+   }
+   return;
+}
+
+
+#if DBX_NODE_VERSION >= 140000
+/* v2.5.35 Deleter for detached output buffers: called by V8 (possibly on a background thread) once the ArrayBuffer is collected */
+void dbx_obuffer_delete(void *data, size_t length, void *deleter_data)
+{
+   dbx_obuffer_release((char *) data, deleter_data);
+   return;
+}
+#endif
+
+
+/* v2.5.35 Return the request's output as a Buffer object */
+/* Values of at least 'buffer_zero_copy' Bytes are not copied: the output buffer itself becomes the Buffer's backing store and the request takes a fresh one */
+v8::Local<v8::Object> dbx_new_buffer(v8::Isolate * isolate, DBXMETH *pmeth)
+{
+   size_t len, size;
+   char *data, *p;
+
+   len = (size_t) pmeth->output_val.svalue.len_used;
+
+   if (pmeth->pcon->buffer_zero_copy > 0 && len >= (size_t) pmeth->pcon->buffer_zero_copy) {
+      p = dbx_obuffer_get();
+      if (p) {
+         data = pmeth->output_val.svalue.buf_addr;
+         size = (size_t) pmeth->output_val.svalue.len_alloc;
+         pmeth->output_val.svalue.buf_addr = p;
+         pmeth->output_val.svalue.len_alloc = CACHE_MAXSTRLEN;
+         pmeth->output_val.svalue.len_used = 0;
+
+         dbx_enter_critical_section((void *) &dbx_meth_mutex);
+         dbx_meth_cache.buffers_detached ++;
+         dbx_leave_critical_section((void *) &dbx_meth_mutex);
+
+#if DBX_NODE_VERSION >= 140000
+         /* node::Buffer::New(..., callback, hint) defers the callback to the event loop, so buffers returned to a synchronous loop are not freed until it ends */
+         std::shared_ptr<v8::BackingStore> store = v8::ArrayBuffer::NewBackingStore((void *) data, len, dbx_obuffer_delete, (void *) size);
+         return node::Buffer::New(isolate, v8::ArrayBuffer::New(isolate, std::move(store)), 0, len).ToLocalChecked();
+#else
+         return node::Buffer::New(isolate, data, len, dbx_obuffer_release, (void *) size).ToLocalChecked();
+#endif
+      }
+   }
+
+   /* node::Buffer::New(isolate, data, len) would take ownership of memory that the request still owns */
+   return node::Buffer::Copy(isolate, (char *) pmeth->output_val.svalue.buf_addr, len).ToLocalChecked();
+}
+
+/* v2.5.35 Batched requests */
+DBXBATCH * dbx_batch_alloc(int command, int no_items, int min_args)
+{
+   DBXBATCH *pbatch;
+
+   pbatch = (DBXBATCH *) dbx_malloc(sizeof(DBXBATCH), 0);
+   if (!pbatch) {
+      return NULL;
+   }
+   memset((void *) pbatch, 0, sizeof(DBXBATCH));
+   pbatch->command = command;
+   pbatch->no_alloc = no_items;
+   pbatch->min_args = min_args;
+
+   pbatch->items = (DBXBITEM *) dbx_malloc(sizeof(DBXBITEM) * (no_items + 1), 0);
+   /* the results buffer starts small (most batches return little or no data): dbx_batch_add_result() grows it */
+   pbatch->obuffer = (char *) dbx_malloc(sizeof(char) * DBX_BATCH_OBUFFER_SIZE, 0);
+   if (!pbatch->items || !pbatch->obuffer) {
+      dbx_batch_free(pbatch);
+      return NULL;
+   }
+   pbatch->obuffer_size = DBX_BATCH_OBUFFER_SIZE;
+   pbatch->obuffer_used = 0;
+
+   return pbatch;
+}
+
+
+int dbx_batch_reset(DBXBATCH *pbatch)
+{
+   pbatch->no_items = 0;
+   pbatch->no_errors = 0;
+   pbatch->obuffer_used = 0;
+   pbatch->error[0] = '\0';
+
+   return CACHE_SUCCESS;
+}
+
+
+int dbx_batch_free(DBXBATCH *pbatch)
+{
+   if (!pbatch) {
+      return CACHE_SUCCESS;
+   }
+   if (pbatch->items) {
+      dbx_free((void *) pbatch->items, 0);
+   }
+   if (pbatch->obuffer) {
+      dbx_free((void *) pbatch->obuffer, 0);
+   }
+   if (pbatch->nbuffer) {
+      dbx_free((void *) pbatch->nbuffer, 0);
+   }
+   dbx_free((void *) pbatch, 0);
+
+   return CACHE_SUCCESS;
+}
+
+
+/* Operations that may be mixed in a batch (db.batch()) and the minimum number of arguments that each takes */
+int dbx_batch_command(char *name, int *min_args)
+{
+   *min_args = 1;
+   if (!strcmp(name, "set")) {
+      *min_args = 2;
+      return DBX_CMND_GSET;
+   }
+   else if (!strcmp(name, "get")) {
+      return DBX_CMND_GGET;
+   }
+   else if (!strcmp(name, "delete") || !strcmp(name, "kill")) {
+      return DBX_CMND_GDELETE;
+   }
+   else if (!strcmp(name, "defined") || !strcmp(name, "data")) {
+      return DBX_CMND_GDEFINED;
+   }
+   else if (!strcmp(name, "increment")) {
+      *min_args = 2;
+      return DBX_CMND_GINCREMENT;
+   }
+   return 0;
+}
+
+
+int dbx_batch_add_result(DBXBATCH *pbatch, int item, char *data, int len, int rc, char *error)
+{
+   unsigned int size;
+   char *p;
+   DBXBITEM *pitem;
+
+   if (item < 0 || item >= pbatch->no_items) {
+      return CACHE_FAILURE;
+   }
+   pitem = &(pbatch->items[item]);
+
+   if (rc != CACHE_SUCCESS) {
+      if (pbatch->no_errors == 0 && error) {
+         T_STRCPY(pbatch->error, _dbxso(pbatch->error), error);
+      }
+      pbatch->no_errors ++;
+      len = 0;
+   }
+
+   if (len < 0) {
+      len = 0;
+   }
+   if ((pbatch->obuffer_used + len) > pbatch->obuffer_size) {
+      size = (pbatch->obuffer_used + len) * 2;
+      p = (char *) dbx_malloc(sizeof(char) * size, 0);
+      if (!p) {
+         return CACHE_FAILURE;
+      }
+      memcpy((void *) p, (void *) pbatch->obuffer, (size_t) pbatch->obuffer_used);
+      dbx_free((void *) pbatch->obuffer, 0);
+      pbatch->obuffer = p;
+      pbatch->obuffer_size = size;
+   }
+   if (len > 0) {
+      memcpy((void *) (pbatch->obuffer + pbatch->obuffer_used), (void *) data, (size_t) len);
+   }
+   pitem->rc = rc;
+   pitem->ooffset = pbatch->obuffer_used;
+   pitem->olen = len;
+   pbatch->obuffer_used += len;
+
+   return CACHE_SUCCESS;
+}
+
+
+/* Values retrieved (an array) or the number of records successfully set */
+v8::Local<v8::Value> dbx_batch_result(v8::Isolate *isolate, DBXCON *pcon, DBXBATCH *pbatch)
+{
+   int n;
+   DBXBITEM *pitem;
+#if DBX_NODE_VERSION >= 100000
+   Local<Context> icontext = isolate->GetCurrentContext();
+#endif
+
+   if (pbatch->command == DBX_CMND_GSET) {
+      return DBX_INTEGER_NEW(pbatch->no_items - pbatch->no_errors);
+   }
+
+   Local<Array> result = DBX_ARRAY_NEW(pbatch->no_items);
+
+   for (n = 0; n < pbatch->no_items; n ++) {
+      pitem = &(pbatch->items[n]);
+      DBX_SET(result, n, dbx_new_string8n(isolate, pbatch->obuffer + pitem->ooffset, pitem->olen, pcon->utf8));
+   }
+
+   return result;
+}
+
+
+
+#if DBX_NODE_VERSION >= 100000
+void dbx_set_prototype_method(v8::Local<v8::FunctionTemplate> t, v8::FunctionCallback callback, const char* name, const char* data)
+#else
+void dbx_set_prototype_method(v8::Handle<v8::FunctionTemplate> t, v8::FunctionCallback callback, const char* name, const char* data)
+#endif
+{
+#if DBX_NODE_VERSION >= 100000
+
+   v8::Isolate* isolate = v8::Isolate::GetCurrent();
+   v8::HandleScope handle_scope(isolate);
+   v8::Local<v8::Signature> s = v8::Signature::New(isolate, t);
+
+#if DBX_NODE_VERSION >= 120000
+   v8::Local<v8::String> data_str = v8::String::NewFromUtf8(isolate, data, NewStringType::kNormal).ToLocalChecked();
+#else
+   v8::Local<v8::String> data_str = v8::String::NewFromUtf8(isolate, data);
+#endif
+
+#if 0
+   v8::Local<v8::FunctionTemplate> tx = v8::FunctionTemplate::New(isolate, callback, v8::Local<v8::Value>(), s);
+#else
+   v8::Local<v8::FunctionTemplate> tx = v8::FunctionTemplate::New(isolate, callback, data_str, s);
+#endif
+
+#if DBX_NODE_VERSION >= 120000
+   v8::Local<v8::String> fn_name = String::NewFromUtf8(isolate, name, NewStringType::kNormal).ToLocalChecked();;
+
+#else
+   v8::Local<v8::String> fn_name = String::NewFromUtf8(isolate, name);
+#endif
 
    tx->SetClassName(fn_name);
    t->PrototypeTemplate()->Set(fn_name, tx);
@@ -3986,11 +5345,12 @@ v8::Local<v8::String> dbx_new_string8(v8::Isolate * isolate, char * buffer, int
 #endif
    }
    else {
+      /* v2.5.35 only short strings (property names, keys) are internalized: longer strings would be hashed in full for nothing */
 #if DBX_NODE_VERSION >= 100000
-      return v8::String::NewFromOneByte(isolate, (uint8_t *) buffer, NewStringType::kInternalized).ToLocalChecked();
+      return v8::String::NewFromOneByte(isolate, (uint8_t *) buffer, (strlen(buffer) <= DBX_STRING_INTERN_MAX) ? NewStringType::kInternalized : NewStringType::kNormal).ToLocalChecked();
 #else
       /* return String::NewFromOneByte(isolate, (uint8_t *) buffer, String::kNormalString); */
-      return v8::String::NewFromOneByte(isolate, (uint8_t *) buffer, v8::NewStringType::kInternalized).ToLocalChecked();
+      return v8::String::NewFromOneByte(isolate, (uint8_t *) buffer, (strlen(buffer) <= DBX_STRING_INTERN_MAX) ? v8::NewStringType::kInternalized : v8::NewStringType::kNormal).ToLocalChecked();
 #endif
    }
 }
@@ -4016,78 +5376,235 @@ v8::Local<v8::String> dbx_new_string8n(v8::Isolate * isolate, char * buffer, uns
 #endif
    }
    else {
+      /* v2.5.35 only short strings (property names, keys) are internalized */
 #if DBX_NODE_VERSION >= 100000
-      return v8::String::NewFromOneByte(isolate, (uint8_t *) buffer, NewStringType::kInternalized, len).ToLocalChecked();
+      return v8::String::NewFromOneByte(isolate, (uint8_t *) buffer, (len <= DBX_STRING_INTERN_MAX) ? NewStringType::kInternalized : NewStringType::kNormal, len).ToLocalChecked();
 #else
       /* return v8::String::NewFromOneByte(isolate, (uint8_t *) buffer, String::kNormalString, len); */
-      return v8::String::NewFromOneByte(isolate, (uint8_t *) buffer, v8::NewStringType::kInternalized, len).ToLocalChecked();
+      return v8::String::NewFromOneByte(isolate, (uint8_t *) buffer, (len <= DBX_STRING_INTERN_MAX) ? v8::NewStringType::kInternalized : v8::NewStringType::kNormal, len).ToLocalChecked();
 #endif
    }
 }
 
 
-v8::Local<v8::String> dbx_new_string16n(v8::Isolate * isolate, unsigned short * buffer, unsigned long len)
+/* v2.5.35 Return the request's (8-bit) output as a string: values are never internalized */
+/* Values of at least 'string_external' Bytes are not copied if they can be held as one-byte characters (that is, for UTF-8 connections,
+   if they are pure ASCII): the output buffer itself becomes the contents of an external string (freed when the string is garbage collected)
+   and the request takes a fresh one */
+v8::Local<v8::String> dbx_new_string8v(v8::Isolate * isolate, DBXMETH *pmeth, int utf8)
 {
+   size_t len;
+
+   len = (size_t) pmeth->output_val.svalue.len_used;
+
+#if DBX_NODE_VERSION >= 100000
+   if (pmeth->pcon->string_external > 0 && len >= (size_t) pmeth->pcon->string_external && (!utf8 || dbx_is_ascii(pmeth->output_val.svalue.buf_addr, len))) {
+      char *data, *p;
+      size_t size;
+
+      p = dbx_obuffer_get();
+      if (p) {
+         data = pmeth->output_val.svalue.buf_addr;
+         size = (size_t) pmeth->output_val.svalue.len_alloc;
+         pmeth->output_val.svalue.buf_addr = p;
+         pmeth->output_val.svalue.len_alloc = CACHE_MAXSTRLEN;
+         pmeth->output_val.svalue.len_used = 0;
+
+         dbx_enter_critical_section((void *) &dbx_meth_mutex);
+         dbx_meth_cache.buffers_detached ++;
+         dbx_leave_critical_section((void *) &dbx_meth_mutex);
+
+         return v8::String::NewExternalOneByte(isolate, new DBXEXTSTR(data, len, size)).ToLocalChecked();
+      }
+   }
+#endif
+
+   if (utf8) {
 #if DBX_NODE_VERSION >= 120000
-   return v8::String::NewFromTwoByte(isolate, (const uint16_t *) buffer, NewStringType::kNormal, len).ToLocalChecked();
+      return v8::String::NewFromUtf8(isolate, pmeth->output_val.svalue.buf_addr, NewStringType::kNormal, (int) len).ToLocalChecked();
 #else
-   return String::NewFromTwoByte(isolate, (const uint16_t *) buffer, String::kNormalString, len);
+      return v8::String::NewFromUtf8(isolate, pmeth->output_val.svalue.buf_addr, String::kNormalString, (int) len);
 #endif
+   }
+   return v8::String::NewFromOneByte(isolate, (uint8_t *) pmeth->output_val.svalue.buf_addr, v8::NewStringType::kNormal, (int) len).ToLocalChecked();
 }
 
-/* v2.4.30 */
-int dbx_write_char8(v8::Isolate * isolate, v8::Local<v8::String> str, char * buffer, int buffer_size, int utf8)
+
+/* v2.5.35 Check (eight bytes at a time) that a buffer holds only 7-bit characters */
+int dbx_is_ascii(char * buffer, size_t len)
 {
-   if (utf8) {
-      return DBX_WRITE_UTF8(str, buffer, buffer_size);
+   size_t n;
+   unsigned long long w;
+
+   for (n = 0; (n + 8) <= len; n += 8) {
+      memcpy((void *) &w, (void *) (buffer + n), 8);
+      if (DBX_SWAR_HIGH(w)) {
+         return 0;
+      }
    }
-   else {
-#if DBX_NODE_VERSION >= 240000
-      DBX_WRITE_ONE_BYTE(str, (uint8_t *) buffer);
-      return 0;
-#else
-      return DBX_WRITE_ONE_BYTE(str, (uint8_t *) buffer);
-#endif
+   for (; n < len; n ++) {
+      if (buffer[n] & 0x80) {
+         return 0;
+      }
    }
+   return 1;
 }
 
 
-int dbx_write_char16(v8::Isolate * isolate, v8::Local<v8::String> str, unsigned short * buffer)
+/* v2.5.35 Test whether a number is an integer small enough to be held exactly as a double (typed mode: pushed as a 64-bit integer) */
+int dbx_number_int64(double d, long long *pi64)
 {
-#if DBX_NODE_VERSION >= 240000
-   DBX_WRITE(str, buffer);
-   return 0;
-#else
-   return DBX_WRITE(str, buffer);
-#endif
+   if (d != d || d > (double) DBX_MAX_SAFE_INTEGER || d < (double) -DBX_MAX_SAFE_INTEGER) {
+      return 0;
+   }
+   *pi64 = (long long) d;
+   return ((double) *pi64 == d) ? 1 : 0;
 }
 
 
-int dbx_ibuffer_add(DBXMETH *pmeth, v8::Isolate * isolate, int argn, v8::Local<v8::String> str, void * pbuffer, int buffer_len, short char16, short context)
+/* v2.5.35 Return a numeric result (typed mode) as a Number, or as a BigInt if it is an integer beyond the range that a Number holds exactly */
+v8::Local<v8::Value> dbx_new_number(v8::Isolate * isolate, DBXMETH *pmeth)
 {
-   int len, n, type;
-   char *buffer;
-   unsigned short *buffer16;
-   unsigned char *p, *phead;
-   char *p1, *p2;
-   DBXCON *pcon = pmeth->pcon;
-
-#ifdef _WIN32
-__try {
-#endif
+   int len;
+   long long i64;
+   double d;
+   char *p, *pend;
+   char buffer[64];
 
-   if (pmeth->pcon->utf16 && context != 10) {
-      return dbx_ibuffer16_add(pmeth, isolate, argn, str, pbuffer, buffer_len, char16, context);
+   if (!pmeth->pcon->net_connection && pmeth->output_val.type == DBX_DTYPE_INT) {
+      return DBX_INTEGER_NEW(pmeth->output_val.num.int32);
    }
 
-   if (pbuffer)
-      len = buffer_len;
-   else
-      len = dbx_string8_length(isolate, str, pcon->utf8);
-
-   /* 1.4.11 resize input buffer if necessary */
+   if (pmeth->pcon->utf16) {
+      len = (int) pmeth->output_val.cvalue.len_used;
+      if (len > 0 && len < 64) {
+         dbx_char16_to_char8((unsigned char *) buffer, pmeth->output_val.cvalue.buf16_addr, (unsigned int) len);
+      }
+   }
+   else {
+      len = (int) pmeth->output_val.svalue.len_used;
+      if (len > 0 && len < 64) {
+         memcpy((void *) buffer, (void *) pmeth->output_val.svalue.buf_addr, (size_t) len);
+      }
+   }
+   if (len < 1 || len > 63) {
+      goto dbx_new_number_string;
+   }
+   buffer[len] = '\0';
+   p = buffer;
 
-   if ((pmeth->ibuffer_used + len + 32) > pmeth->ibuffer_size) {
+   if (pmeth->output_val.type == DBX_DTYPE_DOUBLE) {
+      d = strtod(p, &pend);
+   }
+   else {
+      if (!pmeth->pcon->net_connection && pmeth->output_val.type == DBX_DTYPE_INT64) {
+         i64 = pmeth->output_val.num.int64;
+         pend = p + len;
+      }
+      else {
+         errno = 0;
+         i64 = strtoll(p, &pend, 10);
+         if (errno == ERANGE) {
+            pend = p;
+         }
+      }
+      if (i64 > DBX_MAX_SAFE_INTEGER || i64 < -DBX_MAX_SAFE_INTEGER) {
+#if DBX_NODE_VERSION >= 120000
+         if (pend == (p + len)) {
+            return v8::BigInt::New(isolate, (int64_t) i64);
+         }
+#endif
+         goto dbx_new_number_string;
+      }
+      d = (double) i64;
+   }
+   if (pend != (p + len)) {
+      goto dbx_new_number_string;
+   }
+   return DBX_NUMBER_NEW(d);
+
+dbx_new_number_string:
+
+   if (pmeth->pcon->utf16) {
+      return dbx_new_string16n(isolate, pmeth->output_val.cvalue.buf16_addr, pmeth->output_val.cvalue.len_used);
+   }
+   return dbx_new_string8v(isolate, pmeth, pmeth->pcon->utf8);
+}
+
+
+/* v2.5.35 An output buffer handed over to an external string is released (or returned to the cache) when the string is collected */
+DBXEXTSTR::~DBXEXTSTR()
+{
+   dbx_obuffer_release(data_addr, (void *) data_size);
+}
+
+
+v8::Local<v8::String> dbx_new_string16n(v8::Isolate * isolate, unsigned short * buffer, unsigned long len)
+{
+#if DBX_NODE_VERSION >= 120000
+   return v8::String::NewFromTwoByte(isolate, (const uint16_t *) buffer, NewStringType::kNormal, len).ToLocalChecked();
+#else
+   return String::NewFromTwoByte(isolate, (const uint16_t *) buffer, String::kNormalString, len);
+#endif
+}
+
+/* v2.4.30 */
+int dbx_write_char8(v8::Isolate * isolate, v8::Local<v8::String> str, char * buffer, int buffer_size, int utf8)
+{
+   if (utf8) {
+      return DBX_WRITE_UTF8(str, buffer, buffer_size);
+   }
+   else {
+#if DBX_NODE_VERSION >= 240000
+      DBX_WRITE_ONE_BYTE(str, (uint8_t *) buffer);
+      return 0;
+#else
+      return DBX_WRITE_ONE_BYTE(str, (uint8_t *) buffer);
+#endif
+   }
+}
+
+
+int dbx_write_char16(v8::Isolate * isolate, v8::Local<v8::String> str, unsigned short * buffer)
+{
+#if DBX_NODE_VERSION >= 240000
+   DBX_WRITE(str, buffer);
+   return 0;
+#else
+   return DBX_WRITE(str, buffer);
+#endif
+}
+
+
+int dbx_ibuffer_add(DBXMETH *pmeth, v8::Isolate * isolate, int argn, v8::Local<v8::String> str, void * pbuffer, int buffer_len, short char16, short context)
+{
+   int len, n, type;
+   char *buffer;
+   unsigned short *buffer16;
+   unsigned char *p, *phead;
+   char *p1, *p2;
+   DBXCON *pcon = pmeth->pcon;
+
+#ifdef _WIN32
+__try {
+#endif
+
+   if (argn >= pmeth->args_hwm) { /* v2.5.35 */
+      pmeth->args_hwm = argn + 1;
+   }
+
+   if (pmeth->pcon->utf16 && context != 10) {
+      return dbx_ibuffer16_add(pmeth, isolate, argn, str, pbuffer, buffer_len, char16, context);
+   }
+
+   if (pbuffer)
+      len = buffer_len;
+   else
+      len = dbx_string8_length(isolate, str, pcon->utf8);
+
+   /* 1.4.11 resize input buffer if necessary */
+
+   if ((pmeth->ibuffer_used + len + 32) > pmeth->ibuffer_size) {
       p = (unsigned char *) dbx_malloc(sizeof(char) * (pmeth->ibuffer_used + len + CACHE_MAXSTRLEN + DBX_IBUFFER_OFFSET), 301);
       if (p) {
          p1 = (char *) (pmeth->ibuffer - DBX_IBUFFER_OFFSET);
@@ -4099,11 +5616,14 @@ __try {
          pmeth->ibuffer_size = (pmeth->ibuffer_used + len + CACHE_MAXSTRLEN);
 
          /* v2.2.22 reset pointers */
+         /* v2.5.35 but not those referring to Buffer arguments used in place */
          for (n = 0; n < pmeth->argc; n ++) {
-            pmeth->args[n].svalue.buf_addr = (p2 + (pmeth->args[n].svalue.buf_addr - p1));
+            if (pmeth->args[n].svalue.buf_addr >= p1 && pmeth->args[n].svalue.buf_addr < p1 + pmeth->ibuffer_used + DBX_IBUFFER_OFFSET)
+               pmeth->args[n].svalue.buf_addr = (p2 + (pmeth->args[n].svalue.buf_addr - p1));
          }
          for (n = 0; n < pmeth->argc; n ++) {
-            pmeth->yargs[n].buf_addr = (p2 + (pmeth->yargs[n].buf_addr - p1));
+            if (pmeth->yargs[n].buf_addr >= p1 && pmeth->yargs[n].buf_addr < p1 + pmeth->ibuffer_used + DBX_IBUFFER_OFFSET)
+               pmeth->yargs[n].buf_addr = (p2 + (pmeth->yargs[n].buf_addr - p1));
          }
 /*
          {
@@ -4128,9 +5648,7 @@ __try {
    if (pbuffer) {
       if (char16) {
          buffer16 = (unsigned short *) pbuffer;
-         for (n = 0; n < len; n ++) {
-            p[n] = (unsigned char) buffer16[n];
-         }
+         dbx_char16_to_char8(p, buffer16, (unsigned int) len); /* v2.5.35 */
       }
       else {
          buffer = (char *) pbuffer;
@@ -4200,6 +5718,61 @@ __except (EXCEPTION_EXECUTE_HANDLER) {
 }
 
 
+/* v2.5.35 Add a Buffer (or TypedArray) argument */
+/* In API mode, arguments of at least 'buffer_zero_copy' Bytes are not copied: the DB API is given a pointer into the ArrayBuffer's
+   backing store and the request holds a reference to the store (which outlives the JavaScript object) until it is freed */
+int dbx_ibuffer_add_buffer(DBXMETH *pmeth, v8::Isolate * isolate, int argn, v8::Local<v8::Object> obj, short context)
+{
+   int len;
+   char *p;
+   v8::Local<v8::String> str;
+   DBXCON *pcon = pmeth->pcon;
+
+   p = node::Buffer::Data(obj);
+   len = (int) node::Buffer::Length(obj);
+
+#if DBX_NODE_VERSION >= 140000
+   if (pcon->buffer_zero_copy > 0 && len >= pcon->buffer_zero_copy && argn > 0 && !pcon->net_connection && !pcon->utf16 && pmeth->no_arg_store < DBX_ARGSTORE_MAX && obj->IsArrayBufferView()) {
+      v8::Local<v8::ArrayBufferView> view = v8::Local<v8::ArrayBufferView>::Cast(obj);
+      pmeth->arg_store[pmeth->no_arg_store ++] = (void *) new std::shared_ptr<v8::BackingStore>(view->Buffer()->GetBackingStore());
+
+      if (argn >= pmeth->args_hwm) {
+         pmeth->args_hwm = argn + 1;
+      }
+      pmeth->args[argn].type = DBX_DTYPE_STR;
+      pmeth->args[argn].svalue.buf_addr = p;
+      pmeth->args[argn].svalue.len_alloc = len;
+      pmeth->args[argn].svalue.len_used = len;
+      pmeth->args[argn].csize = pmeth->ibuffer_used;
+      if (pcon->dbtype == DBX_DBTYPE_YOTTADB) {
+         pmeth->yargs[argn - 1].len_used = len;
+         pmeth->yargs[argn - 1].len_alloc = len;
+         pmeth->yargs[argn - 1].buf_addr = p;
+      }
+      return len;
+   }
+#endif
+
+   return dbx_ibuffer_add(pmeth, isolate, argn, str, (void *) p, len, 0, context);
+}
+
+
+/* v2.5.35 Drop the request's references to the backing stores of Buffer arguments */
+int dbx_arg_store_release(DBXMETH *pmeth)
+{
+#if DBX_NODE_VERSION >= 140000
+   int n;
+
+   for (n = 0; n < pmeth->no_arg_store; n ++) {
+      delete (std::shared_ptr<v8::BackingStore> *) pmeth->arg_store[n];
+   }
+#endif
+   pmeth->no_arg_store = 0;
+
+   return CACHE_SUCCESS;
+}
+
+
 int dbx_ibuffer16_add(DBXMETH *pmeth, v8::Isolate * isolate, int argn, v8::Local<v8::String> str, void * pbuffer, int buffer_len, short char16, short context)
 {
    int len, n;
@@ -4213,6 +5786,10 @@ int dbx_ibuffer16_add(DBXMETH *pmeth, v8::Isolate * isolate, int argn, v8::Local
 __try {
 #endif
 
+   if (argn >= pmeth->args_hwm) { /* v2.5.35 */
+      pmeth->args_hwm = argn + 1;
+   }
+
    if (pbuffer)
       len = buffer_len;
    else
@@ -4251,9 +5828,7 @@ __try {
       }
       else {
          buffer = (char *) pbuffer;
-         for (n = 0; n < len; n ++) {
-            p[n] = (unsigned short) buffer[n];
-         }
+         dbx_char8_to_char16(p, (unsigned char *) buffer, (unsigned int) len); /* v2.5.35 */
       }
    }
    else {
@@ -4314,6 +5889,93 @@ __except (EXCEPTION_EXECUTE_HANDLER) {
 }
 
 
+/* v2.5.35 Keep a copy of the input buffer segment holding the global name and the first 'argc' arguments (the fixed keys) */
+int dbx_gprefix_save(DBXMETH *pmeth, DBXGPREFIX **pprefix, int argc)
+{
+   int n;
+   DBXGPREFIX *pgp;
+   DBXCON *pcon = pmeth->pcon;
+
+   dbx_gprefix_free(pprefix);
+
+   if (pcon->utf16 || argc < 1 || argc >= DBX_MAXARGS) {
+      return CACHE_FAILURE;
+   }
+
+   pgp = (DBXGPREFIX *) dbx_malloc(sizeof(DBXGPREFIX) + (sizeof(DBXGPARG) * argc) + pmeth->ibuffer_used, 0);
+   if (!pgp) {
+      return CACHE_FAILURE;
+   }
+   pgp->argc = argc;
+   pgp->dbtype = pcon->dbtype;
+   pgp->net_connection = pcon->net_connection;
+   pgp->lock = pmeth->lock;
+   pgp->len = pmeth->ibuffer_used;
+   pgp->args = (DBXGPARG *) (((char *) pgp) + sizeof(DBXGPREFIX));
+   pgp->buffer = ((unsigned char *) pgp->args) + (sizeof(DBXGPARG) * argc);
+   memcpy((void *) pgp->buffer, (void *) pmeth->ibuffer, (size_t) pgp->len);
+
+   for (n = 0; n < argc; n ++) {
+      pgp->args[n].type = pmeth->args[n].type;
+      pgp->args[n].sort = pmeth->args[n].sort;
+      pgp->args[n].int64 = pmeth->args[n].num.int64;
+      pgp->args[n].offs = (unsigned int) ((unsigned char *) pmeth->args[n].svalue.buf_addr - pmeth->ibuffer);
+      pgp->args[n].len_used = pmeth->args[n].svalue.len_used;
+      pgp->args[n].len_alloc = pmeth->args[n].svalue.len_alloc;
+      pgp->args[n].csize = pmeth->args[n].csize;
+   }
+
+   *pprefix = pgp;
+   return CACHE_SUCCESS;
+}
+
+
+/* v2.5.35 Copy a saved global name and fixed keys into the request.  Returns the number of arguments restored (0 if the copy can't be used) */
+int dbx_gprefix_restore(DBXMETH *pmeth, DBXGPREFIX *pprefix)
+{
+   int n;
+   DBXCON *pcon = pmeth->pcon;
+
+   if (!pprefix || pcon->utf16 || pprefix->dbtype != pcon->dbtype || pprefix->net_connection != pcon->net_connection || pprefix->lock != pmeth->lock || (pprefix->len + 32) > pmeth->ibuffer_size) {
+      return 0;
+   }
+
+   memcpy((void *) pmeth->ibuffer, (void *) pprefix->buffer, (size_t) pprefix->len);
+   pmeth->ibuffer_used = pprefix->len;
+
+   for (n = 0; n < pprefix->argc; n ++) {
+      pmeth->args[n].type = pprefix->args[n].type;
+      pmeth->args[n].sort = pprefix->args[n].sort;
+      pmeth->args[n].num.int64 = pprefix->args[n].int64;
+      pmeth->args[n].svalue.buf_addr = (char *) (pmeth->ibuffer + pprefix->args[n].offs);
+      pmeth->args[n].svalue.len_used = pprefix->args[n].len_used;
+      pmeth->args[n].svalue.len_alloc = pprefix->args[n].len_alloc;
+      pmeth->args[n].csize = pprefix->args[n].csize;
+      pmeth->args[n].cvalue.pstr = 0;
+      if (n > 0 && pcon->dbtype == DBX_DBTYPE_YOTTADB) {
+         pmeth->yargs[n - 1].buf_addr = pmeth->args[n].svalue.buf_addr;
+         pmeth->yargs[n - 1].len_used = pmeth->args[n].svalue.len_used;
+         pmeth->yargs[n - 1].len_alloc = pmeth->args[n].svalue.len_alloc;
+      }
+   }
+   if (pprefix->argc > pmeth->args_hwm) {
+      pmeth->args_hwm = pprefix->argc;
+   }
+
+   return pprefix->argc;
+}
+
+
+int dbx_gprefix_free(DBXGPREFIX **pprefix)
+{
+   if (*pprefix) {
+      dbx_free((void *) *pprefix, 0);
+      *pprefix = NULL;
+   }
+   return CACHE_SUCCESS;
+}
+
+
 int dbx_global_reset(const v8::FunctionCallbackInfo<v8::Value>& args, v8::Isolate * isolate, DBXCON *pcon, DBXMETH *pmeth, void *pgx, int argc_offset, short context)
 {
    v8::Local<v8::Context> icontext = isolate->GetCurrentContext();
@@ -4356,6 +6018,7 @@ __try {
       dbx_free((void *) pvalp, 0);
    }
    gx->pkey = NULL;
+   dbx_gprefix_free(&(gx->pprefix)); /* v2.5.35 */
 
    if (pcon->dbtype == DBX_DBTYPE_YOTTADB) {
       if (global_name[0] == '^') {
@@ -4402,6 +6065,7 @@ __try {
    for (n = (argc_offset + 1); n < pmeth->argc; n ++) {
       if (args[n]->IsInt32()) {
          pval = (DBXVAL *) dbx_malloc(sizeof(DBXVAL), 0);
+         pval->cvalue.buf16_addr = NULL; /* v2.5.35 */
          pval->type = DBX_DTYPE_INT;
          pval->num.int32 = (int) DBX_INT32_VALUE(args[n]);
       }
@@ -4411,6 +6075,7 @@ __try {
             p = node::Buffer::Data(obj);
             len = (int) node::Buffer::Length(obj);
             pval = (DBXVAL *) dbx_malloc(sizeof(DBXVAL) + len + 32, 0);
+            pval->cvalue.buf16_addr = NULL; /* v2.5.35 */
             pval->type = DBX_DTYPE_STR;
             pval->svalue.buf_addr = ((char *) pval) + sizeof(DBXVAL);
             memcpy((void *) pval->svalue.buf_addr, (void *) p, (size_t) len);
@@ -4491,6 +6156,13 @@ int dbx_cursor_init(void *pcx)
    cx->data.buf_addr = NULL;
    cx->data.len_alloc = 0;
    cx->data.len_used = 0;
+   cx->prefetch = 0; /* v2.5.35 */
+   cx->prefetch_eod = 0;
+   cx->prefetch_pos = 0;
+   cx->prefetch_buf.buf_addr = NULL;
+   cx->prefetch_buf.len_alloc = 0;
+   cx->prefetch_buf.len_used = 0;
+   cx->batch_eod = 0;
    cx->psql = NULL;
    cx->c = NULL;
 
@@ -4701,6 +6373,9 @@ __try {
    cx->getdata = 0;
    cx->multilevel = 0;
    cx->format = 0;
+   cx->prefetch = 0; /* v2.5.35 */
+   dbx_prefetch_reset(cx);
+   cx->batch_eod = 0;
 
    if (pmeth->argc > (argc_offset + 1)) {
       obj = DBX_TO_OBJECT(args[argc_offset + 1]);
@@ -4716,6 +6391,13 @@ __try {
             cx->context = 2;
          }
       }
+      key = dbx_new_string8(isolate, (char *) "prefetch", 1); /* v2.5.35 */
+      if (DBX_GET(obj, key)->IsNumber()) {
+         cx->prefetch = (int) DBX_INT32_VALUE(DBX_GET(obj, key));
+         if (cx->prefetch > DBX_CURSOR_PREFETCH_MAX) {
+            cx->prefetch = DBX_CURSOR_PREFETCH_MAX;
+         }
+      }
       key = dbx_new_string8(isolate, (char *) "globaldirectory", 1);
       if (DBX_GET(obj, key)->IsBoolean()) {
          if (DBX_TO_BOOLEAN(DBX_GET(obj, key))->IsTrue()) {
@@ -4731,6 +6413,12 @@ __try {
          if (!strcmp(buffer, "url")) {
             cx->format = 1;
          }
+         else if (!strcmp(buffer, "json") && !pcon->utf16) { /* v2.5.35 */
+            cx->format = 2;
+         }
+         else if (!strcmp(buffer, "binary") && !pcon->utf16) {
+            cx->format = 3;
+         }
       }
    }
 
@@ -5783,7 +7471,7 @@ int isc_cleanup(DBXMETH *pmeth)
 __try {
 #endif
 
-   for (n = 0; n < DBX_MAXARGS; n ++) {
+   for (n = 0; n < pmeth->args_hwm; n ++) { /* v2.5.35 */
       if (pmeth->args[n].cvalue.pstr) {
          /* printf("\r\ncache_cleanup %d &zstr=%p; pstr=%p;", n, &(pcon->cargs[n].zstr), pcon->cargs[n].pstr); */
          pcon->p_isc_so->p_CacheExStrKill(&(pmeth->args[n].cvalue.zstr));
@@ -5849,9 +7537,7 @@ __try {
          sprintf((char *) value->svalue.buf_addr, "%d", value->num.oref);
          value->svalue.len_used = (int) strlen((char *) value->svalue.buf_addr);
          if (pcon->utf16) {
-            for (n = 0; n < value->svalue.len_used; n ++) {
-               value->cvalue.buf16_addr[n] = value->svalue.buf_addr[n];
-            }
+            dbx_char8_to_char16(value->cvalue.buf16_addr, (unsigned char *) value->svalue.buf_addr, value->svalue.len_used); /* v2.5.35 */
             value->cvalue.buf16_addr[value->svalue.len_used] = 0;
             value->cvalue.len_used = value->svalue.len_used;
          }
@@ -5863,14 +7549,28 @@ __try {
          sprintf(value->svalue.buf_addr, "%d", value->num.int32);
          value->svalue.len_used = (int) strlen(value->svalue.buf_addr);
          if (pcon->utf16) {
-            for (n = 0; n < value->svalue.len_used; n ++) {
-               value->cvalue.buf16_addr[n] = value->svalue.buf_addr[n];
-            }
+            dbx_char8_to_char16(value->cvalue.buf16_addr, (unsigned char *) value->svalue.buf_addr, value->svalue.len_used); /* v2.5.35 */
             value->cvalue.buf16_addr[value->svalue.len_used] = 0;
             value->cvalue.len_used = value->svalue.len_used;
          }
          return rc;
       }
+      else if (pmeth->typed && ctype == CACHE_INT8 && pcon->p_isc_so->p_CachePopInt64) { /* v2.5.35 */
+         rc = pcon->p_isc_so->p_CachePopInt64(&(value->num.int64));
+         value->type = DBX_DTYPE_INT64;
+         sprintf(value->svalue.buf_addr, "%lld", (long long) value->num.int64);
+         value->svalue.len_used = (int) strlen(value->svalue.buf_addr);
+         if (pcon->utf16) {
+            dbx_char8_to_char16(value->cvalue.buf16_addr, (unsigned char *) value->svalue.buf_addr, value->svalue.len_used);
+            value->cvalue.buf16_addr[value->svalue.len_used] = 0;
+            value->cvalue.len_used = value->svalue.len_used;
+         }
+         return rc;
+      }
+      else if (pmeth->typed && (ctype == CACHE_DOUBLE || ctype == CACHE_IEEE_DBL)) { /* v2.5.35 */
+         /* Popped as a string so that the canonical form of the number is preserved: the type is recorded for the caller */
+         value->type = DBX_DTYPE_DOUBLE;
+      }
    }
    else {
       ctype = CACHE_ASTRING;
@@ -6871,6 +8571,31 @@ int ydb_function_ex(DBXMETH *pmeth, DBXFUN *pfun)
    int rc;
    DBXCON *pcon = pmeth->pcon;
 
+   /* v2.5.35 prepared function (mfunction): the call-in table entry is looked up on the first call only and its handle kept */
+   if (pmeth->pfref && pcon->p_ydb_so->p_ydb_cip) {
+      ci_name_descriptor *pci = &(pmeth->pfref->ci);
+
+      switch (pfun->argc) {
+         case 1:
+            rc = pcon->p_ydb_so->p_ydb_cip(pci, &(pfun->out));
+            break;
+         case 2:
+            rc = pcon->p_ydb_so->p_ydb_cip(pci, &(pfun->out), &(pfun->in[1]));
+            break;
+         case 3:
+            rc = pcon->p_ydb_so->p_ydb_cip(pci, &(pfun->out), &(pfun->in[1]), &(pfun->in[2]));
+            break;
+         case 4:
+            rc = pcon->p_ydb_so->p_ydb_cip(pci, &(pfun->out), &(pfun->in[1]), &(pfun->in[2]), &(pfun->in[3]));
+            break;
+         default:
+            rc = CACHE_SUCCESS;
+            pfun->out.length = 0;
+            break;
+      }
+      return rc;
+   }
+
    switch (pfun->argc) {
       case 1:
          rc = pcon->p_ydb_so->p_ydb_ci(pfun->label, &(pfun->out));
@@ -6900,9 +8625,7 @@ int ydb_transaction_cb(void *pargs)
 #if defined(_WIN32)
    return 0;
 #else
-   int rc, init, context, trestart;
-   struct timespec   ts;
-   struct timeval    tp;
+   int rc, context, trestart;
    DBXTHRT *pthrt;
    DBXMETH *pmeth;
 
@@ -6924,19 +8647,11 @@ int ydb_transaction_cb(void *pargs)
    printf("\r\n*** ydb_transaction_cb tid=%lu; tlevel=%d; ...", (unsigned long) dbx_current_thread_id(), ydb_get_intsvar(pthrt->pmeth->pcon, "$tlevel"));
 */
 
-   init = 0;
-   pthread_mutex_lock(&(pthrt->req_cv_mutex));
+   /* v2.5.35 */
+   dbx_completion_signal(&(pthrt->res));
    while (1) {
-      if (init == 0) {
-         init ++;
-         pthrt->done = 1;
-         pthread_cond_broadcast(&(pthrt->res_cv));
-      }
-      gettimeofday(&tp, NULL);
-      ts.tv_sec  = tp.tv_sec;
-      ts.tv_nsec = tp.tv_usec * 1000;
-      ts.tv_sec += 3;
-      rc = pthread_cond_timedwait(&(pthrt->req_cv), &(pthrt->req_cv_mutex), &ts);
+      dbx_completion_wait_spin(&(pthrt->req), pthrt->spin, 3);
+      DBX_ATOMIC_STORE(&(pthrt->req.word), 0);
 
       pmeth = pthrt->pmeth;
 
@@ -6981,8 +8696,7 @@ int ydb_transaction_cb(void *pargs)
          else if (context == YDB_TPCTX_TLEVEL) {
             pmeth->output_val.num.int32 = ydb_get_intsvar(pmeth->pcon, (char *) "$tlevel");
          }
-         pthrt->done = 1;
-         pthread_cond_broadcast(&(pthrt->res_cv));
+         dbx_completion_signal(&(pthrt->res));
 
          if (context == YDB_TPCTX_COMMIT) {
             rc = YDB_OK;
@@ -6994,7 +8708,6 @@ int ydb_transaction_cb(void *pargs)
          }
       }
    }
-   pthread_mutex_unlock(&(pthrt->req_cv_mutex));
 /*
    printf("\r\n*** ydb_transaction_cb EXIT tid=%lu ...", (unsigned long) dbx_current_thread_id());
 */
@@ -7043,18 +8756,15 @@ int ydb_transaction(DBXMETH *pmeth)
    DBXTHRT *pthrt;
    pthread_attr_t attr;
    size_t stacksize, newstacksize;
-   struct timespec   ts;
-   struct timeval    tp;
 
    pthrt = (DBXTHRT *) dbx_malloc(sizeof(DBXTHRT), 0);
    pthrt->pmeth = pmeth;
    pthrt->context = 0;
-   pthrt->done = 0;
+   /* v2.5.35 spinning only pays when the two threads can run at the same time */
+   pthrt->spin = (sysconf(_SC_NPROCESSORS_ONLN) > 1) ? DBX_TP_SPIN : 0;
 
-   pthread_mutex_init(&(pthrt->req_cv_mutex), NULL);
-   pthread_cond_init(&(pthrt->req_cv), NULL);
-   pthread_mutex_init(&(pthrt->res_cv_mutex), NULL);
-   pthread_cond_init(&(pthrt->res_cv), NULL);
+   dbx_completion_init(&(pthrt->req));
+   dbx_completion_init(&(pthrt->res));
 
    dbx_enter_critical_section((void *) &dbx_async_mutex);
    pmeth->pcon->tlevel ++;
@@ -7077,15 +8787,7 @@ int ydb_transaction(DBXMETH *pmeth)
       printf("failed to create thread, errno = %d\n",errno);
    }
 
-   pthread_mutex_lock(&(pthrt->res_cv_mutex));
-   while (!pthrt->done) {
-      gettimeofday(&tp, NULL);
-      ts.tv_sec  = tp.tv_sec;
-      ts.tv_nsec = tp.tv_usec * 1000;
-      ts.tv_sec += 3;
-      pthread_cond_timedwait(&(pthrt->res_cv), &(pthrt->res_cv_mutex), &ts);
-   }
-   pthread_mutex_unlock(&(pthrt->res_cv_mutex));
+   dbx_completion_wait(&(pthrt->res), 3);
 
    return YDB_OK;
 
@@ -7100,29 +8802,16 @@ int ydb_transaction_task(DBXMETH *pmeth, int context)
 #else
    int rc;
    DBXTHRT *pthrt;
-   struct timespec   ts;
-   struct timeval    tp;
 
    rc = YDB_OK;
    pthrt = (DBXTHRT *) pmeth->pcon->pthrt[pmeth->pcon->tlevel];
    pthrt->context = context;
    pthrt->pmeth = pmeth;
 
-   pthread_mutex_lock(&(pthrt->req_cv_mutex));
-   pthread_cond_signal(&(pthrt->req_cv));
-   pthread_mutex_unlock(&(pthrt->req_cv_mutex));
-
-   pthrt->done = 0;
-
-   pthread_mutex_lock(&(pthrt->res_cv_mutex));
-   while (!pthrt->done) {
-      gettimeofday(&tp, NULL);
-      ts.tv_sec  = tp.tv_sec;
-      ts.tv_nsec = tp.tv_usec * 1000;
-      ts.tv_sec += 3;
-      pthread_cond_timedwait(&(pthrt->res_cv), &(pthrt->res_cv_mutex), &ts);
-   }
-   pthread_mutex_unlock(&(pthrt->res_cv_mutex));
+   /* v2.5.35 the response word is re-armed before the request is posted so that a fast reply cannot be lost */
+   DBX_ATOMIC_STORE(&(pthrt->res.word), 0);
+   dbx_completion_signal(&(pthrt->req));
+   dbx_completion_wait_spin(&(pthrt->res), pthrt->spin, 3);
 
    if (context == YDB_TPCTX_COMMIT || context == YDB_TPCTX_ROLLBACK) {
       dbx_enter_critical_section((void *) &dbx_async_mutex);
@@ -7130,6 +8819,8 @@ int ydb_transaction_task(DBXMETH *pmeth, int context)
       pmeth->pcon->tlevel --;
       dbx_leave_critical_section((void *) &dbx_async_mutex);
       rc = pthread_join(pthrt->tp_tid, NULL);
+      dbx_completion_destroy(&(pthrt->req)); /* v2.5.35 */
+      dbx_completion_destroy(&(pthrt->res));
       dbx_free((void *) pthrt, 0);
    }
    return rc;
@@ -7221,6 +8912,19 @@ __try {
 
       dbx_pool_thread_init(pcon, 1);
 
+#if !defined(_WIN32)
+      /* v2.5.35 */
+      if (pcon->net_pool_size > 0 || pcon->net_pool_max > 0) {
+         rc = netx_pool_init(pcon);
+         if (rc != CACHE_SUCCESS) {
+            netx_tcp_disconnect(pcon, 0);
+            pcon->net_connection = 0;
+            rc = CACHE_NOCON;
+            goto dbx_open_exit;
+         }
+      }
+#endif
+
       pcon->net_connection = 1; /* network connection */
 
       goto dbx_open_exit;
@@ -7333,7 +9037,14 @@ __try {
    /* printf("\r\ndbx_close: no_connections=%d\r\n", no_connections); */
 
    if (pcon->net_connection) {
+#if !defined(_WIN32)
+      netx_pool_close(pcon); /* v2.5.35 */
+#endif
       netx_tcp_disconnect(pcon, 0);
+      if (pcon->recv_buf) { /* v2.5.35 */
+         dbx_free((void *) pcon->recv_buf, 0);
+         pcon->recv_buf = NULL;
+      }
       pcon->net_connection = 0;
    }
    else if (pcon->dbtype == DBX_DBTYPE_YOTTADB) {
@@ -7441,6 +9152,19 @@ __try {
       }
       strncpy(nspace, pmeth->output_val.svalue.buf_addr, pmeth->output_val.svalue.len_used);
       nspace[pmeth->output_val.svalue.len_used] = '\0';
+#if !defined(_WIN32)
+      /* v2.5.35 pooled sessions and the event loop transport reconnect to the new namespace when next used */
+      if (pmeth->argc > 0 && rc == CACHE_SUCCESS && (pcon->p_netpool || pcon->net_async)) {
+         strncpy(pcon->nspace, nspace, sizeof(pcon->nspace) - 1);
+         pcon->nspace[sizeof(pcon->nspace) - 1] = '\0';
+         DBX_ATOMIC_ADD(&(pcon->net_generation), 1);
+         if (pcon->p_netpool) {
+            pthread_mutex_lock(&(pcon->p_netpool->mutex));
+            pcon->p_netpool->generation ++;
+            pthread_mutex_unlock(&(pcon->p_netpool->mutex));
+         }
+      }
+#endif
    }
    else if (pcon->dbtype == DBX_DBTYPE_YOTTADB) {
       if (pmeth->argc > 0) {
@@ -7514,6 +9238,9 @@ __try {
    if (pmeth->args[n].type == DBX_DTYPE_INT) {
       rc = pcon->p_isc_so->p_CachePushInt((int) pmeth->args[n].num.int32);
    }
+   else if (pmeth->args[n].type == DBX_DTYPE_INT64 && pcon->p_isc_so->p_CachePushInt64) { /* v2.5.35 */
+      rc = pcon->p_isc_so->p_CachePushInt64((CACHE_INT64) pmeth->args[n].num.int64);
+   }
    else if (pmeth->args[n].type == DBX_DTYPE_DOUBLE) {
       rc = pcon->p_isc_so->p_CachePushDbl(pmeth->args[n].num.real);
       /* rc = pcon->p_isc_so->p_CachePushIEEEDbl(pmeth->args[n].num.real); */
@@ -7547,9 +9274,8 @@ __try {
          else {
             pmeth->args[n].cvalue.pstr = (void *) pcon->p_isc_so->p_CacheExStrNew((CACHE_EXSTRP) &(pmeth->args[n].cvalue.zstr), pmeth->args[n].svalue.len_used + 1);
             if (pmeth->args[n].cvalue.pstr) { /* v2.2.22 */
-               for (ne = 0; ne < pmeth->args[n].svalue.len_used; ne ++) {
-                  pmeth->args[n].cvalue.zstr.str.ch[ne] = (char) pmeth->args[n].svalue.buf_addr[ne];
-               }
+               ne = pmeth->args[n].svalue.len_used;
+               memcpy((void *) pmeth->args[n].cvalue.zstr.str.ch, (void *) pmeth->args[n].svalue.buf_addr, (size_t) ne); /* v2.5.35 */
                pmeth->args[n].cvalue.zstr.str.ch[ne] = (char) 0;
                pmeth->args[n].cvalue.zstr.len = pmeth->args[n].svalue.len_used;
 
@@ -7741,9 +9467,43 @@ __except (EXCEPTION_EXECUTE_HANDLER) {
 }
 
 
-int dbx_set(DBXMETH *pmeth)
+/* v2.5.35 Point the request's arguments at one reference held in the batch */
+int dbx_batch_reference(DBXMETH *pmeth, DBXBITEM *pitem)
 {
-   int rc;
+   int n, len, dsort, dtype;
+   unsigned char *p;
+
+   p = pmeth->ibuffer + pitem->offset;
+   for (n = 0; n < pitem->argc; n ++) {
+      len = (int) dbx_get_block_size(p, 0, &dsort, &dtype);
+      pmeth->args[n].svalue.buf_addr = (char *) (p + 5);
+      pmeth->args[n].svalue.len_used = len;
+      pmeth->args[n].svalue.len_alloc = len;
+      if (dtype == DBX_DTYPE_INT) {
+         pmeth->args[n].type = DBX_DTYPE_INT;
+         pmeth->args[n].num.int32 = (int) strtol(pmeth->args[n].svalue.buf_addr, NULL, 10);
+      }
+      else {
+         pmeth->args[n].type = DBX_DTYPE_STR;
+      }
+      if (n > 0) {
+         pmeth->yargs[n - 1].buf_addr = pmeth->args[n].svalue.buf_addr;
+         pmeth->yargs[n - 1].len_used = len;
+         pmeth->yargs[n - 1].len_alloc = len;
+      }
+      p += (5 + len);
+   }
+   pmeth->cargc = pitem->argc;
+
+   return CACHE_SUCCESS;
+}
+
+
+/* v2.5.35 Every reference in the batch under one lock (one pipelined exchange for network connections) */
+int dbx_getmany(DBXMETH *pmeth)
+{
+   int rc, i;
+   DBXBATCH *pbatch = pmeth->pbatch;
    DBXCON *pcon = pmeth->pcon;
 
 #ifdef _WIN32
@@ -7753,37 +9513,337 @@ __try {
    DBX_DB_LOCK(0);
 
    if (pcon->net_connection) {
-      rc = netx_tcp_command(pmeth, DBX_CMND_GSET, 0);
-      goto dbx_set_exit;
+      rc = netx_tcp_command_batch(pmeth, pbatch, 0);
+      goto dbx_getmany_exit;
    }
 
-   rc = dbx_global_reference(pmeth);
-   if (rc != CACHE_SUCCESS) {
-      dbx_error_message(pmeth, rc);
-      goto dbx_set_exit;
-   }
+   for (i = 0; i < pbatch->no_items; i ++) {
+      dbx_batch_reference(pmeth, &(pbatch->items[i]));
+      pmeth->output_val.svalue.len_used = 0;
 
-   if (pcon->dbtype == DBX_DBTYPE_YOTTADB) {
-      rc = pcon->p_ydb_so->p_ydb_set_s(&(pmeth->args[0].svalue), pmeth->cargc - 2, &pmeth->yargs[0], &(pmeth->args[pmeth->cargc - 1].svalue));
-   }
-   else {
-      rc = pcon->p_isc_so->p_CacheGlobalSet(pmeth->cargc - 2);
-      isc_cleanup(pmeth);
-   }
+      if (pcon->dbtype == DBX_DBTYPE_YOTTADB) {
+         rc = pcon->p_ydb_so->p_ydb_get_s(&(pmeth->args[0].svalue), pmeth->cargc - 1, &pmeth->yargs[0], &(pmeth->output_val.svalue));
+      }
+      else {
+         rc = dbx_global_reference(pmeth);
+         if (rc == CACHE_SUCCESS) {
+            rc = pcon->p_isc_so->p_CacheGlobalGet(pmeth->cargc - 1, 0);
+            if (rc == CACHE_SUCCESS) {
+               isc_pop_value(pmeth, &(pmeth->output_val), DBX_DTYPE_STR);
+            }
+         }
+         isc_cleanup(pmeth);
+      }
 
-   pcon->utf16 = 0;
-   if (rc == CACHE_SUCCESS) {
-      dbx_create_string(&(pmeth->output_val.svalue), (void *) &rc, DBX_DTYPE_INT);
-   }
-   else {
-      dbx_error_message(pmeth, rc);
+      if (rc == CACHE_ERUNDEF) {
+         pmeth->output_val.svalue.len_used = 0;
+         rc = CACHE_SUCCESS;
+      }
+      else if (rc != CACHE_SUCCESS) {
+         pcon->error[0] = '\0';
+         dbx_error_message(pmeth, rc);
+      }
+      dbx_batch_add_result(pbatch, i, pmeth->output_val.svalue.buf_addr, (int) pmeth->output_val.svalue.len_used, rc, pcon->error);
    }
 
-dbx_set_exit:
+   rc = CACHE_SUCCESS;
 
-   DBX_DB_UNLOCK();
+dbx_getmany_exit:
 
-   return rc;
+   if (pbatch->no_errors) {
+      T_STRCPY(pcon->error, _dbxso(pcon->error), pbatch->error);
+      if (rc == CACHE_SUCCESS) {
+         rc = CACHE_FAILURE;
+      }
+   }
+
+   DBX_DB_UNLOCK();
+
+   return rc;
+
+#ifdef _WIN32
+}
+__except (EXCEPTION_EXECUTE_HANDLER) {
+
+   DWORD code;
+   char bufferx[256];
+
+   __try {
+      code = GetExceptionCode();
+      sprintf_s(bufferx, 255, "Exception caught in f:dbx_getmany: %x", code);
+      dbx_log_event(pcon, bufferx, (char *) "Error Condition", 0);
+   }
+   __except (EXCEPTION_EXECUTE_HANDLER) {
+      ;
+   }
+
+   return 0;
+}
+#endif
+}
+
+
+/* v2.5.35 Every record in the batch under one lock (one pipelined exchange for network connections) */
+int dbx_setmany(DBXMETH *pmeth)
+{
+   int rc, i;
+   DBXBATCH *pbatch = pmeth->pbatch;
+   DBXCON *pcon = pmeth->pcon;
+
+#ifdef _WIN32
+__try {
+#endif
+
+   DBX_DB_LOCK(0);
+
+   if (pcon->net_connection) {
+      rc = netx_tcp_command_batch(pmeth, pbatch, 0);
+      goto dbx_setmany_exit;
+   }
+
+   for (i = 0; i < pbatch->no_items; i ++) {
+      dbx_batch_reference(pmeth, &(pbatch->items[i]));
+
+      if (pcon->dbtype == DBX_DBTYPE_YOTTADB) {
+         rc = pcon->p_ydb_so->p_ydb_set_s(&(pmeth->args[0].svalue), pmeth->cargc - 2, &pmeth->yargs[0], &(pmeth->args[pmeth->cargc - 1].svalue));
+      }
+      else {
+         rc = dbx_global_reference(pmeth);
+         if (rc == CACHE_SUCCESS) {
+            rc = pcon->p_isc_so->p_CacheGlobalSet(pmeth->cargc - 2);
+         }
+         isc_cleanup(pmeth);
+      }
+
+      if (rc != CACHE_SUCCESS) {
+         pcon->error[0] = '\0';
+         dbx_error_message(pmeth, rc);
+      }
+      dbx_batch_add_result(pbatch, i, NULL, 0, rc, pcon->error);
+   }
+
+   rc = CACHE_SUCCESS;
+
+dbx_setmany_exit:
+
+   if (pbatch->no_errors) {
+      T_STRCPY(pcon->error, _dbxso(pcon->error), pbatch->error);
+      if (rc == CACHE_SUCCESS) {
+         rc = CACHE_FAILURE;
+      }
+   }
+
+   DBX_DB_UNLOCK();
+
+   return rc;
+
+#ifdef _WIN32
+}
+__except (EXCEPTION_EXECUTE_HANDLER) {
+
+   DWORD code;
+   char bufferx[256];
+
+   __try {
+      code = GetExceptionCode();
+      sprintf_s(bufferx, 255, "Exception caught in f:dbx_setmany: %x", code);
+      dbx_log_event(pcon, bufferx, (char *) "Error Condition", 0);
+   }
+   __except (EXCEPTION_EXECUTE_HANDLER) {
+      ;
+   }
+
+   return 0;
+}
+#endif
+}
+
+
+/* v2.5.35 A mixed batch of global operations under one lock (one pipelined exchange for network connections) */
+int dbx_batch(DBXMETH *pmeth)
+{
+   int rc, i, n;
+   char buffer[32];
+   DBXBITEM *pitem;
+   DBXBATCH *pbatch = pmeth->pbatch;
+   DBXCON *pcon = pmeth->pcon;
+
+#ifdef _WIN32
+__try {
+#endif
+
+   DBX_DB_LOCK(0);
+
+   if (pcon->net_connection) {
+      rc = netx_tcp_command_batch(pmeth, pbatch, 0);
+      goto dbx_batch_exit;
+   }
+
+   for (i = 0; i < pbatch->no_items; i ++) {
+      pitem = &(pbatch->items[i]);
+      dbx_batch_reference(pmeth, pitem);
+      pmeth->output_val.svalue.len_used = 0;
+      pmeth->increment = (pitem->command == DBX_CMND_GINCREMENT) ? 1 : 0;
+      n = -1;
+
+      if (pcon->dbtype == DBX_DBTYPE_YOTTADB) {
+         switch (pitem->command) {
+            case DBX_CMND_GSET:
+               rc = pcon->p_ydb_so->p_ydb_set_s(&(pmeth->args[0].svalue), pmeth->cargc - 2, &pmeth->yargs[0], &(pmeth->args[pmeth->cargc - 1].svalue));
+               break;
+            case DBX_CMND_GGET:
+               rc = pcon->p_ydb_so->p_ydb_get_s(&(pmeth->args[0].svalue), pmeth->cargc - 1, &pmeth->yargs[0], &(pmeth->output_val.svalue));
+               break;
+            case DBX_CMND_GDELETE:
+               n = 0;
+               rc = pcon->p_ydb_so->p_ydb_delete_s(&(pmeth->args[0].svalue), pmeth->cargc - 1, &pmeth->yargs[0], YDB_DEL_TREE);
+               break;
+            case DBX_CMND_GDEFINED:
+               n = 0;
+               rc = pcon->p_ydb_so->p_ydb_data_s(&(pmeth->args[0].svalue), pmeth->cargc - 1, &pmeth->yargs[0], (unsigned int *) &n);
+               break;
+            default:
+               rc = pcon->p_ydb_so->p_ydb_incr_s(&(pmeth->args[0].svalue), pmeth->cargc - 2, &pmeth->yargs[0], &(pmeth->args[pmeth->cargc - 1].svalue), &(pmeth->output_val.svalue));
+               break;
+         }
+      }
+      else {
+         rc = dbx_global_reference(pmeth);
+         if (rc == CACHE_SUCCESS) {
+            switch (pitem->command) {
+               case DBX_CMND_GSET:
+                  rc = pcon->p_isc_so->p_CacheGlobalSet(pmeth->cargc - 2);
+                  break;
+               case DBX_CMND_GGET:
+                  rc = pcon->p_isc_so->p_CacheGlobalGet(pmeth->cargc - 1, 0);
+                  if (rc == CACHE_SUCCESS) {
+                     isc_pop_value(pmeth, &(pmeth->output_val), DBX_DTYPE_STR);
+                  }
+                  break;
+               case DBX_CMND_GDELETE:
+                  n = 0;
+                  rc = pcon->p_isc_so->p_CacheGlobalKill(pmeth->cargc - 1, 0);
+                  if (rc == CACHE_SUCCESS) {
+                     pcon->p_isc_so->p_CachePopInt(&n);
+                  }
+                  break;
+               case DBX_CMND_GDEFINED:
+                  n = 0;
+                  rc = pcon->p_isc_so->p_CacheGlobalData(pmeth->cargc - 1, 0);
+                  if (rc == CACHE_SUCCESS) {
+                     pcon->p_isc_so->p_CachePopInt(&n);
+                  }
+                  break;
+               default:
+                  rc = pcon->p_isc_so->p_CacheGlobalIncrement(pmeth->cargc - 2);
+                  if (rc == CACHE_SUCCESS) {
+                     isc_pop_value(pmeth, &(pmeth->output_val), DBX_DTYPE_STR);
+                  }
+                  break;
+            }
+         }
+         isc_cleanup(pmeth);
+      }
+
+      if (rc == CACHE_ERUNDEF && pitem->command == DBX_CMND_GGET) {
+         pmeth->output_val.svalue.len_used = 0;
+         rc = CACHE_SUCCESS;
+      }
+      else if (rc != CACHE_SUCCESS) {
+         pcon->error[0] = '\0';
+         dbx_error_message(pmeth, rc);
+      }
+
+      if (rc == CACHE_SUCCESS && n >= 0) {
+         T_SPRINTF(buffer, _dbxso(buffer), "%d", n);
+         dbx_batch_add_result(pbatch, i, buffer, (int) strlen(buffer), rc, pcon->error);
+      }
+      else {
+         dbx_batch_add_result(pbatch, i, pmeth->output_val.svalue.buf_addr, (int) pmeth->output_val.svalue.len_used, rc, pcon->error);
+      }
+   }
+   pmeth->increment = 0;
+
+   rc = CACHE_SUCCESS;
+
+dbx_batch_exit:
+
+   if (pbatch->no_errors) {
+      T_STRCPY(pcon->error, _dbxso(pcon->error), pbatch->error);
+      if (rc == CACHE_SUCCESS) {
+         rc = CACHE_FAILURE;
+      }
+   }
+
+   DBX_DB_UNLOCK();
+
+   return rc;
+
+#ifdef _WIN32
+}
+__except (EXCEPTION_EXECUTE_HANDLER) {
+
+   DWORD code;
+   char bufferx[256];
+
+   __try {
+      code = GetExceptionCode();
+      sprintf_s(bufferx, 255, "Exception caught in f:dbx_batch: %x", code);
+      dbx_log_event(pcon, bufferx, (char *) "Error Condition", 0);
+   }
+   __except (EXCEPTION_EXECUTE_HANDLER) {
+      ;
+   }
+
+   return 0;
+}
+#endif
+}
+
+
+int dbx_set(DBXMETH *pmeth)
+{
+   int rc;
+   DBXCON *pcon = pmeth->pcon;
+
+#ifdef _WIN32
+__try {
+#endif
+
+   DBX_DB_LOCK(0);
+
+   if (pcon->net_connection) {
+      rc = netx_tcp_command(pmeth, DBX_CMND_GSET, 0);
+      goto dbx_set_exit;
+   }
+
+   rc = dbx_global_reference(pmeth);
+   if (rc != CACHE_SUCCESS) {
+      dbx_error_message(pmeth, rc);
+      goto dbx_set_exit;
+   }
+
+   if (pcon->dbtype == DBX_DBTYPE_YOTTADB) {
+      rc = pcon->p_ydb_so->p_ydb_set_s(&(pmeth->args[0].svalue), pmeth->cargc - 2, &pmeth->yargs[0], &(pmeth->args[pmeth->cargc - 1].svalue));
+   }
+   else {
+      rc = pcon->p_isc_so->p_CacheGlobalSet(pmeth->cargc - 2);
+      isc_cleanup(pmeth);
+   }
+
+   pcon->utf16 = 0;
+   if (rc == CACHE_SUCCESS) {
+      dbx_create_string(&(pmeth->output_val.svalue), (void *) &rc, DBX_DTYPE_INT);
+   }
+   else {
+      dbx_error_message(pmeth, rc);
+   }
+
+dbx_set_exit:
+
+   DBX_DB_UNLOCK();
+
+   return rc;
 
 #ifdef _WIN32
 }
@@ -8412,6 +10472,9 @@ __try {
             rc = pcon->p_isc_so->p_CachePushStr(netbuf_used, (Callin_char_t *) netbuf);
          }
          else {
+            if (pmeth->args_hwm < 1) { /* v2.5.35 */
+               pmeth->args_hwm = 1;
+            }
             pmeth->args[0].cvalue.pstr = (void *) pcon->p_isc_so->p_CacheExStrNew((CACHE_EXSTRP) &(pmeth->args[0].cvalue.zstr), netbuf_used + 1);
             for (ne = 0; ne < (int) netbuf_used; ne ++) {
                pmeth->args[0].cvalue.zstr.str.ch[ne] = (char) netbuf[ne];
@@ -8830,7 +10893,10 @@ __try {
    for (n = 0; n < pmeth->argc; n ++) {
 
       if (n == 0) {
-         if (pcon->utf16) {
+         if (pmeth->pfref) { /* v2.5.35 prepared function (mfunction) */
+            dbx_function_prepare(pmeth, pfun);
+         }
+         else if (pcon->utf16) {
             unsigned int n16, nc;
 
             pfun->label = NULL;
@@ -8897,6 +10963,73 @@ __except (EXCEPTION_EXECUTE_HANDLER) {
 }
 
 
+/* v2.5.35 Prepared function (mfunction): label^routine is parsed on first use (or after a change of character set) and then copied into each request */
+int dbx_function_prepare(DBXMETH *pmeth, DBXFUN *pfun)
+{
+   short cset;
+   char *p;
+   unsigned int n16, nc;
+   DBXFREF *pfref = pmeth->pfref;
+   DBXFUN *pfunx = pfref->pfun;
+   DBXCON *pcon = pmeth->pcon;
+
+   cset = pcon->utf16 ? 2 : 1;
+   if (pfref->prepared != cset) {
+      if (pcon->utf16) {
+         pfunx->label = NULL;
+         pfunx->routine = NULL;
+         nc = (unsigned int) pfref->function16_len;
+         for (n16 = 0; n16 < (unsigned int) pfref->function16_len; n16 ++) {
+            pfunx->buffer.str16[n16] = pfref->function16[n16];
+            if (pfunx->buffer.str16[n16] == 94) {
+               nc = n16;
+            }
+         }
+         pfunx->buffer.str16[pfref->function16_len] = 0;
+         pfunx->label16 = pfunx->buffer.str16;
+         pfunx->routine16 = pfunx->buffer.str16 + pfref->function16_len;
+         if (nc < (unsigned int) pfref->function16_len) {
+            pfunx->buffer.str16[nc] = 0;
+            pfunx->routine16 = pfunx->buffer.str16 + nc + 1;
+         }
+         pfunx->label_len = (int) nc;
+         pfunx->routine_len = (int) (pfunx->buffer.str16 + pfref->function16_len - pfunx->routine16);
+      }
+      else {
+         pfunx->label16 = NULL;
+         pfunx->routine16 = NULL;
+         T_STRNCPY(pfunx->buffer.str8, _dbxso(pfunx->buffer), pfref->function, pfref->function_len);
+         pfunx->buffer.str8[pfref->function_len] = '\0';
+         pfunx->label = pfunx->buffer.str8;
+         p = strstr(pfunx->buffer.str8, "^");
+         if (p) {
+            *p = '\0';
+            pfunx->routine = p + 1;
+         }
+         else {
+            pfunx->routine = pfunx->buffer.str8 + pfref->function_len;
+         }
+         pfunx->label_len = (int) strlen(pfunx->label);
+         pfunx->routine_len = (int) strlen(pfunx->routine);
+      }
+      /* YottaDB: the call-in name is the label and the handle is filled in by the first ydb_cip() */
+      pfref->ci.rtn_name.address = pfunx->label;
+      pfref->ci.rtn_name.length = (unsigned long) (pfunx->label ? pfunx->label_len : 0);
+      pfref->ci.handle = NULL;
+      pfref->prepared = cset;
+   }
+
+   pfun->label = pfunx->label;
+   pfun->label16 = pfunx->label16;
+   pfun->label_len = pfunx->label_len;
+   pfun->routine = pfunx->routine;
+   pfun->routine16 = pfunx->routine16;
+   pfun->routine_len = pfunx->routine_len;
+
+   return CACHE_SUCCESS;
+}
+
+
 int dbx_function(DBXMETH *pmeth)
 {
    int rc;
@@ -10113,12 +12246,15 @@ __try {
       for (n = 0; n < pqr_prev->keyn; n ++) {
          dbx_ibuffer_add(pmeth, NULL, nx ++, str, (void *) pqr_prev->ykeys[n].buf_addr, pqr_prev->ykeys[n].len_used, 0, 0);
       }
+      /* v2.5.35 the caller's DB lock may span several of these: nest it so that it is held for the round trip */
+      DBX_DB_LOCK(0);
       if (dir == 1) {
          rc = netx_tcp_command(pmeth, getdata ? DBX_CMND_GNEXTDATA : DBX_CMND_GNEXT, 0);
       }
       else {
          rc = netx_tcp_command(pmeth, getdata ? DBX_CMND_GPREVIOUSDATA : DBX_CMND_GPREVIOUS, 0);
       }
+      DBX_DB_UNLOCK();
       if (getdata && pmeth->output_val.svalue.len_used > 0) {
          len = dbx_get_block_size((unsigned char *) pmeth->output_val.svalue.buf_addr, 0, &(pmeth->output_val.sort), &(pmeth->output_val.type));
          nx = 5;
@@ -10127,9 +12263,23 @@ __try {
          nx += len;
          len = dbx_get_block_size((unsigned char *) pmeth->output_val.svalue.buf_addr + nx, 0, &(pmeth->output_val.sort), &(pmeth->output_val.type));
          nx += 5;
+         if (dbx_dbxqr_data_size(pqr_prev, (unsigned int) len) != CACHE_SUCCESS) { /* v2.5.35 */
+            strcpy(pcon->error, "No memory available for the data");
+            rc = CACHE_FAILURE;
+            len = 0;
+         }
          strncpy(pqr_prev->data.svalue.buf_addr, pmeth->output_val.svalue.buf_addr + nx, len);
          pqr_prev->data.svalue.len_used = len;
       }
+      else if (!getdata && rc == CACHE_SUCCESS) { /* v2.5.35 the next key is returned as the whole of the response */
+         len = (int) pmeth->output_val.svalue.len_used;
+         if (len >= (int) pqr_prev->ykeys[pqr_prev->keyn - 1].len_alloc) {
+            len = (int) pqr_prev->ykeys[pqr_prev->keyn - 1].len_alloc - 1;
+         }
+         memcpy((void *) pqr_prev->ykeys[pqr_prev->keyn - 1].buf_addr, (void *) pmeth->output_val.svalue.buf_addr, (size_t) len);
+         pqr_prev->ykeys[pqr_prev->keyn - 1].buf_addr[len] = '\0';
+         pqr_prev->ykeys[pqr_prev->keyn - 1].len_used = len;
+      }
    }
    else if (pcon->dbtype == DBX_DBTYPE_YOTTADB) {
 
@@ -10219,7 +12369,7 @@ __try {
          dbx_log_response(pcon, (char *) pmeth->output_val.svalue.buf_addr, (int) pmeth->output_val.svalue.len_used, (char *) (dir == 1 ? "mcursor::next (order)" : "mcursor::previous (order)"));
    }
 
-   return 0;
+   return rc; /* v2.5.35 */
 
 #ifdef _WIN32
 }
@@ -10278,12 +12428,15 @@ __try {
       for (n = 0; n < pqr_prev->keyn; n ++) {
          dbx_ibuffer_add(pmeth, NULL, nx ++, str, (void *) pqr_prev->ykeys[n].buf_addr, pqr_prev->ykeys[n].len_used, 0, 0);
       }
+      /* v2.5.35 the caller's DB lock may span several of these: nest it so that it is held for the round trip */
+      DBX_DB_LOCK(0);
       if (dir == 1) {
          rc = netx_tcp_command(pmeth, getdata ? DBX_CMND_GNNODEDATA : DBX_CMND_GNNODE, 0);
       }
       else {
          rc = netx_tcp_command(pmeth, getdata ? DBX_CMND_GPNODEDATA : DBX_CMND_GPNODE, 0);
       }
+      DBX_DB_UNLOCK();
       if (getdata && pmeth->output_val.svalue.len_used > 0) {
          len = dbx_get_block_size((unsigned char *) pmeth->output_val.svalue.buf_addr, 0, &(pmeth->output_val.sort), &(pmeth->output_val.type));
          nx = 5;
@@ -10299,7 +12452,15 @@ __try {
             nx += len;
             len = dbx_get_block_size((unsigned char *) pmeth->output_val.svalue.buf_addr + nx, 0, &(pmeth->output_val.sort), &(pmeth->output_val.type));
             nx += 5;
-            pqr_next->data.svalue.buf_addr = pmeth->output_val.svalue.buf_addr + nx;
+            /* v2.5.35 copy the data: the output buffer belongs to the request and is released with it */
+            if (dbx_dbxqr_data_size(pqr_next, (unsigned int) len) != CACHE_SUCCESS) {
+               strcpy(pcon->error, "No memory available for the data");
+               rc = CACHE_FAILURE;
+               eod = 1;
+               len = 0;
+            }
+            memcpy((void *) pqr_next->data.svalue.buf_addr, (void *) (pmeth->output_val.svalue.buf_addr + nx), (size_t) len);
+            pqr_next->data.svalue.buf_addr[len] = '\0';
             pqr_next->data.svalue.len_used = len;
          }
       }
@@ -10798,283 +12959,1195 @@ int cache_report_failure(DBXCON *pcon)
 }
 
 
-/* ASYNC THREAD : Do the Cache task */
-int dbx_launch_thread(DBXMETH *pmeth)
+/* ASYNC THREAD : Do the Cache task */
+int dbx_launch_thread(DBXMETH *pmeth)
+{
+#if !defined(_WIN32)
+
+   dbx_pool_submit_task(pmeth);
+
+   return 1;
+
+#else
+
+   {
+      int rc = 0;
+#if defined(_WIN32)
+      HANDLE hthread;
+      SIZE_T stack_size;
+      DWORD thread_id, cre_flags, result;
+      LPSECURITY_ATTRIBUTES pattr;
+
+      stack_size = 0;
+      cre_flags = 0;
+      pattr = NULL;
+
+      hthread = CreateThread(pattr, stack_size, (LPTHREAD_START_ROUTINE) dbx_thread_main, (LPVOID) pmeth, cre_flags, &thread_id);
+/*
+      printf("\r\n*** %lu Primary Thread : CreateThread (%d) ...", (unsigned long) dbx_current_thread_id(), dbx_queue_size);
+*/
+      if (!hthread) {
+         printf("failed to create thread, errno = %d\n",errno);
+      }
+      else {
+         result = WaitForSingleObject(hthread, INFINITE);
+      }
+#else
+      pthread_attr_t attr;
+      pthread_t child_thread;
+
+      size_t stacksize, newstacksize;
+
+      pthread_attr_init(&attr);
+
+      stacksize = 0;
+      pthread_attr_getstacksize(&attr, &stacksize);
+
+      newstacksize = DBX_THREAD_STACK_SIZE;
+
+      pthread_attr_setstacksize(&attr, newstacksize);
+/*
+      printf("Thread: default stack=%lu; new stack=%lu;\n", (unsigned long) stacksize, (unsigned long) newstacksize);
+*/
+      rc = pthread_create(&child_thread, &attr, dbx_thread_main, (void *) pmeth);
+      if (rc) {
+         printf("failed to create thread, errno = %d\n",errno);
+      }
+      else {
+         rc = pthread_join(child_thread,NULL);
+      }
+#endif
+   }
+
+#endif
+
+   return 1;
+}
+
+
+#if defined(_WIN32)
+LPTHREAD_START_ROUTINE dbx_thread_main(LPVOID pargs)
+#else
+void * dbx_thread_main(void *pargs)
+#endif
+{
+   DBXMETH *pmeth;
+/*
+   printf("\r\n*** %lu Worker Thread : Thread (%d) ...", (unsigned long) dbx_current_thread_id(), dbx_queue_size);
+*/
+   pmeth = (DBXMETH *) pargs;
+
+   pmeth->p_dbxfun(pmeth);
+
+#if defined(_WIN32)
+   return 0;
+#else
+   return NULL;
+#endif
+}
+
+
+/* v2.5.35 */
+void dbx_pool_queue_init(void)
+{
+#if !defined(_WIN32)
+   unsigned long n;
+
+   memset((void *) &dbx_task_queue, 0, sizeof(DBXTASKQ));
+   dbx_task_queue.mask = DBX_TASK_QUEUE_SIZE - 1;
+   for (n = 0; n < DBX_TASK_QUEUE_SIZE; n ++) {
+      dbx_task_queue.slot[n].sequence = n;
+   }
+#endif
+   return;
+}
+
+
+int dbx_pool_add_task(DBXMETH *pmeth)
+{
+   return dbx_pool_add_task_ex(pmeth, 1);
+}
+
+
+/* v2.5.35 Enqueue onto the lock-free ring: claim a slot by advancing enqueue_pos, then publish it through its sequence number */
+/* If the ring is full, return 0 unless the caller can wait for a slot to be released ('wait') */
+int dbx_pool_add_task_ex(DBXMETH *pmeth, int wait)
+{
+#if !defined(_WIN32)
+   long diff;
+   unsigned long pos, seq, depth;
+   struct dbx_pool_task *slot;
+   DBXTASKQ *pq = &dbx_task_queue;
+
+   pos = DBX_ATOMIC_LOAD_RELAXED(&(pq->enqueue_pos));
+   while (1) {
+      slot = &(pq->slot[pos & pq->mask]);
+      seq = DBX_ATOMIC_LOAD(&(slot->sequence));
+      diff = (long) seq - (long) pos;
+      if (diff == 0) {
+         if (DBX_ATOMIC_CAS(&(pq->enqueue_pos), &pos, pos + 1)) {
+            break;
+         }
+         DBX_ATOMIC_INC_STAT(&(pq->enqueue_retries));
+      }
+      else if (diff < 0) {
+         /* ring is full: a thread waiting for its request (a libuv worker) yields until a slot is released; the event loop thread must not */
+         DBX_ATOMIC_INC_STAT(&(pq->queue_full));
+         if (!wait) {
+            return 0;
+         }
+         sched_yield();
+         pos = DBX_ATOMIC_LOAD_RELAXED(&(pq->enqueue_pos));
+      }
+      else {
+         pos = DBX_ATOMIC_LOAD_RELAXED(&(pq->enqueue_pos));
+      }
+   }
+
+   slot->task_id = 6;
+   slot->pmeth = pmeth;
+   slot->parent_tid = pthread_self();
+   DBX_ATOMIC_STORE(&(slot->sequence), pos + 1);
+
+   DBX_ATOMIC_INC_STAT(&(pq->enqueued));
+   depth = pos + 1 - DBX_ATOMIC_LOAD_RELAXED(&(pq->dequeue_pos));
+   if (depth <= DBX_TASK_QUEUE_SIZE && depth > DBX_ATOMIC_LOAD_RELAXED(&(pq->max_depth))) {
+      __atomic_store_n(&(pq->max_depth), depth, __ATOMIC_RELAXED);
+   }
+
+   dbx_pool_wake();
+
+   /* v2.5.35 queue pressure: work is waiting and nobody is idle */
+   if (__atomic_load_n(&(pq->idle_threads), __ATOMIC_SEQ_CST) == 0 && DBX_ATOMIC_LOAD_RELAXED(&(dbx_pool.threads)) < dbx_pool.max_threads) {
+      dbx_pool_grow(pmeth->pcon);
+   }
+#endif
+
+   return 1;
+}
+
+
+/* v2.5.35 Dequeue from the lock-free ring into the caller's task structure: returns 0 if the ring is empty */
+int dbx_pool_get_task(struct dbx_pool_task *task)
+{
+#if !defined(_WIN32)
+   long diff;
+   unsigned long pos, seq;
+   struct dbx_pool_task *slot;
+   DBXTASKQ *pq = &dbx_task_queue;
+
+   pos = DBX_ATOMIC_LOAD_RELAXED(&(pq->dequeue_pos));
+   while (1) {
+      slot = &(pq->slot[pos & pq->mask]);
+      seq = DBX_ATOMIC_LOAD(&(slot->sequence));
+      diff = (long) seq - (long) (pos + 1);
+      if (diff == 0) {
+         if (DBX_ATOMIC_CAS(&(pq->dequeue_pos), &pos, pos + 1)) {
+            break;
+         }
+         DBX_ATOMIC_INC_STAT(&(pq->dequeue_retries));
+      }
+      else if (diff < 0) {
+         return 0;
+      }
+      else {
+         pos = DBX_ATOMIC_LOAD_RELAXED(&(pq->dequeue_pos));
+      }
+   }
+
+   task->task_id = slot->task_id;
+   task->pmeth = slot->pmeth;
+   task->parent_tid = slot->parent_tid;
+   task->sequence = pos;
+   DBX_ATOMIC_STORE(&(slot->sequence), pos + pq->mask + 1);
+
+   DBX_ATOMIC_INC_STAT(&(pq->dequeued));
+
+   return 1;
+#else
+   return 0;
+#endif
+}
+
+
+/* v2.5.35 Park an idle pool thread until wake_seq moves on: returns 1 if the (non-zero) timeout expired */
+int dbx_pool_park(unsigned int wake_seq, int timeout)
+{
+#if defined(LINUX)
+   struct timespec ts;
+
+   ts.tv_sec = timeout;
+   ts.tv_nsec = 0;
+   if (syscall(SYS_futex, &(dbx_task_queue.wake_seq), FUTEX_WAIT_PRIVATE, wake_seq, timeout > 0 ? &ts : NULL, NULL, 0) == -1 && errno == ETIMEDOUT) {
+      return 1;
+   }
+#elif !defined(_WIN32)
+   int rc = 0;
+   struct timespec ts;
+   struct timeval tp;
+
+   pthread_mutex_lock(&dbx_pool_mutex);
+   if (DBX_ATOMIC_LOAD(&(dbx_task_queue.wake_seq)) == wake_seq) {
+      if (timeout > 0) {
+         gettimeofday(&tp, NULL);
+         ts.tv_sec = tp.tv_sec + timeout;
+         ts.tv_nsec = tp.tv_usec * 1000;
+         rc = pthread_cond_timedwait(&dbx_pool_cond, &dbx_pool_mutex, &ts);
+      }
+      else {
+         pthread_cond_wait(&dbx_pool_cond, &dbx_pool_mutex);
+      }
+   }
+   pthread_mutex_unlock(&dbx_pool_mutex);
+   if (rc == ETIMEDOUT) {
+      return 1;
+   }
+#endif
+   return 0;
+}
+
+
+/* v2.5.35 Wake one parked pool thread (if any) after a task has been published */
+void dbx_pool_wake(void)
+{
+#if !defined(_WIN32)
+   DBXTASKQ *pq = &dbx_task_queue;
+
+   DBX_ATOMIC_ADD(&(pq->wake_seq), 1);
+   DBX_ATOMIC_FENCE();
+   if (__atomic_load_n(&(pq->idle_threads), __ATOMIC_SEQ_CST) > 0) {
+      DBX_ATOMIC_INC_STAT(&(pq->wakeups));
+#if defined(LINUX)
+      syscall(SYS_futex, &(pq->wake_seq), FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+#else
+      pthread_mutex_lock(&dbx_pool_mutex);
+      pthread_cond_signal(&dbx_pool_cond);
+      pthread_mutex_unlock(&dbx_pool_mutex);
+#endif
+   }
+#endif
+   return;
+}
+
+
+void dbx_pool_execute_task(struct dbx_pool_task *task, int thread_id)
+{
+   if (task) {
+
+      task->pmeth->p_dbxfun(task->pmeth);
+
+      /* v2.5.35 wake only the thread waiting for this task */
+      task->pmeth->done = 1;
+      DBX_ATOMIC_INC_STAT(&(dbx_task_queue.completions));
+      if (task->pmeth->p_async) {
+         dbx_async_complete(task->pmeth);
+      }
+      else if (dbx_completion_signal(&(task->pmeth->completion))) {
+         DBX_ATOMIC_INC_STAT(&(dbx_task_queue.completion_wakeups));
+      }
+   }
+}
+
+
+void * dbx_pool_requests_loop(void *data)
+{
+   int thread_id;
+   DBXTID *ptid;
+#if !defined(_WIN32)
+   unsigned int wake_seq;
+   struct timespec t1, t2;
+   struct dbx_pool_task task;
+   DBXTASKQ *pq = &dbx_task_queue;
+#endif
+
+   ptid = (DBXTID *) data;
+   if (!ptid) {
+      return NULL;
+   }
+
+   thread_id = ptid->thread_id;
+
+/*
+#if !defined(_WIN32)
+{
+   int ret;
+   pthread_attr_t tattr;
+   size_t size;
+   ret = pthread_getattr_np(pthread_self(), &tattr);
+   ret = pthread_attr_getstacksize(&tattr, &size);
+   printf("\r\n*** pthread_attr_getstacksize (pool) %x *** ret=%d; size=%u\r\n", (unsigned long) pthread_self(), ret, size);
+}
+#endif
+*/
+
+#if !defined(_WIN32)
+   while (1) {
+      if (!dbx_pool_get_task(&task)) {
+         /* v2.5.35 announce that we are about to sleep, then look again before parking so that no wakeup is lost */
+         wake_seq = DBX_ATOMIC_LOAD(&(pq->wake_seq));
+         DBX_ATOMIC_ADD(&(pq->idle_threads), 1);
+         DBX_ATOMIC_FENCE();
+         if (!dbx_pool_get_task(&task)) {
+            DBX_ATOMIC_INC_STAT(&(pq->parks));
+            DBX_ATOMIC_INC_STAT(&(ptid->parks));
+            if (dbx_pool_park(wake_seq, dbx_pool.idle_timeout)) {
+               DBX_ATOMIC_ADD(&(pq->idle_threads), -1);
+               if (dbx_pool_retire(ptid)) {
+                  break;
+               }
+            }
+            else {
+               DBX_ATOMIC_ADD(&(pq->idle_threads), -1);
+            }
+            continue;
+         }
+         DBX_ATOMIC_ADD(&(pq->idle_threads), -1);
+      }
+
+      clock_gettime(CLOCK_MONOTONIC, &t1);
+      dbx_pool_execute_task(&task, thread_id);
+      clock_gettime(CLOCK_MONOTONIC, &t2);
+
+      DBX_ATOMIC_INC_STAT(&(ptid->tasks));
+      __atomic_add_fetch(&(ptid->busy_ns), (unsigned long long) ((t2.tv_sec - t1.tv_sec) * 1000000000LL + (t2.tv_nsec - t1.tv_nsec)), __ATOMIC_RELAXED);
+   }
+#endif
+
+   return NULL;
+}
+
+
+/* v2.5.35 An idle thread leaves the pool if the pool is above its minimum size and no work is waiting */
+int dbx_pool_retire(DBXTID *ptid)
+{
+   int retire;
+
+   retire = 0;
+#if !defined(_WIN32)
+   DBX_ATOMIC_FENCE();
+   if (DBX_ATOMIC_LOAD(&(dbx_task_queue.enqueue_pos)) != DBX_ATOMIC_LOAD(&(dbx_task_queue.dequeue_pos))) {
+      return 0;
+   }
+
+   pthread_mutex_lock(&dbx_pool_mutex);
+   if (dbx_pool.threads > dbx_pool.min_threads) {
+      DBX_ATOMIC_ADD(&(dbx_pool.threads), -1);
+      dbx_pool.retired ++;
+      ptid->state = 0;
+      retire = 1;
+   }
+   pthread_mutex_unlock(&dbx_pool_mutex);
+#endif
+
+   return retire;
+}
+
+
+/* v2.5.35 Start one pool thread: called with dbx_pool_mutex held */
+int dbx_pool_thread_create(DBXCON *pcon)
+{
+#if !defined(_WIN32)
+   int n, rc;
+   DBXTID *ptid;
+   pthread_t thread;
+   pthread_attr_t attr;
+#if defined(LINUX)
+   cpu_set_t cpuset;
+#endif
+
+   ptid = NULL;
+   for (n = 0; n < DBX_THREADPOOL_LIMIT; n ++) {
+      if (!dbx_pool.ptid[n]) {
+         dbx_pool.ptid[n] = (DBXTID *) dbx_malloc(sizeof(DBXTID), 0);
+         if (!dbx_pool.ptid[n]) {
+            return CACHE_FAILURE;
+         }
+         dbx_pool.ptid[n]->state = 0;
+      }
+      if (dbx_pool.ptid[n]->state == 0) {
+         ptid = dbx_pool.ptid[n];
+         break;
+      }
+   }
+   if (!ptid) {
+      return CACHE_FAILURE;
+   }
+
+   memset((void *) ptid, 0, sizeof(DBXTID));
+   ptid->thread_id = n;
+   ptid->p_mutex = pcon->p_mutex;
+   ptid->p_zv = pcon->p_zv;
+   ptid->cpu = -1;
+   ptid->state = 1;
+
+   pthread_attr_init(&attr);
+   pthread_attr_setstacksize(&attr, dbx_pool.stack_size);
+   pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+#if defined(LINUX)
+   if (dbx_pool.no_cpus > 0) {
+      ptid->cpu = dbx_pool.cpus[dbx_pool.next_cpu ++ % dbx_pool.no_cpus];
+      CPU_ZERO(&cpuset);
+      CPU_SET(ptid->cpu, &cpuset);
+      pthread_attr_setaffinity_np(&attr, sizeof(cpu_set_t), &cpuset);
+   }
+#endif
+
+   rc = pthread_create(&thread, &attr, dbx_pool_requests_loop, (void *) ptid);
+   pthread_attr_destroy(&attr);
+   if (rc && ptid->cpu >= 0) {
+      /* CPU not available to this process: run the thread unpinned rather than not at all */
+      ptid->cpu = -1;
+      pthread_attr_init(&attr);
+      pthread_attr_setstacksize(&attr, dbx_pool.stack_size);
+      pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+      rc = pthread_create(&thread, &attr, dbx_pool_requests_loop, (void *) ptid);
+      pthread_attr_destroy(&attr);
+   }
+   if (rc) {
+      ptid->state = 0;
+      return CACHE_FAILURE;
+   }
+
+   DBX_ATOMIC_ADD(&(dbx_pool.threads), 1);
+   dbx_pool.created ++;
+#endif
+   return CACHE_SUCCESS;
+}
+
+
+/* v2.5.35 Add a thread under queue pressure: never block the submitting thread for this */
+int dbx_pool_grow(DBXCON *pcon)
+{
+#if !defined(_WIN32)
+   if (pthread_mutex_trylock(&dbx_pool_mutex)) {
+      return 0;
+   }
+   if (dbx_pool.threads < dbx_pool.max_threads) {
+      dbx_pool_thread_create(pcon);
+   }
+   pthread_mutex_unlock(&dbx_pool_mutex);
+#endif
+   return 0;
+}
+
+
+int dbx_pool_thread_init(DBXCON *pcon, int num_threads)
+{
+#if !defined(_WIN32)
+   pthread_once(&dbx_task_queue_once, dbx_pool_queue_init); /* v2.5.35 */
+
+   pthread_mutex_lock(&dbx_pool_mutex);
+
+   if (!dbx_pool.max_threads) {
+      dbx_pool.max_threads = DBX_THREADPOOL_MAX;
+      dbx_pool.stack_size = DBX_THREAD_STACK_SIZE;
+      dbx_pool.idle_timeout = DBX_THREADPOOL_IDLE;
+   }
+   if (pcon->pool_max > 0) {
+      dbx_pool.max_threads = pcon->pool_max < DBX_THREADPOOL_LIMIT ? pcon->pool_max : DBX_THREADPOOL_LIMIT;
+   }
+   if (pcon->pool_size > 0) {
+      dbx_pool.min_threads = pcon->pool_size;
+   }
+   else {
+      /* as before, each connection contributes a thread */
+      dbx_pool.min_threads += num_threads;
+   }
+   if (dbx_pool.min_threads > dbx_pool.max_threads) {
+      dbx_pool.max_threads = dbx_pool.min_threads < DBX_THREADPOOL_LIMIT ? dbx_pool.min_threads : DBX_THREADPOOL_LIMIT;
+      dbx_pool.min_threads = dbx_pool.max_threads;
+   }
+   if (pcon->pool_stack_size > 0) {
+      dbx_pool.stack_size = (size_t) pcon->pool_stack_size;
+   }
+   if (pcon->pool_idle_timeout >= 0) {
+      dbx_pool.idle_timeout = pcon->pool_idle_timeout;
+   }
+   if (pcon->pool_no_cpus > 0) {
+      memcpy((void *) dbx_pool.cpus, (void *) pcon->pool_cpus, pcon->pool_no_cpus * sizeof(int));
+      dbx_pool.no_cpus = pcon->pool_no_cpus;
+   }
+
+   while (dbx_pool.threads < dbx_pool.min_threads) {
+      if (dbx_pool_thread_create(pcon) != CACHE_SUCCESS) {
+         break;
+      }
+   }
+
+   pthread_mutex_unlock(&dbx_pool_mutex);
+#endif
+   return 0;
+}
+
+
+int dbx_pool_submit_task(DBXMETH *pmeth)
+{
+#if !defined(_WIN32)
+   pmeth->done = 0;
+   DBX_ATOMIC_STORE(&(pmeth->completion.word), 0); /* v2.5.35 */
+
+   dbx_pool_add_task(pmeth);
+
+   if (dbx_completion_wait(&(pmeth->completion), 3)) {
+      DBX_ATOMIC_INC_STAT(&(dbx_task_queue.completion_waits));
+   }
+#endif
+   return 1;
+}
+
+
+/* v2.5.35 Completion through the event loop (open option 'pool_async') */
+int dbx_async_init(DBXCON *pcon, uv_loop_t *loop)
+{
+#if !defined(_WIN32)
+   DBXASYNC *pasync;
+
+   pasync = (DBXASYNC *) dbx_malloc(sizeof(DBXASYNC), 0);
+   if (!pasync) {
+      return CACHE_FAILURE;
+   }
+   memset((void *) pasync, 0, sizeof(DBXASYNC));
+   pthread_mutex_init(&(pasync->mutex), NULL);
+   pthread_cond_init(&(pasync->drained), NULL);
+
+   if (uv_async_init(loop, &(pasync->handle), dbx_async_callback)) {
+      pthread_cond_destroy(&(pasync->drained));
+      pthread_mutex_destroy(&(pasync->mutex));
+      dbx_free((void *) pasync, 0);
+      return CACHE_FAILURE;
+   }
+   pasync->handle.data = (void *) pasync;
+
+   /* the handle only keeps the loop alive while requests are outstanding */
+   uv_unref((uv_handle_t *) &(pasync->handle));
+
+   pcon->p_async = (void *) pasync;
+#endif
+   return CACHE_SUCCESS;
+}
+
+
+int dbx_async_close(DBXCON *pcon)
+{
+#if !defined(_WIN32)
+   DBXASYNC *pasync;
+
+   pasync = (DBXASYNC *) pcon->p_async;
+   if (!pasync) {
+      return CACHE_SUCCESS;
+   }
+   pcon->p_async = NULL;
+   pasync->closing = 1;
+   if (pasync->pending == 0 && !pasync->in_callback) {
+      uv_close((uv_handle_t *) &(pasync->handle), dbx_async_close_callback);
+   }
+#endif
+   return CACHE_SUCCESS;
+}
+
+
+/* EVENT LOOP THREAD : Wait until every outstanding request has been processed (before the connection is closed) */
+/* This includes requests passed to libuv workers because the pool's queue was full */
+/* Their callbacks are still invoked, as usual, from dbx_async_callback (which may itself be the caller) */
+int dbx_async_drain(DBXCON *pcon)
+{
+#if !defined(_WIN32)
+   DBXASYNC *pasync;
+   struct timespec ts;
+   struct timeval tp;
+
+   pasync = (DBXASYNC *) pcon->p_async;
+   if (!pasync) {
+      return CACHE_SUCCESS;
+   }
+
+   pthread_mutex_lock(&(pasync->mutex));
+   pasync->draining = 1;
+   while ((pasync->ready + pasync->delivering) < pasync->pending || pasync->overflowing > 0) {
+      gettimeofday(&tp, NULL);
+      ts.tv_sec = tp.tv_sec + 3;
+      ts.tv_nsec = tp.tv_usec * 1000;
+      pthread_cond_timedwait(&(pasync->drained), &(pasync->mutex), &ts);
+   }
+   pasync->draining = 0;
+   pthread_mutex_unlock(&(pasync->mutex));
+#endif
+   return CACHE_SUCCESS;
+}
+
+
+/* EVENT LOOP THREAD : Pass the request to the pool; its after_work callback is invoked from dbx_async_callback */
+/* Returns non-zero, without taking the request, if the pool's queue is full */
+int dbx_async_submit_task(DBXMETH *pmeth, void *req, void *after_work_cb)
+{
+#if !defined(_WIN32)
+   DBXASYNC *pasync;
+
+   pasync = (DBXASYNC *) pmeth->pcon->p_async;
+
+   pmeth->done = 0;
+   pmeth->p_async = (void *) pasync;
+   pmeth->p_async_req = req;
+   pmeth->p_async_cb = after_work_cb;
+   pmeth->p_async_next = NULL;
+
+   if (pasync->pending ++ == 0) {
+      uv_ref((uv_handle_t *) &(pasync->handle));
+   }
+
+   if (!dbx_pool_add_task_ex(pmeth, 0)) {
+      pmeth->p_async = NULL;
+      pasync->overflows ++;
+      pthread_mutex_lock(&(pasync->mutex));
+      pasync->overflowing ++;
+      pthread_mutex_unlock(&(pasync->mutex));
+      if (-- pasync->pending == 0) {
+         uv_unref((uv_handle_t *) &(pasync->handle));
+      }
+      return 1;
+   }
+#endif
+   return 0;
+}
+
+
+/* POOL THREAD : Append the completed request to the connection's queue and poke the event loop */
+int dbx_async_complete(DBXMETH *pmeth)
+{
+#if !defined(_WIN32)
+   DBXASYNC *pasync;
+
+   pasync = (DBXASYNC *) pmeth->p_async;
+
+   pthread_mutex_lock(&(pasync->mutex));
+   if (pasync->tail) {
+      pasync->tail->p_async_next = pmeth;
+   }
+   else {
+      pasync->head = pmeth;
+   }
+   pasync->tail = pmeth;
+   pasync->ready ++;
+   if (pasync->draining) {
+      pthread_cond_signal(&(pasync->drained));
+   }
+   pthread_mutex_unlock(&(pasync->mutex));
+
+   /* libuv coalesces multiple sends into one callback */
+   uv_async_send(&(pasync->handle));
+#endif
+   return 0;
+}
+
+
+/* WORKER THREAD : A request passed to a libuv worker because the pool's queue was full has been processed */
+int dbx_async_overflow_done(DBXCON *pcon)
+{
+#if !defined(_WIN32)
+   DBXASYNC *pasync;
+
+   pasync = (DBXASYNC *) pcon->p_async;
+
+   pthread_mutex_lock(&(pasync->mutex));
+   pasync->overflowing --;
+   if (pasync->draining) {
+      pthread_cond_signal(&(pasync->drained));
+   }
+   pthread_mutex_unlock(&(pasync->mutex));
+#endif
+   return 0;
+}
+
+
+/* EVENT LOOP THREAD : Drain all requests completed since the last callback */
+void dbx_async_callback(uv_async_t *handle)
 {
 #if !defined(_WIN32)
+   DBXASYNC *pasync;
+   DBXMETH *pmeth, *pnext;
 
-   dbx_pool_submit_task(pmeth);
-
-   return 1;
+   pasync = (DBXASYNC *) handle->data;
 
-#else
+   pthread_mutex_lock(&(pasync->mutex));
+   pmeth = pasync->head;
+   pasync->head = NULL;
+   pasync->tail = NULL;
+   pasync->delivering = pasync->ready;
+   pasync->ready = 0;
+   pthread_mutex_unlock(&(pasync->mutex));
 
-   {
-      int rc = 0;
-#if defined(_WIN32)
-      HANDLE hthread;
-      SIZE_T stack_size;
-      DWORD thread_id, cre_flags, result;
-      LPSECURITY_ATTRIBUTES pattr;
+   if (pmeth) {
+      pasync->batches ++;
+   }
 
-      stack_size = 0;
-      cre_flags = 0;
-      pattr = NULL;
+   pasync->in_callback = 1;
+   while (pmeth) {
+      pnext = pmeth->p_async_next;
+      pasync->completions ++;
+      pasync->pending --;
+      pasync->delivering --;
+      /* the callback releases pmeth */
+      ((uv_after_work_cb) pmeth->p_async_cb)((uv_work_t *) pmeth->p_async_req, 0);
+      pmeth = pnext;
+   }
+   pasync->in_callback = 0;
 
-      hthread = CreateThread(pattr, stack_size, (LPTHREAD_START_ROUTINE) dbx_thread_main, (LPVOID) pmeth, cre_flags, &thread_id);
-/*
-      printf("\r\n*** %lu Primary Thread : CreateThread (%d) ...", (unsigned long) dbx_current_thread_id(), dbx_queue_size);
-*/
-      if (!hthread) {
-         printf("failed to create thread, errno = %d\n",errno);
+   if (pasync->pending == 0) {
+      if (pasync->closing) {
+         uv_close((uv_handle_t *) &(pasync->handle), dbx_async_close_callback);
       }
       else {
-         result = WaitForSingleObject(hthread, INFINITE);
+         uv_unref((uv_handle_t *) &(pasync->handle));
       }
-#else
-      pthread_attr_t attr;
-      pthread_t child_thread;
+   }
+#endif
+   return;
+}
 
-      size_t stacksize, newstacksize;
 
-      pthread_attr_init(&attr);
+void dbx_async_close_callback(uv_handle_t *handle)
+{
+#if !defined(_WIN32)
+   DBXASYNC *pasync;
 
-      stacksize = 0;
-      pthread_attr_getstacksize(&attr, &stacksize);
+   pasync = (DBXASYNC *) handle->data;
+   pthread_cond_destroy(&(pasync->drained));
+   pthread_mutex_destroy(&(pasync->mutex));
+   dbx_free((void *) pasync, 0);
+#endif
+   return;
+}
 
-      newstacksize = DBX_THREAD_STACK_SIZE;
 
-      pthread_attr_setstacksize(&attr, newstacksize);
-/*
-      printf("Thread: default stack=%lu; new stack=%lu;\n", (unsigned long) stacksize, (unsigned long) newstacksize);
-*/
-      rc = pthread_create(&child_thread, &attr, dbx_thread_main, (void *) pmeth);
-      if (rc) {
-         printf("failed to create thread, errno = %d\n",errno);
-      }
-      else {
-         rc = pthread_join(child_thread,NULL);
-      }
+/* v2.5.35 Completion word states: 0 = pending; 1 = complete; 2 = pending with a thread sleeping on it */
+int dbx_completion_init(DBXDONE *pdone)
+{
+   pdone->word = 0;
+#if !defined(_WIN32) && !defined(LINUX)
+   pthread_mutex_init(&(pdone->mutex), NULL);
+   pthread_cond_init(&(pdone->cond), NULL);
 #endif
-   }
+   return 0;
+}
 
-#endif
 
-   return 1;
+int dbx_completion_destroy(DBXDONE *pdone)
+{
+#if !defined(_WIN32) && !defined(LINUX)
+   pthread_cond_destroy(&(pdone->cond));
+   pthread_mutex_destroy(&(pdone->mutex));
+#endif
+   return 0;
 }
 
 
-#if defined(_WIN32)
-LPTHREAD_START_ROUTINE dbx_thread_main(LPVOID pargs)
-#else
-void * dbx_thread_main(void *pargs)
-#endif
+/* Returns 1 if the waiting thread had to be woken: statistics are kept by the caller (pool tasks, TP hand-offs and pipeline turns all use this) */
+int dbx_completion_signal(DBXDONE *pdone)
 {
-   DBXMETH *pmeth;
-/*
-   printf("\r\n*** %lu Worker Thread : Thread (%d) ...", (unsigned long) dbx_current_thread_id(), dbx_queue_size);
-*/
-   pmeth = (DBXMETH *) pargs;
-
-   pmeth->p_dbxfun(pmeth);
+   int woken = 0;
+#if defined(LINUX)
+   unsigned int prev;
 
-#if defined(_WIN32)
-   return 0;
-#else
-   return NULL;
+   /* the waiter may release the request as soon as it sees 1, so the word must not be read again after the exchange */
+   prev = __atomic_exchange_n(&(pdone->word), 1, __ATOMIC_SEQ_CST);
+   if (prev == 2) {
+      woken = 1;
+      syscall(SYS_futex, &(pdone->word), FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+   }
+#elif !defined(_WIN32)
+   pthread_mutex_lock(&(pdone->mutex));
+   if (pdone->word == 2) {
+      woken = 1;
+      pthread_cond_signal(&(pdone->cond));
+   }
+   DBX_ATOMIC_STORE(&(pdone->word), 1);
+   pthread_mutex_unlock(&(pdone->mutex));
 #endif
+   return woken;
 }
 
 
-struct dbx_pool_task* dbx_pool_add_task(DBXMETH *pmeth)
+/* Returns the number of times the thread went to sleep */
+int dbx_completion_wait(DBXDONE *pdone, int timeout)
 {
-   struct dbx_pool_task* enqueue_task;
+   int waits = 0;
+#if defined(LINUX)
+   unsigned int expected;
+   struct timespec ts;
 
-   enqueue_task = (struct dbx_pool_task*) dbx_malloc(sizeof(struct dbx_pool_task), 601);
+   while (DBX_ATOMIC_LOAD(&(pdone->word)) != 1) {
+      expected = 0;
+      if (!__atomic_compare_exchange_n(&(pdone->word), &expected, 2, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST) && expected == 1) {
+         break;
+      }
+      waits ++;
+      ts.tv_sec = timeout;
+      ts.tv_nsec = 0;
+      syscall(SYS_futex, &(pdone->word), FUTEX_WAIT_PRIVATE, 2, &ts, NULL, 0);
+   }
+#elif !defined(_WIN32)
+   struct timespec ts;
+   struct timeval tp;
 
-   if (!enqueue_task) {
-      dbx_request_errors ++;
-      return NULL;
+   pthread_mutex_lock(&(pdone->mutex));
+   while (pdone->word != 1) {
+      pdone->word = 2;
+      gettimeofday(&tp, NULL);
+      ts.tv_sec  = tp.tv_sec + timeout;
+      ts.tv_nsec = tp.tv_usec * 1000;
+      waits ++;
+      pthread_cond_timedwait(&(pdone->cond), &(pdone->mutex), &ts);
    }
+   pthread_mutex_unlock(&(pdone->mutex));
+#endif
+   return waits;
+}
 
-   enqueue_task->task_id = 6;
-   enqueue_task->pmeth = pmeth;
-   enqueue_task->next = NULL;
 
+/* v2.5.35 Short hand-offs (such as the TP thread round trip) usually complete within a few microseconds: spin briefly before sleeping */
+int dbx_completion_wait_spin(DBXDONE *pdone, int spin, int timeout)
+{
 #if !defined(_WIN32)
-   enqueue_task->parent_tid = pthread_self();
-
-   pthread_mutex_lock(&dbx_task_queue_mutex);
+   int n;
 
-   if (dbx_total_tasks == 0) {
-      tasks = enqueue_task;
-      bottom_task = enqueue_task;
-   }
-   else {
-      bottom_task->next = enqueue_task;
-      bottom_task = enqueue_task;
+   for (n = 0; n < spin; n ++) {
+      if (DBX_ATOMIC_LOAD(&(pdone->word)) == 1) {
+         return 0;
+      }
+#if defined(DBX_SSE2)
+      _mm_pause();
+#else
+      if ((n & 63) == 63) {
+         sched_yield();
+      }
+#endif
    }
+#endif
+   return dbx_completion_wait(pdone, timeout);
+}
+
 
-   dbx_total_tasks ++;
+/* v2.5.35 db.benchmark() */
+unsigned long long dbx_benchmark_clock(void)
+{
+#if defined(_WIN32)
+   return (unsigned long long) GetTickCount64() * 1000000ULL;
+#else
+   struct timespec ts;
 
-   pthread_mutex_unlock(&dbx_task_queue_mutex);
-   pthread_cond_signal(&dbx_pool_cond);
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (unsigned long long) ts.tv_sec * 1000000000ULL + (unsigned long long) ts.tv_nsec;
 #endif
+}
+
+
+int dbx_benchmark_add(DBXBENCH *pbench, char *name, double value)
+{
+   if (pbench->no_results >= DBX_BENCH_MAX) {
+      return CACHE_FAILURE;
+   }
+   T_STRCPY(pbench->name[pbench->no_results], _dbxso(pbench->name[pbench->no_results]), name);
+   pbench->value[pbench->no_results] = value;
+   pbench->no_results ++;
 
-   return enqueue_task;
+   return CACHE_SUCCESS;
 }
 
 
-struct dbx_pool_task * dbx_pool_get_task(void)
+/* Wakeups per completion: 'threads' submitting threads (standing in for libuv workers) each pass requests to the pool and wait for them.
+   Each request is completed first by signalling the request's own completion word and then, as a comparison, by broadcasting
+   on one condition variable shared by all waiting threads (the scheme used before v2.5.35) */
+int dbx_benchmark_completion(DBXBENCH *pbench)
 {
-   struct dbx_pool_task* task;
+#if defined(_WIN32)
+   T_STRCPY(pbench->error, _dbxso(pbench->error), "This benchmark is not available on Windows");
+   return CACHE_FAILURE;
+#else
+   int n, mode, rc;
+   unsigned long completions, wakeups, waits;
+   unsigned long long t1, t2;
+   DBXTASKQ *pq = &dbx_task_queue;
 
-#if !defined(_WIN32)
-   pthread_mutex_lock(&dbx_task_queue_mutex);
-#endif
+   if (DBX_ATOMIC_LOAD(&(dbx_pool.threads)) < 1) {
+      T_STRCPY(pbench->error, _dbxso(pbench->error), "This benchmark needs an open connection (and its thread pool)");
+      return CACHE_FAILURE;
+   }
+   if (!pbench->pcon->use_mutex) {
+      T_STRCPY(pbench->error, _dbxso(pbench->error), "This benchmark needs a connection in multithreaded mode");
+      return CACHE_FAILURE;
+   }
+
+   dbx_enter_critical_section((void *) &dbx_async_mutex);
+   if (dbx_bench_active) {
+      dbx_leave_critical_section((void *) &dbx_async_mutex);
+      T_STRCPY(pbench->error, _dbxso(pbench->error), "A benchmark is already running");
+      return CACHE_FAILURE;
+   }
+   dbx_bench_active = pbench;
+   dbx_leave_critical_section((void *) &dbx_async_mutex);
+
+   pthread_mutex_init(&(pbench->mutex), NULL);
+   pthread_cond_init(&(pbench->cond), NULL);
+
+   dbx_benchmark_add(pbench, (char *) "requests", (double) pbench->requests);
+   dbx_benchmark_add(pbench, (char *) "threads", (double) pbench->threads);
+   dbx_benchmark_add(pbench, (char *) "pool_threads", (double) DBX_ATOMIC_LOAD(&(dbx_pool.threads)));
+
+   rc = CACHE_SUCCESS;
+   for (mode = 0; mode < 2 && rc == CACHE_SUCCESS; mode ++) {
+      pbench->broadcast = mode;
+      pbench->wakeups = 0;
+      completions = DBX_ATOMIC_LOAD(&(pq->completions));
+      wakeups = DBX_ATOMIC_LOAD(&(pq->completion_wakeups));
+      waits = DBX_ATOMIC_LOAD(&(pq->completion_waits));
+
+      for (n = 0; n < pbench->threads; n ++) {
+         pbench->thr[n].pbench = pbench;
+         pbench->thr[n].count = pbench->requests / pbench->threads + ((n < (pbench->requests % pbench->threads)) ? 1 : 0);
+         pbench->thr[n].flag = 0;
+         pbench->thr[n].pmeth = dbx_request_memory(pbench->pcon, 0, 0);
+         pbench->thr[n].pmeth->p_dbxfun = mode ? dbx_benchmark_broadcast : dbx_benchmark_nop;
+      }
+
+      t1 = dbx_benchmark_clock();
+      for (n = 0; n < pbench->threads; n ++) {
+         if (pthread_create(&(pbench->thr[n].tid), NULL, dbx_benchmark_submitter, (void *) &(pbench->thr[n]))) {
+            T_STRCPY(pbench->error, _dbxso(pbench->error), "Unable to create a benchmark thread");
+            rc = CACHE_FAILURE;
+            pbench->thr[n].count = 0;
+            pbench->thr[n].tid = 0;
+         }
+      }
+      for (n = 0; n < pbench->threads; n ++) {
+         if (pbench->thr[n].tid) {
+            pthread_join(pbench->thr[n].tid, NULL);
+         }
+      }
+      t2 = dbx_benchmark_clock();
 
-   if (dbx_total_tasks > 0) {
-      task = tasks;
-      tasks = task->next;
+      for (n = 0; n < pbench->threads; n ++) {
+         dbx_request_memory_free(pbench->pcon, pbench->thr[n].pmeth, 0);
+      }
 
-      if (tasks == NULL) {
-         bottom_task = NULL;
+      if (mode == 0) {
+         dbx_benchmark_add(pbench, (char *) "signal_ns_per_request", (double) (t2 - t1) / pbench->requests);
+         dbx_benchmark_add(pbench, (char *) "signal_completions", (double) (DBX_ATOMIC_LOAD(&(pq->completions)) - completions));
+         dbx_benchmark_add(pbench, (char *) "signal_waits", (double) (DBX_ATOMIC_LOAD(&(pq->completion_waits)) - waits));
+         dbx_benchmark_add(pbench, (char *) "signal_wakeups", (double) (DBX_ATOMIC_LOAD(&(pq->completion_wakeups)) - wakeups));
+         dbx_benchmark_add(pbench, (char *) "signal_wakeups_per_completion", (double) (DBX_ATOMIC_LOAD(&(pq->completion_wakeups)) - wakeups) / pbench->requests);
+      }
+      else {
+         dbx_benchmark_add(pbench, (char *) "broadcast_ns_per_request", (double) (t2 - t1) / pbench->requests);
+         dbx_benchmark_add(pbench, (char *) "broadcast_wakeups", (double) pbench->wakeups);
+         dbx_benchmark_add(pbench, (char *) "broadcast_wakeups_per_completion", (double) pbench->wakeups / pbench->requests);
       }
-      dbx_total_tasks --;
-   }
-   else {
-      task = NULL;
    }
 
-#if !defined(_WIN32)
-   pthread_mutex_unlock(&dbx_task_queue_mutex);
-#endif
+   pthread_cond_destroy(&(pbench->cond));
+   pthread_mutex_destroy(&(pbench->mutex));
 
-   return task;
+   dbx_enter_critical_section((void *) &dbx_async_mutex);
+   dbx_bench_active = NULL;
+   dbx_leave_critical_section((void *) &dbx_async_mutex);
+
+   return rc;
+#endif
 }
 
 
-void dbx_pool_execute_task(struct dbx_pool_task *task, int thread_id)
+/* Request set-up: acquire a request object, encode a global name and one key (as for a get) and release it.
+   The test is run first as it now is, then with every argument slot reset on each call (the scheme used before v2.5.35) */
+int dbx_benchmark_request(DBXBENCH *pbench, v8::Isolate * isolate)
 {
-   if (task) {
+   int n, mode;
+   unsigned long long t1, t2;
+   DBXMETH *pmeth;
+   v8::Local<v8::String> str;
 
-      task->pmeth->p_dbxfun(task->pmeth);
+   if (!pbench->pcon->open) {
+      T_STRCPY(pbench->error, _dbxso(pbench->error), "This benchmark needs an open connection");
+      return CACHE_FAILURE;
+   }
 
-      task->pmeth->done = 1;
+   dbx_benchmark_add(pbench, (char *) "requests", (double) pbench->requests);
 
-#if !defined(_WIN32)
-      pthread_cond_broadcast(&dbx_result_cond);
-#endif
+   for (mode = 0; mode < 2; mode ++) {
+      t1 = dbx_benchmark_clock();
+      for (n = 0; n < pbench->requests; n ++) {
+         pmeth = dbx_request_memory(pbench->pcon, 1, 0);
+         pmeth->ibuffer_used = 0;
+         pmeth->cargc = 0;
+         dbx_ibuffer_add(pmeth, isolate, 0, str, (void *) "^Person", 7, 0, 0);
+         dbx_ibuffer_add(pmeth, isolate, 1, str, (void *) "1", 1, 0, 0);
+         pmeth->argc = 2;
+         if (mode == 1) {
+            pmeth->args_hwm = DBX_MAXARGS;
+         }
+         dbx_request_memory_free(pbench->pcon, pmeth, 0);
+      }
+      t2 = dbx_benchmark_clock();
+
+      dbx_benchmark_add(pbench, mode ? (char *) "reset_all_ns_per_request" : (char *) "reset_used_ns_per_request", (double) (t2 - t1) / pbench->requests);
    }
+
+   return CACHE_SUCCESS;
 }
 
 
-void * dbx_pool_requests_loop(void *data)
+/* Returned values: create 'requests' distinct one-byte strings of 'size' Bytes (default 1024) from a request's output buffer.
+   The test is run three times: internalized (as all strings were before v2.5.35), as normal strings (dbx_new_string8v) and as external strings
+   (dbx_new_string8v with 'string_external' set).  Only the creation of the string is timed, and no more than 256MB is used for each */
+int dbx_benchmark_string(DBXBENCH *pbench, v8::Isolate * isolate)
 {
-   int thread_id;
-   DBXTID *ptid;
-   struct dbx_pool_task *task = NULL;
+   int n, len, mode, string_external;
+   unsigned long long t1, t2, total;
+   char buffer[32];
+   char *p;
+   DBXMETH *pmeth;
 
-   ptid = (DBXTID *) data;
-   if (!ptid) {
-      return NULL;
+   if (!pbench->pcon->open) {
+      T_STRCPY(pbench->error, _dbxso(pbench->error), "This benchmark needs an open connection");
+      return CACHE_FAILURE;
    }
 
-   thread_id = ptid->thread_id;
+   if (pbench->size < 1) {
+      pbench->size = 1024;
+   }
+   if (pbench->requests > ((256 * 1024 * 1024) / pbench->size)) {
+      pbench->requests = (256 * 1024 * 1024) / pbench->size;
+      if (pbench->requests < 1) {
+         pbench->requests = 1;
+      }
+   }
+   dbx_benchmark_add(pbench, (char *) "size", (double) pbench->size);
+   dbx_benchmark_add(pbench, (char *) "requests", (double) pbench->requests);
 
-/*
-#if !defined(_WIN32)
-{
-   int ret;
-   pthread_attr_t tattr;
-   size_t size;
-   ret = pthread_getattr_np(pthread_self(), &tattr);
-   ret = pthread_attr_getstacksize(&tattr, &size);
-   printf("\r\n*** pthread_attr_getstacksize (pool) %x *** ret=%d; size=%u\r\n", (unsigned long) pthread_self(), ret, size);
-}
-#endif
-*/
+   pmeth = dbx_request_memory(pbench->pcon, 1, 0);
+   string_external = pbench->pcon->string_external;
 
-#if !defined(_WIN32)
-   pthread_mutex_lock(&dbx_pool_mutex);
+   for (mode = 0; mode < 3; mode ++) {
+      isolate->LowMemoryNotification(); /* collect the strings left by the previous run before this one is timed */
+      pbench->pcon->string_external = (mode == 2) ? 1 : 0;
+      total = 0;
+      for (n = 0; n < pbench->requests; n ++) {
+         v8::HandleScope scope(isolate);
 
-   while (1) {
-      if (dbx_total_tasks > 0) {
-         task = dbx_pool_get_task();
-         if (task) {
-            pthread_mutex_unlock(&dbx_pool_mutex);
-            dbx_pool_execute_task(task, thread_id);
-            dbx_free(task, 3001);
-            pthread_mutex_lock(&dbx_pool_mutex);
+         /* an external string takes the output buffer with it, so a fresh one may be needed each time */
+         if ((int) pmeth->output_val.svalue.len_alloc <= pbench->size) {
+            p = (char *) dbx_malloc(sizeof(char) * (pbench->size + 2), 301);
+            if (!p) {
+               pbench->pcon->string_external = string_external;
+               dbx_request_memory_free(pbench->pcon, pmeth, 0);
+               T_STRCPY(pbench->error, _dbxso(pbench->error), "No memory available for benchmark");
+               return CACHE_FAILURE;
+            }
+            if (pmeth->output_val.svalue.buf_addr) {
+               dbx_free((void *) pmeth->output_val.svalue.buf_addr, 301);
+            }
+            pmeth->output_val.svalue.buf_addr = p;
+            pmeth->output_val.svalue.len_alloc = pbench->size + 1;
+            memset((void *) p, 'x', (size_t) pbench->size);
          }
+         /* each value is distinct, as values returned from the database would be */
+         T_SPRINTF(buffer, _dbxso(buffer), "%d:%d:", mode, n);
+         len = (int) strlen(buffer);
+         memcpy((void *) pmeth->output_val.svalue.buf_addr, (void *) buffer, (size_t) (len < pbench->size ? len : pbench->size));
+         pmeth->output_val.svalue.len_used = pbench->size;
+
+         t1 = dbx_benchmark_clock();
+         if (mode == 0) {
+            v8::String::NewFromOneByte(isolate, (uint8_t *) pmeth->output_val.svalue.buf_addr, v8::NewStringType::kInternalized, pbench->size).ToLocalChecked();
+         }
+         else {
+            dbx_new_string8v(isolate, pmeth, 0);
+         }
+         t2 = dbx_benchmark_clock();
+         total += (t2 - t1);
       }
-      else {
-         pthread_cond_wait(&dbx_pool_cond, &dbx_pool_mutex);
-      }
+      dbx_benchmark_add(pbench, (mode == 0) ? (char *) "internalized_ns_per_string" : (mode == 1) ? (char *) "normal_ns_per_string" : (char *) "external_ns_per_string", (double) total / pbench->requests);
    }
-#endif
 
-   return NULL;
+   pbench->pcon->string_external = string_external;
+   dbx_request_memory_free(pbench->pcon, pmeth, 0);
+
+   return CACHE_SUCCESS;
 }
 
 
-int dbx_pool_thread_init(DBXCON *pcon, int num_threads)
+int dbx_benchmark_nop(DBXMETH *pmeth)
 {
-#if !defined(_WIN32)
-   int iterator;
-   pthread_attr_t attr[DBX_THREADPOOL_MAX];
-   size_t stacksize, newstacksize;
-
-   for (iterator = 0; iterator < num_threads; iterator ++) {
-
-      pthread_attr_init(&attr[iterator]);
-
-      stacksize = 0;
-      pthread_attr_getstacksize(&attr[iterator], &stacksize);
+   return CACHE_SUCCESS;
+}
 
-      newstacksize = DBX_THREAD_STACK_SIZE;
-/*
-      printf("Thread Pool: default stack=%lu; new stack=%lu;\n", (unsigned long) stacksize, (unsigned long) newstacksize);
-*/
-      pthread_attr_setstacksize(&attr[iterator], newstacksize);
 
-      dbx_thr_id[iterator].thread_id = iterator;
-      dbx_thr_id[iterator].p_mutex = pcon->p_mutex;
-      dbx_thr_id[iterator].p_zv = pcon->p_zv;
-      
-      pthread_create(&dbx_p_threads[iterator], &attr[iterator], dbx_pool_requests_loop, (void *) &dbx_thr_id[iterator]);
+/* POOL THREAD : complete the request the way it was done before v2.5.35: wake every waiting thread */
+int dbx_benchmark_broadcast(DBXMETH *pmeth)
+{
+#if !defined(_WIN32)
+   int n;
+   DBXBENCH *pbench = dbx_bench_active;
 
+   pthread_mutex_lock(&(pbench->mutex));
+   for (n = 0; n < pbench->threads; n ++) {
+      if (pbench->thr[n].pmeth == pmeth) {
+         pbench->thr[n].flag = 1;
+         break;
+      }
    }
+   pthread_cond_broadcast(&(pbench->cond));
+   pthread_mutex_unlock(&(pbench->mutex));
 #endif
-   return 0;
+   return CACHE_SUCCESS;
 }
 
 
-int dbx_pool_submit_task(DBXMETH *pmeth)
+#if defined(_WIN32)
+LPTHREAD_START_ROUTINE dbx_benchmark_submitter(LPVOID pargs)
+#else
+void * dbx_benchmark_submitter(void *pargs)
+#endif
 {
 #if !defined(_WIN32)
-   struct timespec   ts;
-   struct timeval    tp;
-
-   pmeth->done = 0;
-
-   dbx_pool_add_task(pmeth);
+   int n;
+   struct timespec ts;
+   struct timeval tp;
+   DBXBENCHT *pthr = (DBXBENCHT *) pargs;
+   DBXBENCH *pbench = pthr->pbench;
+
+   for (n = 0; n < pthr->count; n ++) {
+      if (!pbench->broadcast) {
+         dbx_pool_submit_task(pthr->pmeth);
+         continue;
+      }
 
-   pthread_mutex_lock(&dbx_result_mutex);
+      pthread_mutex_lock(&(pbench->mutex));
+      pthr->flag = 0;
+      pthread_mutex_unlock(&(pbench->mutex));
 
-   while (!pmeth->done) {
+      pthr->pmeth->done = 0;
+      DBX_ATOMIC_STORE(&(pthr->pmeth->completion.word), 0);
+      dbx_pool_add_task(pthr->pmeth);
 
-      gettimeofday(&tp, NULL);
-      ts.tv_sec  = tp.tv_sec;
-      ts.tv_nsec = tp.tv_usec * 1000;
-      ts.tv_sec += 3;
+      pthread_mutex_lock(&(pbench->mutex));
+      while (!pthr->flag) {
+         gettimeofday(&tp, NULL);
+         ts.tv_sec = tp.tv_sec + 3;
+         ts.tv_nsec = tp.tv_usec * 1000;
+         pthread_cond_timedwait(&(pbench->cond), &(pbench->mutex), &ts);
+         pbench->wakeups ++;
+      }
+      pthread_mutex_unlock(&(pbench->mutex));
 
-      pthread_cond_timedwait(&dbx_result_cond, &dbx_result_mutex, &ts);
+      /* the pool thread still owns the request until it has signalled the request's own completion */
+      dbx_completion_wait(&(pthr->pmeth->completion), 3);
    }
+#endif
 
-   pthread_mutex_unlock(&dbx_result_mutex);
+#if defined(_WIN32)
+   return 0;
+#else
+   return NULL;
 #endif
-   return 1;
 }
 
 
@@ -11249,6 +14322,29 @@ DBXQR * dbx_alloc_dbxqr(DBXQR *pqr, int dsize, short alloc_char16, short context
 }
 
 
+/* v2.5.35 Make room for 'len' bytes of data (plus a terminator) in a query record */
+int dbx_dbxqr_data_size(DBXQR *pqr, unsigned int len)
+{
+   char *p;
+
+   if (len < pqr->data.svalue.len_alloc) {
+      return CACHE_SUCCESS;
+   }
+   p = (char *) dbx_malloc(len + CACHE_MAXSTRLEN, 0);
+   if (!p) {
+      return CACHE_FAILURE;
+   }
+   if (pqr->data.svalue.buf_addr) {
+      dbx_free((void *) pqr->data.svalue.buf_addr, 0);
+   }
+   pqr->data.svalue.buf_addr = p;
+   pqr->data.svalue.len_alloc = len + CACHE_MAXSTRLEN;
+   pqr->data.svalue.len_used = 0;
+
+   return CACHE_SUCCESS;
+}
+
+
 int dbx_free_dbxqr(DBXQR *pqr)
 {
    if (pqr->kbuffer16) {
@@ -11366,7 +14462,6 @@ int dbx_create_string(DBXSTR *pstr, void *data, short type)
 
 int dbx_log_transmission(DBXCON *pcon, DBXMETH *pmeth, char *name)
 {
-   unsigned int n;
    char *buffer8;
    char namex[64];
    char buffer[256];
@@ -11385,11 +14480,10 @@ int dbx_log_transmission(DBXCON *pcon, DBXMETH *pmeth, char *name)
       buffer8 = (char *) dbx_malloc(pmeth->ibuffer16_used + 4, 0);
       if (!buffer8)
          return 0;
-      for (n = 0; n < pmeth->ibuffer16_used; n ++) {
-         buffer8[n] = (char) pmeth->ibuffer16[n];
-      }
-      buffer[n] = '\0';
-      dbx_log_buffer(pcon, (char *) buffer8, pmeth->ibuffer_used, buffer, 0);
+      dbx_char16_to_char8((unsigned char *) buffer8, pmeth->ibuffer16, pmeth->ibuffer16_used); /* v2.5.35 */
+      buffer8[pmeth->ibuffer16_used] = '\0';
+      dbx_log_buffer(pcon, (char *) buffer8, pmeth->ibuffer16_used, buffer, 0);
+      dbx_free((void *) buffer8, 0);
    }
    else {
       dbx_log_buffer(pcon, (char *) pmeth->ibuffer, pmeth->ibuffer_used, buffer, 0);
@@ -33,7 +33,7 @@
 
 #define DBX_VERSION_MAJOR        "2"
 #define DBX_VERSION_MINOR        "5"
-#define DBX_VERSION_BUILD        "34"
+#define DBX_VERSION_BUILD        "35"
 
 #define DBX_VERSION              DBX_VERSION_MAJOR "." DBX_VERSION_MINOR "." DBX_VERSION_BUILD
 
@@ -60,6 +60,8 @@
 #define DBX_MAGIC_NUMBER_MCLASS   50474
 #define DBX_MAGIC_NUMBER_MCURSOR 200438
 #define DBX_MAGIC_NUMBER_MNET     30232
+#define DBX_MAGIC_NUMBER_MBULK    70281 /* v2.5.35 */
+#define DBX_MAGIC_NUMBER_MFUNCTION 90417
 
 #if defined(_WIN32)
 
@@ -138,18 +140,67 @@ DISABLE_WCAST_FUNCTION_TYPE
 #if !defined(_WIN32)
 
 #include <pthread.h>
+#include <sched.h>
 #include <dlfcn.h>
+#include <poll.h> /* v2.5.35 */
+#if defined(LINUX)
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+
+/* v2.5.35 */
+#define DBX_ATOMIC_LOAD(a)          __atomic_load_n(a, __ATOMIC_ACQUIRE)
+#define DBX_ATOMIC_LOAD_RELAXED(a)  __atomic_load_n(a, __ATOMIC_RELAXED)
+#define DBX_ATOMIC_STORE(a,b)       __atomic_store_n(a, b, __ATOMIC_RELEASE)
+#define DBX_ATOMIC_ADD(a,b)         __atomic_add_fetch(a, b, __ATOMIC_SEQ_CST)
+#define DBX_ATOMIC_INC_STAT(a)      __atomic_add_fetch(a, 1, __ATOMIC_RELAXED)
+#define DBX_ATOMIC_CAS(a,b,c)       __atomic_compare_exchange_n(a, b, c, 1, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)
+#define DBX_ATOMIC_FENCE()          __atomic_thread_fence(__ATOMIC_SEQ_CST)
 #endif
 
+#include "mg-char16.h" /* v2.5.35 */
+
 #define DBX_MAXARGS              64
 #define DBX_DEFAULT_TIMEOUT      30
 
 #define DBX_THREADPOOL_MAX       8
+#define DBX_THREADPOOL_LIMIT     256 /* v2.5.35 */
+#define DBX_THREADPOOL_CPUS      256
+#define DBX_THREADPOOL_IDLE      30
+
+#define DBX_METH_CACHE_MAX       64 /* v2.5.35 */
+#define DBX_TP_SPIN              1024 /* v2.5.35 */
+#define DBX_METH_TRIM_INTERVAL   1024
+#define DBX_OBUFFER_CACHE_MAX    16 /* v2.5.35 */
+#define DBX_BUFFER_ZERO_COPY     65536
+#define DBX_STRING_EXTERNAL      65536
+#define DBX_STRING_INTERN_MAX    32
+#define DBX_MAX_SAFE_INTEGER     9007199254740991LL
+
+/* v2.5.35 Test eight bytes at once: for a zero byte, a byte less than 'c' (up to 0x80) or a byte with the top bit set */
+#define DBX_SWAR_ONES            0x0101010101010101ULL
+#define DBX_SWAR_HIGHS           0x8080808080808080ULL
+#define DBX_SWAR_ZERO(w)         (((w) - DBX_SWAR_ONES) & ~(w) & DBX_SWAR_HIGHS)
+#define DBX_SWAR_LESS(w, c)      (((w) - (DBX_SWAR_ONES * (c))) & ~(w) & DBX_SWAR_HIGHS)
+#define DBX_SWAR_HIGH(w)         ((w) & DBX_SWAR_HIGHS)
+#define DBX_SWAR_JSON_ESCAPE(w)  (DBX_SWAR_LESS(w, 0x20) | DBX_SWAR_ZERO((w) ^ (DBX_SWAR_ONES * '"')) | DBX_SWAR_ZERO((w) ^ (DBX_SWAR_ONES * '\\')))
+#define DBX_ARGSTORE_MAX         8
+#define DBX_CURSOR_PREFETCH_MAX  10000
 
 #define DBX_ERROR_SIZE           512
 
 #define DBX_THREAD_STACK_SIZE    0xf0000
 
+/* v2.5.35 */
+#define DBX_TASK_QUEUE_SIZE      1024
+#define DBX_BATCH_WINDOW         64
+#define DBX_BATCH_WINDOW_SIZE    16384
+#define DBX_BATCH_OBUFFER_SIZE   256
+#define DBX_BULK_BATCH_SIZE      1000
+#define DBX_BULK_BUFFER_SIZE     262144
+#define DBX_NETPOOL_MAX          64
+#define DBX_NETPOOL_HEALTH_CHECK 30
+
 #define DBX_TEXT_E_ASYNC         "Unable to process task asynchronously"
 
 #define DBX_DSORT_INVALID        0
@@ -170,6 +221,7 @@ DISABLE_WCAST_FUNCTION_TYPE
 #define DBX_DTYPE_INT64          5
 #define DBX_DTYPE_DOUBLE         6
 #define DBX_DTYPE_OREF           7
+#define DBX_DTYPE_NUMERIC(a)     ((a) == DBX_DTYPE_INT || (a) == DBX_DTYPE_INT64 || (a) == DBX_DTYPE_DOUBLE) /* v2.5.35 */
 #define DBX_DTYPE_NULL           10
 #define DBX_DTYPE_STROBJ         11
 
@@ -191,6 +243,8 @@ DISABLE_WCAST_FUNCTION_TYPE
 #define DBX_CMND_GLOCK           18
 #define DBX_CMND_GUNLOCK         19
 #define DBX_CMND_GMERGE          20
+/* v2.5.35 a mixed batch: each item carries its own command */
+#define DBX_CMND_GBATCH          29
 
 #define DBX_CMND_GNNODE          21
 #define DBX_CMND_GNNODEDATA      211
@@ -580,9 +634,30 @@ typedef struct tagDBXTID {
    int         thread_id;
    DBXMUTEX    *p_mutex;
    DBXZV       *p_zv;
+   int         state; /* v2.5.35 0=free; 1=running */
+   int         cpu;
+   unsigned long tasks;
+   unsigned long parks;
+   unsigned long long busy_ns;
 } DBXTID, *PDBXTID;
 
 
+/* v2.5.35 Process-wide thread pool configuration and state */
+typedef struct tagDBXPOOL {
+   int         threads;
+   int         min_threads;
+   int         max_threads;
+   int         idle_timeout;
+   size_t      stack_size;
+   int         no_cpus;
+   int         cpus[DBX_THREADPOOL_CPUS];
+   int         next_cpu;
+   unsigned long created;
+   unsigned long retired;
+   DBXTID      *ptid[DBX_THREADPOOL_LIMIT];
+} DBXPOOL, *PDBXPOOL;
+
+
 /* Cache/IRIS */
 
 #define CACHE_MAXSTRLEN	32767
@@ -791,18 +866,44 @@ typedef struct tagDBXFUN {
 } DBXFUN, *PDBXFUN;
 
 
+/* v2.5.35 Input buffer segment holding the pre-encoded global name and fixed keys of an mglobal object */
+typedef struct tagDBXGPARG {
+   int            type;
+   int            sort;
+   long long      int64;
+   unsigned int   offs;
+   unsigned int   len_used;
+   unsigned int   len_alloc;
+   unsigned int   csize;
+} DBXGPARG, *PDBXGPARG;
+
+typedef struct tagDBXGPREFIX {
+   int            argc;
+   int            dbtype;
+   int            net_connection;
+   short          lock;
+   unsigned int   len;
+   DBXGPARG       *args;
+   unsigned char  *buffer;
+} DBXGPREFIX, *PDBXGPREFIX;
+
 typedef struct tagDBXGREF {
    char *         global;
    int            global_len;
    unsigned short *global16;
    int            global16_len;
    DBXVAL *       pkey;
+   DBXGPREFIX     **pprefix; /* v2.5.35 */
 } DBXGREF, *PDBXGREF;
 
 typedef struct tagDBXFREF {
    char *         function;
    unsigned short *function16;
    int            function_len;
+   int            function16_len; /* v2.5.35 */
+   short          prepared;
+   DBXFUN         *pfun;
+   ci_name_descriptor ci;
 } DBXFREF, *PDBXFREF;
 
 typedef struct tagDBXCREF {
@@ -978,6 +1079,29 @@ typedef struct tagDBXYDBSO {
 } DBXYDBSO, *PDBXYDBSO;
 
 
+/* v2.5.35 Pool of network sessions behind one connection (open options 'connection_pool_size' and 'connection_pool_max') */
+typedef struct tagDBXNETPOOL {
+   int            size;
+   int            max;
+   int            health_check;
+   int            generation;
+   int            no_sessions;
+   int            no_idle;
+   int            no_waiting;
+   unsigned long  acquired;
+   unsigned long  waits;
+   unsigned long  connects;
+   unsigned long  reconnects;
+   unsigned long  failures;
+   struct tagDBXCON *psess[DBX_NETPOOL_MAX];
+   struct tagDBXCON *pidle[DBX_NETPOOL_MAX];
+#if !defined(_WIN32)
+   pthread_mutex_t mutex;
+   pthread_cond_t cond;
+#endif
+} DBXNETPOOL, *PDBXNETPOOL;
+
+
 typedef struct tagDBXCON {
    short          open;
    short          dbtype;
@@ -1022,17 +1146,94 @@ typedef struct tagDBXCON {
    int            tlevel;
    void *         pthrt[YDB_MAX_TP];
 
+   int            pool_async; /* v2.5.35 */
+   void           *p_async;
+   int            pool_size;
+   int            pool_max;
+   int            pool_idle_timeout;
+   int            pool_stack_size;
+   int            pool_no_cpus;
+   int            pool_cpus[DBX_THREADPOOL_CPUS];
+
+   unsigned char  *recv_buf; /* v2.5.35 */
+   int            recv_buf_used;
+   int            recv_buf_pos;
+   int            net_pipeline;
+   int            pipe_broken;
+   int            pipe_depth;
+   int            pipe_depth_max;
+   unsigned long  pipe_turns;
+   struct tagDBXMETH *pipe_head;
+   struct tagDBXMETH *pipe_tail;
+#if !defined(_WIN32)
+   pthread_mutex_t pipe_mutex;
+#endif
+
+   int            net_pool_size; /* v2.5.35 */
+   int            net_pool_max;
+   int            net_health_check;
+   int            net_pool_functions;
+   int            net_generation;
+   int            net_tlevel;
+   time_t         net_last_used;
+   DBXNETPOOL     *p_netpool;
+   int            net_async;
+   void           *p_netuv;
+   int            buffer_zero_copy; /* v2.5.35 */
+   int            string_external;
+   int            typed;
+
 } DBXCON, *PDBXCON;
 
 
+/* v2.5.35 Per-request completion signal */
+typedef struct tagDBXDONE {
+   unsigned int   word;
+#if !defined(_WIN32) && !defined(LINUX)
+   pthread_mutex_t mutex;
+   pthread_cond_t cond;
+#endif
+} DBXDONE, *PDBXDONE;
+
+
 /* v2.1.17 */
+/* v2.5.35 Batch of global references processed in one crossing */
+typedef struct tagDBXBITEM {
+   int            command;
+   unsigned int   offset;
+   unsigned int   len;
+   int            argc;
+   int            rc;
+   unsigned int   ooffset;
+   unsigned int   olen;
+} DBXBITEM, *PDBXBITEM;
+
+
+typedef struct tagDBXBATCH {
+   int            command;
+   int            no_items;
+   int            no_alloc;
+   int            no_errors;
+   int            min_args;
+   DBXBITEM       *items;
+   unsigned int   obuffer_size;
+   unsigned int   obuffer_used;
+   char           *obuffer;
+   unsigned int   nbuffer_size;
+   unsigned char  *nbuffer;
+   char           error[DBX_ERROR_SIZE];
+} DBXBATCH, *PDBXBATCH;
+
+
 typedef struct tagDBXMETH {
    short          done;
    short          lock;
    short          increment;
+   short          typed; /* v2.5.35 */
    int            binary;
    int            argc;
    int            cargc;
+   int            args_hwm; /* v2.5.35 */
    unsigned int   ibuffer_size;
    unsigned int   ibuffer_used;
    unsigned char  *ibuffer;
@@ -1046,9 +1247,96 @@ typedef struct tagDBXMETH {
    int            (* p_dbxfun) (struct tagDBXMETH * pmeth);
    DBXCON         *pcon;
    DBXFUN         *pfun;
+   DBXBATCH       *pbatch; /* v2.5.35 */
+   DBXFREF        *pfref;
+   int            no_arg_store;
+   void           *arg_store[DBX_ARGSTORE_MAX];
+   DBXDONE        completion; /* v2.5.35 */
+   DBXDONE        pipe_turn;
+   struct tagDBXMETH *pipe_next;
+   void           *p_async;
+   void           *p_async_req;
+   void           *p_async_cb;
+   struct tagDBXMETH *p_async_next;
+   uv_write_t     net_write; /* v2.5.35 */
+   int            net_command;
+   char           net_error[DBX_ERROR_SIZE];
+   short          alloc_char16;
+   struct tagDBXMETH *p_free_next;
 } DBXMETH, *PDBXMETH;
 
 
+/* v2.5.35 Cache of reusable request objects (multithreaded mode) */
+typedef struct tagDBXMETHCACHE {
+   DBXMETH        *free[2];
+   int            no_free;
+   int            in_use;
+   int            hwm;
+   int            peak;
+   unsigned long  releases;
+   unsigned long  allocs;
+   unsigned long  reuses;
+   unsigned long  frees;
+   unsigned long  buffer_trims;
+   char           *obuffer_free[DBX_OBUFFER_CACHE_MAX];
+   int            no_obuffer_free;
+   unsigned long  obuffer_reuses;
+   unsigned long  buffers_detached;
+} DBXMETHCACHE, *PDBXMETHCACHE;
+
+
+/* v2.5.35 Queue of requests completed by the pool and waiting for the event loop */
+typedef struct tagDBXASYNC {
+   uv_async_t     handle;
+   int            pending;
+   int            ready;
+   int            delivering;
+   int            closing;
+   int            draining;
+   int            overflowing;
+   int            in_callback;
+   unsigned long  batches;
+   unsigned long  completions;
+   unsigned long  overflows;
+#if !defined(_WIN32)
+   pthread_mutex_t mutex;
+   pthread_cond_t drained;
+#endif
+   DBXMETH        *head;
+   DBXMETH        *tail;
+} DBXASYNC, *PDBXASYNC;
+
+
+/* v2.5.35 Network transport driven by the event loop (open option 'net_async') */
+typedef struct tagDBXNETUV {
+   uv_tcp_t       handle;
+   uv_timer_t     timer;
+   uv_work_t      open_req;
+   int            opening;
+   int            handles;
+   int            pending;
+   int            pending_max;
+   int            closing;
+   int            broken;
+   int            shutdown;
+   int            in_callback;
+   int            timeout;
+   int            generation;
+   uint64_t       last_activity;
+   unsigned long  sent;
+   unsigned long  received;
+   unsigned long  reads;
+   unsigned int   rbuf_size;
+   unsigned int   rbuf_used;
+   unsigned char  *rbuf;
+   char           error[DBX_ERROR_SIZE];
+   DBXCON         *pcon;
+   DBXCON         *psess;
+   DBXMETH        *head;
+   DBXMETH        *tail;
+} DBXNETUV, *PDBXNETUV;
+
+
 typedef struct tagDBXQR {
    ydb_buffer_t   global_name;
    DBXVAL         global_name16;
@@ -1065,33 +1353,109 @@ typedef struct tagDBXQR {
 } DBXQR, *PDBXQR;
 
 
+/* v2.5.35 A detached output buffer holding the contents of an external one-byte string */
+class DBXEXTSTR : public v8::String::ExternalOneByteStringResource
+{
+public:
+   DBXEXTSTR(char *data, size_t len, size_t size) : data_addr(data), data_len(len), data_size(size) {}
+   ~DBXEXTSTR();
+
+   const char *   data                    () const { return data_addr; }
+   size_t         length                  () const { return data_len; }
+
+private:
+   char           *data_addr;
+   size_t         data_len;
+   size_t         data_size;
+};
+
+
 struct dbx_pool_task {
 #if !defined(_WIN32)
    pthread_t   parent_tid;
 #endif
    int         task_id;
    DBXMETH     *pmeth;
-   struct dbx_pool_task *next;
+   unsigned long sequence; /* v2.5.35 */
 };
 
 
+/* v2.5.35 Bounded MPMC ring of preallocated task slots */
+typedef struct tagDBXTASKQ {
+   unsigned long  mask;
+   char           pad0[64];
+   unsigned long  enqueue_pos;
+   char           pad1[64];
+   unsigned long  dequeue_pos;
+   char           pad2[64];
+   unsigned int   wake_seq;
+   int            idle_threads;
+   unsigned long  enqueued;
+   unsigned long  dequeued;
+   unsigned long  max_depth;
+   unsigned long  enqueue_retries;
+   unsigned long  dequeue_retries;
+   unsigned long  queue_full;
+   unsigned long  parks;
+   unsigned long  wakeups;
+   unsigned long  completions;
+   unsigned long  completion_waits;
+   unsigned long  completion_wakeups;
+   struct dbx_pool_task slot[DBX_TASK_QUEUE_SIZE];
+} DBXTASKQ, *PDBXTASKQ;
+
+
 /* v2.3.25 */
+/* v2.5.35 Requests are handed to the TP thread through a pair of completion words (spin then futex) */
 typedef struct tagDBXTHRT {
    int         context;
-   int         done;
+   int         spin;
 #if !defined(_WIN32)
    pthread_t   parent_tid;
    pthread_t   tp_tid;
-   pthread_mutex_t req_cv_mutex;
-   pthread_cond_t req_cv;
-   pthread_mutex_t res_cv_mutex;
-   pthread_cond_t res_cv;
+   DBXDONE     req;
+   DBXDONE     res;
 #endif
    int         task_id;
    DBXMETH     *pmeth;
 } DBXTHRT, *PDBXTHRT;
 
 
+/* v2.5.35 db.benchmark(): measurements of mg-dbx internals */
+#define DBX_BENCH_MAX            16
+#define DBX_BENCH_THREADS        64
+
+typedef struct tagDBXBENCHT {
+   int            count;
+   int            flag;
+   DBXMETH        *pmeth;
+   struct tagDBXBENCH *pbench;
+#if !defined(_WIN32)
+   pthread_t      tid;
+#endif
+} DBXBENCHT, *PDBXBENCHT;
+
+
+typedef struct tagDBXBENCH {
+   char           test[32];
+   int            requests;
+   int            threads;
+   int            size;
+   DBXCON         *pcon;
+#if !defined(_WIN32)
+   int            broadcast;
+   unsigned long  wakeups;
+   pthread_mutex_t mutex;
+   pthread_cond_t cond;
+#endif
+   DBXBENCHT      thr[DBX_BENCH_THREADS];
+   int            no_results;
+   char           name[DBX_BENCH_MAX][32];
+   double         value[DBX_BENCH_MAX];
+   char           error[DBX_ERROR_SIZE];
+} DBXBENCH, *PDBXBENCH;
+
+
 class DBX_DBNAME : public node::ObjectWrap
 {
 public:
@@ -1118,6 +1482,8 @@ public:
       void *                        gx;
       void *                        cx;
       void *                        clx;
+      void *                        bx; /* v2.5.35 */
+      void *                        fx;
       v8::Local<v8::String>         result_str;
       v8::Local<v8::Object>         result_obj;
       v8::Persistent<v8::Function>  cb;
@@ -1144,6 +1510,7 @@ public:
    static async_rtn              dbx_uv_close_callback            (uv_work_t *req);
    static async_rtn              dbx_invoke_callback              (uv_work_t *req);
    static async_rtn              dbx_invoke_callback_sql_execute  (uv_work_t *req);
+   static async_rtn              dbx_invoke_callback_batch        (uv_work_t *req);
 
    static void                   About                            (const v8::FunctionCallbackInfo<v8::Value>& args);
    static void                   Version                          (const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -1162,6 +1529,11 @@ public:
    static void                   Get                              (const v8::FunctionCallbackInfo<v8::Value>& args);
    static void                   Get_bx                           (const v8::FunctionCallbackInfo<v8::Value>& args);
    static void                   GetEx                            (const v8::FunctionCallbackInfo<v8::Value>& args, int binary);
+   static int                    BatchReference                   (DBX_DBNAME *c, const v8::FunctionCallbackInfo<v8::Value>& args, DBXMETH *pmeth, DBXBATCH *pbatch, v8::Local<v8::Array> ref, int argc);
+   static void                   GetMany                          (const v8::FunctionCallbackInfo<v8::Value>& args);
+   static void                   SetMany                          (const v8::FunctionCallbackInfo<v8::Value>& args);
+   static void                   Batch                            (const v8::FunctionCallbackInfo<v8::Value>& args);
+   static void                   BatchEx                          (const v8::FunctionCallbackInfo<v8::Value>& args, int command);
    static void                   Set                              (const v8::FunctionCallbackInfo<v8::Value>& args);
    static void                   Defined                          (const v8::FunctionCallbackInfo<v8::Value>& args);
    static void                   Delete                           (const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -1173,6 +1545,8 @@ public:
    static void                   Sleep                            (const v8::FunctionCallbackInfo<v8::Value>& args);
    static void                   MGlobal                          (const v8::FunctionCallbackInfo<v8::Value>& args);
    static void                   MGlobal_Close                    (const v8::FunctionCallbackInfo<v8::Value>& args);
+   static void                   MBulk                            (const v8::FunctionCallbackInfo<v8::Value>& args);
+   static void                   MFunction                        (const v8::FunctionCallbackInfo<v8::Value>& args);
    static void                   MGlobalQuery                     (const v8::FunctionCallbackInfo<v8::Value>& args);
    static void                   MGlobalQuery_Close               (const v8::FunctionCallbackInfo<v8::Value>& args);
    static int                    ExtFunctionReference             (DBX_DBNAME *c, const v8::FunctionCallbackInfo<v8::Value>& args, DBXMETH *pmeth, DBXFREF *pfref, DBXFUN *pfun, short context);
@@ -1192,6 +1566,8 @@ public:
    static void                   TRollback                        (const v8::FunctionCallbackInfo<v8::Value>& args);
 
    static void                   Benchmark                        (const v8::FunctionCallbackInfo<v8::Value>& args);
+   static void                   PoolStats                        (const v8::FunctionCallbackInfo<v8::Value>& args);
+   static void                   MemoryStats                      (const v8::FunctionCallbackInfo<v8::Value>& args);
 
 private:
 
@@ -1202,6 +1578,22 @@ private:
 DBXMETH *                  dbx_request_memory            (DBXCON *pcon, short allow_char16, short context);
 DBXMETH *                  dbx_request_memory_alloc      (DBXCON *pcon, short alloc_char16, short context);
 int                        dbx_request_memory_free       (DBXCON *pcon, DBXMETH *pmeth, short context);
+DBXMETH *                  dbx_request_memory_get        (DBXCON *pcon, short alloc_char16);
+int                        dbx_request_memory_release    (DBXMETH *pmeth);
+int                        dbx_request_memory_destroy    (DBXMETH *pmeth);
+char *                     dbx_obuffer_get               (void);
+void                       dbx_obuffer_release           (char *data, void *hint);
+#if DBX_NODE_VERSION >= 140000
+void                       dbx_obuffer_delete            (void *data, size_t length, void *deleter_data);
+#endif
+v8::Local<v8::Object>      dbx_new_buffer                (v8::Isolate * isolate, DBXMETH *pmeth);
+
+DBXBATCH *                 dbx_batch_alloc               (int command, int no_items, int min_args);
+int                        dbx_batch_reset               (DBXBATCH *pbatch);
+int                        dbx_batch_free                (DBXBATCH *pbatch);
+int                        dbx_batch_command             (char *name, int *min_args);
+int                        dbx_batch_add_result          (DBXBATCH *pbatch, int item, char *data, int len, int rc, char *error);
+v8::Local<v8::Value>       dbx_batch_result              (v8::Isolate *isolate, DBXCON *pcon, DBXBATCH *pbatch);
 
 #if DBX_NODE_VERSION >= 100000
 void                       dbx_set_prototype_method      (v8::Local<v8::FunctionTemplate> t, v8::FunctionCallback callback, const char* name, const char* data);
@@ -1215,14 +1607,23 @@ int                        dbx_string16_length           (v8::Isolate * isolate,
 v8::Local<v8::String>      dbx_new_string8               (v8::Isolate * isolate, char * buffer, int utf8);
 v8::Local<v8::String>      dbx_new_string16              (v8::Isolate * isolate, unsigned short * buffer);
 v8::Local<v8::String>      dbx_new_string8n              (v8::Isolate * isolate, char * buffer, unsigned long len, int utf8);
+v8::Local<v8::String>      dbx_new_string8v              (v8::Isolate * isolate, DBXMETH *pmeth, int utf8);
+int                        dbx_is_ascii                  (char * buffer, size_t len);
+int                        dbx_number_int64              (double d, long long *pi64);
+v8::Local<v8::Value>       dbx_new_number                (v8::Isolate * isolate, DBXMETH *pmeth);
 v8::Local<v8::String>      dbx_new_string16n             (v8::Isolate * isolate, unsigned short * buffer, unsigned long len);
 int                        dbx_write_char8               (v8::Isolate * isolate, v8::Local<v8::String> str, char * buffer, int buffer_size, int utf8);
 int                        dbx_write_char16              (v8::Isolate * isolate, v8::Local<v8::String> str, unsigned short * buffer);
 
 int                        dbx_ibuffer_add               (DBXMETH *pmeth, v8::Isolate * isolate, int argn, v8::Local<v8::String> str, void * pbuffer, int buffer_len, short char16, short context);
 int                        dbx_ibuffer16_add             (DBXMETH *pmeth, v8::Isolate * isolate, int argn, v8::Local<v8::String> str, void * pbuffer, int buffer_len, short char16, short context);
+int                        dbx_ibuffer_add_buffer        (DBXMETH *pmeth, v8::Isolate * isolate, int argn, v8::Local<v8::Object> obj, short context);
+int                        dbx_arg_store_release         (DBXMETH *pmeth);
 int                        dbx_cursor_init               (void *pcx);
 int                        dbx_global_reset              (const v8::FunctionCallbackInfo<v8::Value>& args, v8::Isolate * isolate, DBXCON *pcon, DBXMETH *pmeth, void *pgx, int argc_offset, short context);
+int                        dbx_gprefix_save              (DBXMETH *pmeth, DBXGPREFIX **pprefix, int argc);
+int                        dbx_gprefix_restore           (DBXMETH *pmeth, DBXGPREFIX *pprefix);
+int                        dbx_gprefix_free              (DBXGPREFIX **pprefix);
 int                        dbx_cursor_reset              (const v8::FunctionCallbackInfo<v8::Value>& args, v8::Isolate * isolate, DBXCON *pcon, DBXMETH *pmeth, void *pcx, int argc_offset, short context);
 
 int                        isc_load_library              (DBXCON *pcon);
@@ -1267,7 +1668,11 @@ int                        dbx_reference                 (DBXMETH *pmeth, int n)
 int                        dbx_global_reference          (DBXMETH *pmeth);
 
 int                        dbx_get                       (DBXMETH *pmeth);
+int                        dbx_batch_reference           (DBXMETH *pmeth, DBXBITEM *pitem);
+int                        dbx_getmany                   (DBXMETH *pmeth);
+int                        dbx_batch                     (DBXMETH *pmeth);
 int                        dbx_set                       (DBXMETH *pmeth);
+int                        dbx_setmany                   (DBXMETH *pmeth);
 int                        dbx_defined                   (DBXMETH *pmeth);
 int                        dbx_delete                    (DBXMETH *pmeth);
 int                        dbx_next                      (DBXMETH *pmeth);
@@ -1281,6 +1686,7 @@ int                        dbx_tlevel                    (DBXMETH *pmeth);
 int                        dbx_tcommit                   (DBXMETH *pmeth);
 int                        dbx_trollback                 (DBXMETH *pmeth);
 int                        dbx_function_reference        (DBXMETH *pmeth, DBXFUN *pfun);
+int                        dbx_function_prepare          (DBXMETH *pmeth, DBXFUN *pfun);
 int                        dbx_function                  (DBXMETH *pmeth);
 int                        dbx_class_reference           (DBXMETH *pmeth, int optype);
 int                        dbx_classmethod               (DBXMETH *pmeth);
@@ -1305,12 +1711,44 @@ LPTHREAD_START_ROUTINE     dbx_thread_main               (LPVOID pargs);
 void *                     dbx_thread_main               (void *pargs);
 #endif
 
-struct dbx_pool_task *     dbx_pool_add_task             (DBXMETH *pmeth);
-struct dbx_pool_task *     dbx_pool_get_task             (void);
+void                       dbx_pool_queue_init           (void);
+int                        dbx_pool_add_task             (DBXMETH *pmeth);
+int                        dbx_pool_add_task_ex          (DBXMETH *pmeth, int wait);
+int                        dbx_pool_get_task             (struct dbx_pool_task *task);
+int                        dbx_pool_park                 (unsigned int wake_seq, int timeout);
+void                       dbx_pool_wake                 (void);
 void                       dbx_pool_execute_task         (struct dbx_pool_task *task, int thread_id);
 void *                     dbx_pool_requests_loop        (void *data);
 int                        dbx_pool_thread_init          (DBXCON *pcon, int num_threads);
+int                        dbx_pool_retire               (DBXTID *ptid);
+int                        dbx_pool_thread_create        (DBXCON *pcon);
+int                        dbx_pool_grow                 (DBXCON *pcon);
 int                        dbx_pool_submit_task          (DBXMETH *pmeth);
+int                        dbx_async_init                (DBXCON *pcon, uv_loop_t *loop);
+int                        dbx_async_close               (DBXCON *pcon);
+int                        dbx_async_drain               (DBXCON *pcon);
+int                        dbx_async_submit_task         (DBXMETH *pmeth, void *req, void *after_work_cb);
+int                        dbx_async_complete            (DBXMETH *pmeth);
+int                        dbx_async_overflow_done       (DBXCON *pcon);
+void                       dbx_async_callback            (uv_async_t *handle);
+void                       dbx_async_close_callback      (uv_handle_t *handle);
+int                        dbx_completion_init           (DBXDONE *pdone);
+int                        dbx_completion_destroy        (DBXDONE *pdone);
+int                        dbx_completion_signal         (DBXDONE *pdone);
+int                        dbx_completion_wait           (DBXDONE *pdone, int timeout);
+int                        dbx_completion_wait_spin      (DBXDONE *pdone, int spin, int timeout);
+unsigned long long         dbx_benchmark_clock           (void);
+int                        dbx_benchmark_add             (DBXBENCH *pbench, char *name, double value);
+int                        dbx_benchmark_completion      (DBXBENCH *pbench);
+int                        dbx_benchmark_request         (DBXBENCH *pbench, v8::Isolate * isolate);
+int                        dbx_benchmark_string          (DBXBENCH *pbench, v8::Isolate * isolate);
+int                        dbx_benchmark_nop             (DBXMETH *pmeth);
+int                        dbx_benchmark_broadcast       (DBXMETH *pmeth);
+#if defined(_WIN32)
+LPTHREAD_START_ROUTINE     dbx_benchmark_submitter       (LPVOID pargs);
+#else
+void *                     dbx_benchmark_submitter       (void *pargs);
+#endif
 int                        dbx_add_block_size            (unsigned char *block, unsigned long offset, unsigned long data_len, int dsort, int dtype);
 unsigned long              dbx_get_block_size            (unsigned char *block, unsigned long offset, int *dsort, int *dtype);
 int                        dbx_set_size                  (unsigned char *str, unsigned long data_len);
@@ -1319,6 +1757,7 @@ void *                     dbx_realloc                   (void *p, int curr_size
 void *                     dbx_malloc                    (int size, short id);
 int                        dbx_free                      (void *p, short id);
 DBXQR *                    dbx_alloc_dbxqr               (DBXQR *pqr, int dsize, short alloc_char16, short context);
+int                        dbx_dbxqr_data_size           (DBXQR *pqr, unsigned int len);
 int                        dbx_free_dbxqr                (DBXQR *pqr);
 int                        dbx_ucase                     (char *string);
 int                        dbx_lcase                     (char *string);
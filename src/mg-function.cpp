@@ -0,0 +1,325 @@
+/*
+   ----------------------------------------------------------------------------
+   | mg-dbx.node                                                              |
+   | Author: Chris Munt cmunt@mgateway.com                                    |
+   |                    chris.e.munt@gmail.com                                |
+   | Copyright (c) 2019-2026 MGateway Ltd                                     |
+   | Surrey UK.                                                               |
+   | All rights reserved.                                                     |
+   |                                                                          |
+   | http://www.mgateway.com                                                  |
+   |                                                                          |
+   | Licensed under the Apache License, Version 2.0 (the "License"); you may  |
+   | not use this file except in compliance with the License.                 |
+   | You may obtain a copy of the License at                                  |
+   |                                                                          |
+   | http://www.apache.org/licenses/LICENSE-2.0                               |
+   |                                                                          |
+   | Unless required by applicable law or agreed to in writing, software      |
+   | distributed under the License is distributed on an "AS IS" BASIS,        |
+   | WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. |
+   | See the License for the specific language governing permissions and      |
+   | limitations under the License.                                           |
+   |                                                                          |
+   ----------------------------------------------------------------------------
+*/
+
+
+#include "mg-dbx.h"
+#include "mg-function.h"
+ 
+using namespace v8;
+using namespace node;
+
+Persistent<Function> mfunction::constructor;
+
+mfunction::mfunction(int value) : dbx_count(value)
+{
+}
+
+
+mfunction::~mfunction()
+{
+}
+
+
+#if DBX_NODE_VERSION >= 100000
+void mfunction::Init(Local<Object> exports)
+#else
+void mfunction::Init(Handle<Object> exports)
+#endif
+{
+#if DBX_NODE_VERSION >= 120000
+#if DBX_NODE_VERSION >= 250000
+   Isolate* isolate = Isolate::GetCurrent();
+#else
+   Isolate* isolate = exports->GetIsolate();
+#endif
+   Local<Context> icontext = isolate->GetCurrentContext();
+
+   Local<FunctionTemplate> tpl = FunctionTemplate::New(isolate, New);
+   tpl->SetClassName(String::NewFromUtf8(isolate, (char *) "mfunction", NewStringType::kNormal).ToLocalChecked());
+   tpl->InstanceTemplate()->SetInternalFieldCount(3);
+#else
+   Isolate* isolate = Isolate::GetCurrent();
+
+   /* Prepare constructor template */
+   Local<FunctionTemplate> tpl = FunctionTemplate::New(isolate, New);
+   tpl->SetClassName(String::NewFromUtf8(isolate, "mfunction"));
+   tpl->InstanceTemplate()->SetInternalFieldCount(3);
+#endif
+
+   /* Prototypes */
+
+   DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "call", Call);
+   DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "call_bx", Call_bx);
+
+#if DBX_NODE_VERSION >= 120000
+   constructor.Reset(isolate, tpl->GetFunction(icontext).ToLocalChecked());
+   exports->Set(icontext, String::NewFromUtf8(isolate, "mfunction", NewStringType::kNormal).ToLocalChecked(), tpl->GetFunction(icontext).ToLocalChecked()).FromJust();
+#else
+   constructor.Reset(isolate, tpl->GetFunction());
+#endif
+
+}
+
+
+void mfunction::New(const FunctionCallbackInfo<Value>& args)
+{
+   Isolate* isolate = args.GetIsolate();
+#if DBX_NODE_VERSION >= 100000
+   Local<Context> icontext = isolate->GetCurrentContext();
+#endif
+   HandleScope scope(isolate);
+   int fc, mn, argc, otype;
+   DBX_DBNAME *c = NULL;
+   Local<Object> obj;
+
+   argc = args.Length();
+   if (argc > 0) {
+      obj = dbx_is_object(args[0], &otype);
+      if (otype) {
+         fc = obj->InternalFieldCount();
+         if (fc == 3) {
+#if DBX_NODE_VERSION >= 220000
+            mn = obj->GetInternalField(2).As<v8::Value>().As<v8::External>()->Int32Value(icontext).FromJust();
+#else
+            mn = DBX_INT32_VALUE(obj->GetInternalField(2));
+#endif
+            if (mn == DBX_MAGIC_NUMBER) {
+               c = ObjectWrap::Unwrap<DBX_DBNAME>(obj);
+            }
+         }
+      }
+   }
+
+   if (args.IsConstructCall()) {
+      /* Invoked as constructor: `new mfunction(db, "label^routine")` */
+      mfunction * obj = new mfunction(0);
+      obj->c = NULL;
+      obj->function_name[0] = '\0';
+      obj->function_name16[0] = 0;
+      memset((void *) &(obj->fref), 0, sizeof(DBXFREF));
+
+      if (c) {
+         if (c->pcon == NULL) {
+            isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "No Connection to the database", 1)));
+            return;
+         }
+         obj->c = c;
+         if (argc < 2 || mfunction::set_function(obj, isolate, args[1]) < 0) {
+            isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "Missing or invalid function name on mfunction::New()", 1)));
+            return;
+         }
+      }
+
+      obj->Wrap(args.This());
+      args.This()->SetInternalField(2, DBX_INTEGER_NEW(DBX_MAGIC_NUMBER_MFUNCTION));
+      args.GetReturnValue().Set(args.This());
+   }
+   else {
+      /* Invoked as plain function `mfunction(...)`, turn into construct call. */
+      const int argc = 1;
+      Local<Value> argv[argc] = { args[0] };
+      Local<Function> cons = Local<Function>::New(isolate, constructor);
+      args.GetReturnValue().Set(cons->NewInstance(isolate->GetCurrentContext(), argc, argv).ToLocalChecked());
+   }
+
+}
+
+
+mfunction * mfunction::NewInstance(const FunctionCallbackInfo<Value>& args)
+{
+   Isolate* isolate = args.GetIsolate();
+   Local<Context> icontext = isolate->GetCurrentContext();
+   HandleScope scope(isolate);
+
+   /* the dbx object and function name are attached by the caller */
+   Local<Function> cons = Local<Function>::New(isolate, constructor);
+   Local<Object> instance = cons->NewInstance(icontext, 0, NULL).ToLocalChecked(); /* Invoke mfunction::New */
+ 
+   mfunction *fx = ObjectWrap::Unwrap<mfunction>(instance);
+
+   args.GetReturnValue().Set(instance);
+
+   return fx;
+}
+
+
+/* Hold the function reference (label^routine) in both 8-bit and 16-bit form: it is parsed on first use */
+int mfunction::set_function(mfunction *fx, Isolate * isolate, Local<Value> name)
+{
+   int len, len16;
+   Local<String> str;
+#if DBX_NODE_VERSION >= 100000
+   Local<Context> icontext = isolate->GetCurrentContext();
+#endif
+
+   if (!name->IsString()) {
+      return -1;
+   }
+   str = DBX_TO_STRING(name);
+   len = dbx_string8_length(isolate, str, fx->c->pcon->utf8);
+   len16 = dbx_string16_length(isolate, str);
+   if (len < 1 || len >= (int) sizeof(fx->function_name) || len16 >= (int) (sizeof(fx->function_name16) / sizeof(unsigned short))) {
+      return -1;
+   }
+
+   dbx_write_char8(isolate, str, fx->function_name, sizeof(fx->function_name), fx->c->pcon->utf8);
+   fx->function_name[len] = '\0';
+   dbx_write_char16(isolate, str, fx->function_name16);
+   fx->function_name16[len16] = 0;
+
+   memset((void *) &(fx->fref), 0, sizeof(DBXFREF));
+   fx->fref.function = fx->function_name;
+   fx->fref.function_len = len;
+   fx->fref.function16 = fx->function_name16;
+   fx->fref.function16_len = len16;
+   fx->fref.pfun = &(fx->fun);
+
+   return 0;
+}
+
+
+int mfunction::async_callback(mfunction *fx)
+{
+   fx->Unref();
+   return 0;
+}
+
+
+void mfunction::Call(const FunctionCallbackInfo<Value>& args)
+{
+   return CallEx(args, 0);
+}
+
+
+void mfunction::Call_bx(const FunctionCallbackInfo<Value>& args)
+{
+   return CallEx(args, 1);
+}
+
+
+void mfunction::CallEx(const FunctionCallbackInfo<Value>& args, int binary)
+{
+   short async;
+   int rc;
+   DBXCON *pcon;
+   DBXMETH *pmeth;
+   DBXFUN fun;
+   Local<String> result;
+   mfunction *fx = ObjectWrap::Unwrap<mfunction>(args.This());
+   MG_FUNCTION_CHECK_CLASS(fx);
+   DBX_DBNAME *c = fx->c;
+   DBX_GET_ISOLATE;
+   fx->dbx_count ++;
+
+   pcon = c->pcon;
+   if (pcon->log_functions) {
+      c->LogFunction(c, args, (void *) fx, (char *) "mfunction::call");
+   }
+   pmeth = dbx_request_memory(pcon, 1, 0);
+
+   pmeth->binary = binary;
+   pmeth->typed = pcon->typed;
+
+   DBX_CALLBACK_FUN(pmeth->argc, async);
+
+   if ((pmeth->argc + 1) >= DBX_MAXARGS) {
+      isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "Too many arguments on mfunction::call", 1)));
+      dbx_request_memory_free(pcon, pmeth, 0);
+      return;
+   }
+
+   DBX_DBFUN_START(c, pcon, pmeth);
+
+   /* the function reference occupies the first slot: arguments follow it */
+   rc = c->ExtFunctionReference(c, args, pmeth, &(fx->fref), &fun, (async || pcon->net_connection));
+   pmeth->argc ++;
+
+   if (pcon->log_transmissions) {
+      dbx_log_transmission(pcon, pmeth, (char *) "mfunction::call");
+   }
+
+   if (async) {
+      DBX_DBNAME::dbx_baton_t *baton = c->dbx_make_baton(c, pmeth);
+      baton->fx = (void *) fx;
+      baton->isolate = isolate;
+      baton->pmeth->p_dbxfun = (int (*) (struct tagDBXMETH * pmeth)) dbx_function;
+      Local<Function> cb = Local<Function>::Cast(args[pmeth->argc - 1]);
+      baton->cb.Reset(isolate, cb);
+      fx->Ref();
+      if (c->dbx_queue_task((void *) c->dbx_process_task, (void *) c->dbx_invoke_callback, baton, 0)) {
+         char error[DBX_ERROR_SIZE];
+         T_STRCPY(error, _dbxso(error), pcon->error);
+         c->dbx_destroy_baton(baton, pmeth);
+         isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, error, 1)));
+         dbx_request_memory_free(pcon, pmeth, 0);
+         return;
+      }
+      return;
+   }
+
+   if (pcon->net_connection) {
+      rc = dbx_function(pmeth);
+   }
+   else if (pcon->dbtype == DBX_DBTYPE_YOTTADB) {
+      rc = ydb_function(pmeth, &fun);
+   }
+   else {
+      rc = pcon->p_isc_so->p_CacheExtFun(fun.rflag, pmeth->argc - 1);
+      if (rc == CACHE_SUCCESS) {
+         isc_pop_value(pmeth, &(pmeth->output_val), DBX_DTYPE_STR);
+      }
+   }
+
+   if (rc != CACHE_SUCCESS) {
+      dbx_error_message(pmeth, rc);
+      if (pcon->error_mode == 1) {
+         isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) pcon->error, 1)));
+      }
+   }
+
+   DBX_DBFUN_END(c);
+   DBX_DB_UNLOCK();
+
+   if (pcon->log_transmissions == 2) {
+      dbx_log_response(pcon, (char *) pmeth->output_val.svalue.buf_addr, (int) pmeth->output_val.svalue.len_used, (char *) "mfunction::call");
+   }
+
+   if (binary) {
+      Local<Object> bx = dbx_new_buffer(isolate, pmeth);
+      args.GetReturnValue().Set(bx);
+   }
+   else if (pmeth->typed && DBX_DTYPE_NUMERIC(pmeth->output_val.type)) {
+      args.GetReturnValue().Set(dbx_new_number(isolate, pmeth));
+   }
+   else {
+      result = pcon->utf16 ? dbx_new_string16n(isolate, pmeth->output_val.cvalue.buf16_addr, pmeth->output_val.cvalue.len_used) : dbx_new_string8v(isolate, pmeth, pcon->utf8);
+      args.GetReturnValue().Set(result);
+   }
+   dbx_request_memory_free(pcon, pmeth, 0);
+
+   return;
+}
+
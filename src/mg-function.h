@@ -0,0 +1,75 @@
+/*
+   ----------------------------------------------------------------------------
+   | mg-dbx.node                                                              |
+   | Author: Chris Munt cmunt@mgateway.com                                    |
+   |                    chris.e.munt@gmail.com                                |
+   | Copyright (c) 2019-2026 MGateway Ltd                                     |
+   | Surrey UK.                                                               |
+   | All rights reserved.                                                     |
+   |                                                                          |
+   | http://www.mgateway.com                                                  |
+   |                                                                          |
+   | Licensed under the Apache License, Version 2.0 (the "License"); you may  |
+   | not use this file except in compliance with the License.                 |
+   | You may obtain a copy of the License at                                  |
+   |                                                                          |
+   | http://www.apache.org/licenses/LICENSE-2.0                               |
+   |                                                                          |
+   | Unless required by applicable law or agreed to in writing, software      |
+   | distributed under the License is distributed on an "AS IS" BASIS,        |
+   | WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. |
+   | See the License for the specific language governing permissions and      |
+   | limitations under the License.                                           |
+   |                                                                          |
+   ----------------------------------------------------------------------------
+*/
+
+
+#ifndef MG_FUNCTION_H
+#define MG_FUNCTION_H
+
+#define MG_FUNCTION_CHECK_CLASS(a) \
+   if (a->c == NULL) { \
+      v8::Isolate* isolatex = args.GetIsolate(); \
+      isolatex->ThrowException(v8::Exception::Error(dbx_new_string8(isolatex, (char *) "Error in the instantiation of the mfunction class", 1))); \
+      return; \
+   } \
+
+/* v2.5.35 Prepared function: the label^routine reference is parsed (and, for YottaDB, the call-in resolved) once */
+class mfunction : public node::ObjectWrap
+{
+public:
+
+   int            dbx_count;
+   char           function_name[128];
+   unsigned short function_name16[128];
+   DBXFREF        fref;
+   DBXFUN         fun;
+   DBX_DBNAME     *c;
+
+   static v8::Persistent<v8::Function>       constructor;
+
+#if DBX_NODE_VERSION >= 100000
+   static void       Init                    (v8::Local<v8::Object> exports);
+#else
+   static void       Init                    (v8::Handle<v8::Object> exports);
+#endif
+   explicit          mfunction               (int value = 0);
+                     ~mfunction              ();
+
+   static mfunction * NewInstance            (const v8::FunctionCallbackInfo<v8::Value>& args);
+   static int        set_function            (mfunction *fx, v8::Isolate * isolate, v8::Local<v8::Value> name);
+   static int        async_callback          (mfunction *fx);
+
+   static void       Call        (const v8::FunctionCallbackInfo<v8::Value>& args);
+   static void       Call_bx     (const v8::FunctionCallbackInfo<v8::Value>& args);
+   static void       CallEx      (const v8::FunctionCallbackInfo<v8::Value>& args, int binary);
+
+private:
+
+   static void       New         (const v8::FunctionCallbackInfo<v8::Value>& args);
+};
+
+
+#endif
+
@@ -34,6 +34,7 @@ Persistent<Function> mglobal::constructor;
 
 mglobal::mglobal(int value) : dbx_count(value)
 {
+   pprefix = NULL; /* v2.5.35 */
 }
 
 
@@ -88,6 +89,8 @@ void mglobal::Init(Handle<Object> exports)
    DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "lock", Lock);
    DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "unlock", Unlock);
    DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "merge", Merge);
+   DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "getdocument", GetDocument); /* v2.5.35 */
+   DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "setdocument", SetDocument);
    DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "reset", Reset);
    DBX_NODE_SET_PROTOTYPE_METHOD(tpl, "_close", Close);
 
@@ -220,6 +223,7 @@ int mglobal::async_callback(mglobal *gx)
 
 int mglobal::delete_mglobal_template(mglobal *gx)
 {
+   dbx_gprefix_free(&(gx->pprefix)); /* v2.5.35 */
    return 0;
 }
 
@@ -257,11 +261,13 @@ void mglobal::GetEx(const FunctionCallbackInfo<Value>& args, int binary)
    pmeth = dbx_request_memory(pcon, 1, 0);
 
    pmeth->binary = binary;
+   pmeth->typed = pcon->typed; /* v2.5.35 */
    gref.global = gx->global_name;
    gref.global_len = gx->global_name_len;
    gref.global16 = gx->global_name16;
    gref.global16_len = gx->global_name16_len;
    gref.pkey = gx->pkey;
+   gref.pprefix = &(gx->pprefix); /* v2.5.35 */
 
    DBX_CALLBACK_FUN(pmeth->argc, async);
 
@@ -337,11 +343,14 @@ void mglobal::GetEx(const FunctionCallbackInfo<Value>& args, int binary)
    }
 
    if (binary) {
-      Local<Object> bx = node::Buffer::New(isolate, (char *) pmeth->output_val.svalue.buf_addr, (size_t) pmeth->output_val.svalue.len_used).ToLocalChecked();
+      Local<Object> bx = dbx_new_buffer(isolate, pmeth);
       args.GetReturnValue().Set(bx);
    }
+   else if (pmeth->typed && DBX_DTYPE_NUMERIC(pmeth->output_val.type)) { /* v2.5.35 */
+      args.GetReturnValue().Set(dbx_new_number(isolate, pmeth));
+   }
    else {
-      result = pcon->utf16 ? dbx_new_string16n(isolate, pmeth->output_val.cvalue.buf16_addr, pmeth->output_val.cvalue.len_used) : dbx_new_string8n(isolate, pmeth->output_val.svalue.buf_addr, pmeth->output_val.svalue.len_used, pcon->utf8);
+      result = pcon->utf16 ? dbx_new_string16n(isolate, pmeth->output_val.cvalue.buf16_addr, pmeth->output_val.cvalue.len_used) : dbx_new_string8v(isolate, pmeth, pcon->utf8);
       args.GetReturnValue().Set(result);
    }
    dbx_request_memory_free(pcon, pmeth, 0);
@@ -374,6 +383,7 @@ void mglobal::Set(const FunctionCallbackInfo<Value>& args)
    gref.global16 = gx->global_name16;
    gref.global16_len = gx->global_name16_len;
    gref.pkey = gx->pkey;
+   gref.pprefix = &(gx->pprefix); /* v2.5.35 */
 
    DBX_CALLBACK_FUN(pmeth->argc, async);
 
@@ -447,7 +457,7 @@ void mglobal::Set(const FunctionCallbackInfo<Value>& args)
       dbx_log_response(pcon, (char *) pmeth->output_val.svalue.buf_addr, (int) pmeth->output_val.svalue.len_used, (char *) "mglobal::set");
    }
 
-   result = dbx_new_string8n(isolate, pmeth->output_val.svalue.buf_addr, pmeth->output_val.svalue.len_used, pcon->utf8);
+   result = dbx_new_string8v(isolate, pmeth, pcon->utf8);
    args.GetReturnValue().Set(result);
    dbx_request_memory_free(pcon, pmeth, 0);
    return;
@@ -479,6 +489,7 @@ void mglobal::Defined(const FunctionCallbackInfo<Value>& args)
    gref.global16 = gx->global_name16;
    gref.global16_len = gx->global_name16_len;
    gref.pkey = gx->pkey;
+   gref.pprefix = &(gx->pprefix); /* v2.5.35 */
 
    DBX_CALLBACK_FUN(pmeth->argc, async);
 
@@ -551,7 +562,7 @@ void mglobal::Defined(const FunctionCallbackInfo<Value>& args)
       dbx_log_response(pcon, (char *) pmeth->output_val.svalue.buf_addr, (int) pmeth->output_val.svalue.len_used, (char *) "mglobal::defined");
    }
 
-   result = dbx_new_string8n(isolate, pmeth->output_val.svalue.buf_addr, pmeth->output_val.svalue.len_used, pcon->utf8);
+   result = dbx_new_string8v(isolate, pmeth, pcon->utf8);
    args.GetReturnValue().Set(result);
    dbx_request_memory_free(pcon, pmeth, 0);
    return;
@@ -583,6 +594,7 @@ void mglobal::Delete(const FunctionCallbackInfo<Value>& args)
    gref.global16 = gx->global_name16;
    gref.global16_len = gx->global_name16_len;
    gref.pkey = gx->pkey;
+   gref.pprefix = &(gx->pprefix); /* v2.5.35 */
 
    DBX_CALLBACK_FUN(pmeth->argc, async);
 
@@ -655,7 +667,7 @@ void mglobal::Delete(const FunctionCallbackInfo<Value>& args)
       dbx_log_response(pcon, (char *) pmeth->output_val.svalue.buf_addr, (int) pmeth->output_val.svalue.len_used, (char *) "mglobal::delete");
    }
 
-   result = dbx_new_string8n(isolate, pmeth->output_val.svalue.buf_addr, pmeth->output_val.svalue.len_used, pcon->utf8);
+   result = dbx_new_string8v(isolate, pmeth, pcon->utf8);
    args.GetReturnValue().Set(result);
    dbx_request_memory_free(pcon, pmeth, 0);
    return;
@@ -687,6 +699,7 @@ void mglobal::Next(const FunctionCallbackInfo<Value>& args)
    gref.global16 = gx->global_name16;
    gref.global16_len = gx->global_name16_len;
    gref.pkey = gx->pkey;
+   gref.pprefix = &(gx->pprefix); /* v2.5.35 */
 
    DBX_CALLBACK_FUN(pmeth->argc, async);
 
@@ -757,7 +770,7 @@ void mglobal::Next(const FunctionCallbackInfo<Value>& args)
       dbx_log_response(pcon, (char *) pmeth->output_val.svalue.buf_addr, (int) pmeth->output_val.svalue.len_used, (char *) "mglobal::next");
    }
 
-   result = pcon->utf16 ? dbx_new_string16n(isolate, pmeth->output_val.cvalue.buf16_addr, pmeth->output_val.cvalue.len_used) : dbx_new_string8n(isolate, pmeth->output_val.svalue.buf_addr, pmeth->output_val.svalue.len_used, pcon->utf8);
+   result = pcon->utf16 ? dbx_new_string16n(isolate, pmeth->output_val.cvalue.buf16_addr, pmeth->output_val.cvalue.len_used) : dbx_new_string8v(isolate, pmeth, pcon->utf8);
 
    args.GetReturnValue().Set(result);
    dbx_request_memory_free(pcon, pmeth, 0);
@@ -790,6 +803,7 @@ void mglobal::Previous(const FunctionCallbackInfo<Value>& args)
    gref.global16 = gx->global_name16;
    gref.global16_len = gx->global_name16_len;
    gref.pkey = gx->pkey;
+   gref.pprefix = &(gx->pprefix); /* v2.5.35 */
 
    DBX_CALLBACK_FUN(pmeth->argc, async);
 
@@ -860,7 +874,7 @@ void mglobal::Previous(const FunctionCallbackInfo<Value>& args)
       dbx_log_response(pcon, (char *) pmeth->output_val.svalue.buf_addr, (int) pmeth->output_val.svalue.len_used, (char *) "mglobal::previous");
    }
 
-   result = pcon->utf16 ? dbx_new_string16n(isolate, pmeth->output_val.cvalue.buf16_addr, pmeth->output_val.cvalue.len_used) : dbx_new_string8n(isolate, pmeth->output_val.svalue.buf_addr, pmeth->output_val.svalue.len_used, pcon->utf8);
+   result = pcon->utf16 ? dbx_new_string16n(isolate, pmeth->output_val.cvalue.buf16_addr, pmeth->output_val.cvalue.len_used) : dbx_new_string8v(isolate, pmeth, pcon->utf8);
 
    args.GetReturnValue().Set(result);
    dbx_request_memory_free(pcon, pmeth, 0);
@@ -893,6 +907,7 @@ void mglobal::Increment(const FunctionCallbackInfo<Value>& args)
    gref.global16 = gx->global_name16;
    gref.global16_len = gx->global_name16_len;
    gref.pkey = gx->pkey;
+   gref.pprefix = &(gx->pprefix); /* v2.5.35 */
 
    DBX_CALLBACK_FUN(pmeth->argc, async);
 
@@ -905,6 +920,7 @@ void mglobal::Increment(const FunctionCallbackInfo<Value>& args)
    DBX_DBFUN_START(c, pcon, pmeth);
 
    pmeth->increment = 1;
+   pmeth->typed = pcon->typed; /* v2.5.35 */
    rc = c->GlobalReference(c, args, pmeth, &gref, (async || pcon->net_connection || pcon->tlevel));
    DBX_DB_CHECK(rc);
 
@@ -964,8 +980,13 @@ void mglobal::Increment(const FunctionCallbackInfo<Value>& args)
       dbx_log_response(pcon, (char *) pmeth->output_val.svalue.buf_addr, (int) pmeth->output_val.svalue.len_used, (char *) "mglobal::increment");
    }
 
-   result = pcon->utf16 ? dbx_new_string16n(isolate, pmeth->output_val.cvalue.buf16_addr, pmeth->output_val.cvalue.len_used) : dbx_new_string8n(isolate, pmeth->output_val.svalue.buf_addr, pmeth->output_val.svalue.len_used, pcon->utf8);
-   args.GetReturnValue().Set(result);
+   if (pmeth->typed && DBX_DTYPE_NUMERIC(pmeth->output_val.type)) { /* v2.5.35 */
+      args.GetReturnValue().Set(dbx_new_number(isolate, pmeth));
+   }
+   else {
+      result = pcon->utf16 ? dbx_new_string16n(isolate, pmeth->output_val.cvalue.buf16_addr, pmeth->output_val.cvalue.len_used) : dbx_new_string8v(isolate, pmeth, pcon->utf8);
+      args.GetReturnValue().Set(result);
+   }
    dbx_request_memory_free(pcon, pmeth, 0);
    return;
 }
@@ -998,6 +1019,7 @@ void mglobal::Lock(const FunctionCallbackInfo<Value>& args)
    gref.global16 = gx->global_name16;
    gref.global16_len = gx->global_name16_len;
    gref.pkey = gx->pkey;
+   gref.pprefix = &(gx->pprefix); /* v2.5.35 */
 
    DBX_CALLBACK_FUN(pmeth->argc, async);
 
@@ -1101,7 +1123,7 @@ void mglobal::Lock(const FunctionCallbackInfo<Value>& args)
       dbx_log_response(pcon, (char *) pmeth->output_val.svalue.buf_addr, (int) pmeth->output_val.svalue.len_used, (char *) "mglobal::lock");
    }
 
-   result = dbx_new_string8n(isolate, pmeth->output_val.svalue.buf_addr, pmeth->output_val.svalue.len_used, pcon->utf8);
+   result = dbx_new_string8v(isolate, pmeth, pcon->utf8);
    args.GetReturnValue().Set(result);
    dbx_request_memory_free(pcon, pmeth, 0);
    return;
@@ -1133,6 +1155,7 @@ void mglobal::Unlock(const FunctionCallbackInfo<Value>& args)
    gref.global16 = gx->global_name16;
    gref.global16_len = gx->global_name16_len;
    gref.pkey = gx->pkey;
+   gref.pprefix = &(gx->pprefix); /* v2.5.35 */
 
    DBX_CALLBACK_FUN(pmeth->argc, async);
 
@@ -1213,7 +1236,7 @@ void mglobal::Unlock(const FunctionCallbackInfo<Value>& args)
       dbx_log_response(pcon, (char *) pmeth->output_val.svalue.buf_addr, (int) pmeth->output_val.svalue.len_used, (char *) "mglobal::unlock");
    }
 
-   result = dbx_new_string8n(isolate, pmeth->output_val.svalue.buf_addr, pmeth->output_val.svalue.len_used, pcon->utf8);
+   result = dbx_new_string8v(isolate, pmeth, pcon->utf8);
    args.GetReturnValue().Set(result);
    dbx_request_memory_free(pcon, pmeth, 0);
    return;
@@ -1401,13 +1424,391 @@ void mglobal::Merge(const FunctionCallbackInfo<Value>& args)
       dbx_log_response(pcon, (char *) pmeth->output_val.svalue.buf_addr, (int) pmeth->output_val.svalue.len_used, (char *) "mglobal::merge");
    }
 
-   result = dbx_new_string8n(isolate, pmeth->output_val.svalue.buf_addr, pmeth->output_val.svalue.len_used, pcon->utf8);
+   result = dbx_new_string8v(isolate, pmeth, pcon->utf8);
    args.GetReturnValue().Set(result);
    dbx_request_memory_free(pcon, pmeth, 0);
    return;
 }
 
 
+/* v2.5.35 Return the subtree below a node as a nested object (or as a flat list of {key, data} records) */
+void mglobal::GetDocument(const FunctionCallbackInfo<Value>& args)
+{
+   short async;
+   int rc, n, nk, otype, depth, max, flat, count;
+   unsigned short nul16;
+   DBXCON *pcon;
+   DBXMETH *pmeth;
+   DBXQR *pqr_base, *pqr_next, *pqr_prev, *pqr_skip, *pqr;
+   DBXGREF gref;
+   Local<Object> obj;
+   Local<Object> doc;
+   Local<Object> parent;
+   Local<Array> list;
+   Local<Array> a;
+   Local<Value> child;
+   Local<Value> value;
+   Local<String> key;
+   mglobal *gx = ObjectWrap::Unwrap<mglobal>(args.This());
+   MG_GLOBAL_CHECK_CLASS(gx);
+   DBX_DBNAME *c = gx->c;
+   DBX_GET_ICONTEXT;
+   gx->dbx_count ++;
+
+   pcon = c->pcon;
+   if (pcon->log_functions) {
+      c->LogFunction(c, args, (void *) gx, (char *) "mglobal::getdocument");
+   }
+   pmeth = dbx_request_memory(pcon, 1, 0);
+
+   gref.global = gx->global_name;
+   gref.global_len = gx->global_name_len;
+   gref.global16 = gx->global_name16;
+   gref.global16_len = gx->global_name16_len;
+   gref.pkey = gx->pkey;
+   gref.pprefix = &(gx->pprefix);
+
+   DBX_CALLBACK_FUN(pmeth->argc, async);
+
+   if (async) {
+      isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "The getdocument method cannot be invoked asynchronously", 1)));
+      dbx_request_memory_free(pcon, pmeth, 0);
+      return;
+   }
+
+   depth = 0;
+   max = 0;
+   flat = 0;
+   if (pmeth->argc > 0) {
+      obj = dbx_is_object(args[pmeth->argc - 1], &otype);
+      if (otype == 1) {
+         key = dbx_new_string8(isolate, (char *) "depth", 1);
+         if (DBX_GET(obj, key)->IsNumber()) {
+            depth = (int) DBX_INT32_VALUE(DBX_GET(obj, key));
+         }
+         key = dbx_new_string8(isolate, (char *) "max", 1);
+         if (DBX_GET(obj, key)->IsNumber()) {
+            max = (int) DBX_INT32_VALUE(DBX_GET(obj, key));
+         }
+         key = dbx_new_string8(isolate, (char *) "format", 1);
+         if (DBX_GET(obj, key)->IsString()) {
+            char buffer[64];
+            dbx_write_char8(isolate, DBX_TO_STRING(DBX_GET(obj, key)), buffer, sizeof(buffer), 1);
+            dbx_lcase(buffer);
+            if (!strcmp(buffer, "flat")) {
+               flat = 1;
+            }
+         }
+         pmeth->argc --;
+      }
+   }
+
+   if (pmeth->argc >= DBX_MAXARGS) {
+      isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "Too many arguments on GetDocument", 1)));
+      dbx_request_memory_free(pcon, pmeth, 0);
+      return;
+   }
+
+   DBX_DBFUN_START(c, pcon, pmeth);
+
+   rc = c->GlobalReference(c, args, pmeth, &gref, 1);
+   DBX_DB_CHECK(rc);
+
+   if (pcon->log_transmissions) {
+      dbx_log_transmission(pcon, pmeth, (char *) "mglobal::getdocument");
+   }
+
+   pqr_base = dbx_alloc_dbxqr(NULL, 0, pcon->utf16, 0);
+   pqr_next = dbx_alloc_dbxqr(NULL, 0, pcon->utf16, 0);
+   pqr_prev = dbx_alloc_dbxqr(NULL, 0, pcon->utf16, 0);
+   pqr_skip = (depth > 0) ? dbx_alloc_dbxqr(NULL, 0, pcon->utf16, 0) : NULL;
+   if (!pqr_base || !pqr_next || !pqr_prev || (depth > 0 && !pqr_skip)) {
+      if (pqr_base) dbx_free_dbxqr(pqr_base);
+      if (pqr_next) dbx_free_dbxqr(pqr_next);
+      if (pqr_prev) dbx_free_dbxqr(pqr_prev);
+      if (pqr_skip) dbx_free_dbxqr(pqr_skip);
+      isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "No Memory", 1)));
+      dbx_request_memory_free(pcon, pmeth, 0);
+      return;
+   }
+
+   /* the query starts from the base node: the mglobal object's keys followed by those supplied */
+   dbx_gdoc_key(pcon, pqr_base, -1, gx->global_name, gx->global_name16, pcon->utf16 ? gx->global_name16_len : gx->global_name_len);
+   for (n = 1; n < pmeth->cargc; n ++) {
+      dbx_gdoc_key(pcon, pqr_base, n - 1, pmeth->args[n].svalue.buf_addr, pmeth->args[n].cvalue.buf16_addr, pcon->utf16 ? (int) pmeth->args[n].cvalue.len_used : (int) pmeth->args[n].svalue.len_used);
+   }
+   pqr_base->keyn = pmeth->cargc - 1;
+   dbx_gdoc_copy(pcon, pqr_prev, pqr_base);
+   dbx_gdoc_copy(pcon, pqr_next, pqr_base);
+
+   /* the value of the base node itself */
+   if (pcon->dbtype == DBX_DBTYPE_YOTTADB && pcon->tlevel) {
+      pmeth->p_dbxfun = (int (*) (struct tagDBXMETH * pmeth)) dbx_get;
+      rc = ydb_transaction_task(pmeth, YDB_TPCTX_DB);
+   }
+   else {
+      rc = dbx_get(pmeth);
+   }
+   if (rc != CACHE_SUCCESS && rc != CACHE_ERUNDEF) {
+      dbx_free_dbxqr(pqr_base);
+      dbx_free_dbxqr(pqr_next);
+      dbx_free_dbxqr(pqr_prev);
+      if (pqr_skip) dbx_free_dbxqr(pqr_skip);
+      isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) pcon->error, 1)));
+      dbx_request_memory_free(pcon, pmeth, 0);
+      return;
+   }
+
+   doc = DBX_OBJECT_NEW();
+   list = DBX_ARRAY_NEW(0);
+   count = 0;
+
+   if (rc == CACHE_SUCCESS && (pcon->utf16 ? pmeth->output_val.cvalue.len_used : pmeth->output_val.svalue.len_used) > 0) {
+      value = pcon->utf16 ? dbx_new_string16n(isolate, pmeth->output_val.cvalue.buf16_addr, pmeth->output_val.cvalue.len_used) : dbx_new_string8v(isolate, pmeth, pcon->utf8);
+      if (flat) {
+         obj = DBX_OBJECT_NEW();
+         DBX_SET(obj, dbx_new_string8(isolate, (char *) "key", 0), DBX_ARRAY_NEW(0));
+         DBX_SET(obj, dbx_new_string8(isolate, (char *) "data", 0), value);
+         DBX_SET(list, count, obj);
+      }
+      else {
+         DBX_SET(doc, dbx_new_string8(isolate, (char *) "", 0), value);
+      }
+      count ++;
+   }
+
+   /* walk the subtree in collating sequence ($Query) under one lock */
+   DBX_DB_LOCK(0);
+
+   while (max == 0 || count < max) {
+      rc = dbx_global_query(pmeth, pqr_next, pqr_prev, 1, 1);
+      if (rc != CACHE_SUCCESS || !dbx_gdoc_match(pcon, pqr_next, pqr_base)) {
+         break;
+      }
+      pqr = pqr_next;
+      pqr_next = pqr_prev;
+      pqr_prev = pqr;
+
+      nk = pqr->keyn - pqr_base->keyn;
+      if (depth > 0 && nk > depth) {
+         /* step over the rest of the subtree below the node at the depth limit: its last node is $Query(<node>,""),-1) */
+         dbx_gdoc_copy(pcon, pqr_skip, pqr);
+         pqr_skip->keyn = pqr_base->keyn + depth + 1;
+         nul16 = 0;
+         dbx_gdoc_key(pcon, pqr_skip, pqr_skip->keyn - 1, (char *) "", &nul16, 0);
+         rc = dbx_global_query(pmeth, pqr_next, pqr_skip, -1, 0);
+         if (rc == CACHE_SUCCESS && dbx_gdoc_match(pcon, pqr_next, pqr_base) && (pqr_next->keyn - pqr_base->keyn) > depth) {
+            pqr = pqr_next;
+            pqr_next = pqr_prev;
+            pqr_prev = pqr;
+         }
+         continue; /* otherwise the walk carries on through the subtree */
+      }
+      value = pcon->utf16 ? dbx_new_string16n(isolate, pqr->data.cvalue.buf16_addr, pqr->data.cvalue.len_used) : dbx_new_string8n(isolate, pqr->data.svalue.buf_addr, pqr->data.svalue.len_used, pcon->utf8);
+
+      if (flat) {
+         a = DBX_ARRAY_NEW(nk);
+         for (n = 0; n < nk; n ++) {
+            DBX_SET(a, n, dbx_gdoc_key_string(isolate, pcon, pqr, pqr_base->keyn + n));
+         }
+         obj = DBX_OBJECT_NEW();
+         DBX_SET(obj, dbx_new_string8(isolate, (char *) "key", 0), a);
+         DBX_SET(obj, dbx_new_string8(isolate, (char *) "data", 0), value);
+         DBX_SET(list, count, obj);
+      }
+      else {
+         /* parent nodes are visited first: a parent holding a value becomes an object with the value under the empty property name */
+         parent = doc;
+         for (n = 0; n < (nk - 1); n ++) {
+            key = dbx_gdoc_key_string(isolate, pcon, pqr, pqr_base->keyn + n);
+            child = DBX_GET(parent, key);
+            if (!child->IsObject()) {
+               obj = DBX_OBJECT_NEW();
+               if (!child->IsUndefined()) {
+                  DBX_SET(obj, dbx_new_string8(isolate, (char *) "", 0), child);
+               }
+               DBX_SET(parent, key, obj);
+               child = obj;
+            }
+            parent = DBX_TO_OBJECT(child);
+         }
+         DBX_SET(parent, dbx_gdoc_key_string(isolate, pcon, pqr, pqr_base->keyn + nk - 1), value);
+      }
+      count ++;
+   }
+
+   DBX_DBFUN_END(c);
+   DBX_DB_UNLOCK();
+
+   dbx_free_dbxqr(pqr_base);
+   dbx_free_dbxqr(pqr_next);
+   dbx_free_dbxqr(pqr_prev);
+   if (pqr_skip) dbx_free_dbxqr(pqr_skip);
+
+   if (flat) {
+      args.GetReturnValue().Set(list);
+   }
+   else {
+      args.GetReturnValue().Set(doc);
+   }
+   dbx_request_memory_free(pcon, pmeth, 0);
+   return;
+}
+
+
+/* v2.5.35 Write a JavaScript object to the subtree below a node: one global node for each property holding a value */
+void mglobal::SetDocument(const FunctionCallbackInfo<Value>& args)
+{
+   short async;
+   int rc, n, otype, len, no_items, prefix_argc;
+   char buffer[300];
+   unsigned char *prefix;
+   DBXCON *pcon;
+   DBXMETH *pmeth;
+   DBXBATCH *pbatch;
+   DBXVAL *pval;
+   Local<Object> obj;
+   Local<Object> doc;
+   Local<String> str;
+   Local<Value> path[DBX_MAXARGS];
+   mglobal *gx = ObjectWrap::Unwrap<mglobal>(args.This());
+   MG_GLOBAL_CHECK_CLASS(gx);
+   DBX_DBNAME *c = gx->c;
+   DBX_GET_ICONTEXT;
+   gx->dbx_count ++;
+
+   pcon = c->pcon;
+   if (pcon->log_functions) {
+      c->LogFunction(c, args, (void *) gx, (char *) "mglobal::setdocument");
+   }
+   pmeth = dbx_request_memory(pcon, 0, 0);
+
+   DBX_CALLBACK_FUN(pmeth->argc, async);
+
+   if (async) {
+      isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "The setdocument method cannot be invoked asynchronously", 1)));
+      dbx_request_memory_free(pcon, pmeth, 0);
+      return;
+   }
+   if (pcon->utf16) {
+      isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "The setdocument method is not available for the UTF-16 character set", 1)));
+      dbx_request_memory_free(pcon, pmeth, 0);
+      return;
+   }
+   doc = dbx_is_object(args[0], &otype);
+   if (pmeth->argc == 0 || otype != 1) {
+      isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "Missing or invalid document object on SetDocument", 1)));
+      dbx_request_memory_free(pcon, pmeth, 0);
+      return;
+   }
+
+   DBX_DBFUN_START(c, pcon, pmeth);
+
+   /* the global name, the mglobal object's keys and those supplied are encoded once and copied to the start of every reference */
+   pmeth->ibuffer_used = 0;
+   pmeth->cargc = 0;
+   n = 0;
+   pmeth->args[n].cvalue.pstr = 0;
+   pmeth->args[n].type = DBX_DTYPE_STR;
+   if (pcon->net_connection || gx->global_name[0] == '^') {
+      dbx_ibuffer_add(pmeth, isolate, n, str, (void *) gx->global_name, gx->global_name_len, 0, 2);
+   }
+   else {
+      buffer[0] = '^';
+      T_STRCPY(buffer + 1, sizeof(buffer) - 1, gx->global_name);
+      dbx_ibuffer_add(pmeth, isolate, n, str, (void *) buffer, (int) strlen(buffer), 0, 2);
+   }
+   n ++;
+   for (pval = gx->pkey; pval && n < DBX_MAXARGS; pval = pval->pnext, n ++) {
+      pmeth->args[n].cvalue.pstr = 0;
+      pmeth->args[n].type = DBX_DTYPE_STR;
+      if (pval->type == DBX_DTYPE_INT) {
+         if (!pcon->net_connection) {
+            pmeth->args[n].type = DBX_DTYPE_INT;
+         }
+         T_SPRINTF(buffer, _dbxso(buffer), "%d", pval->num.int32);
+         dbx_ibuffer_add(pmeth, isolate, n, str, (void *) buffer, (int) strlen(buffer), 0, 2);
+      }
+      else {
+         dbx_ibuffer_add(pmeth, isolate, n, str, (void *) pval->svalue.buf_addr, (int) pval->svalue.len_used, 0, 2);
+      }
+   }
+   for (rc = 1; rc < pmeth->argc && n < DBX_MAXARGS; rc ++, n ++) {
+      pmeth->args[n].cvalue.pstr = 0;
+      pmeth->args[n].type = DBX_DTYPE_STR;
+      if (args[rc]->IsInt32()) {
+         if (!pcon->net_connection) {
+            pmeth->args[n].type = DBX_DTYPE_INT;
+         }
+         T_SPRINTF(buffer, _dbxso(buffer), "%d", (int) DBX_INT32_VALUE(args[rc]));
+         dbx_ibuffer_add(pmeth, isolate, n, str, (void *) buffer, (int) strlen(buffer), 0, 2);
+      }
+      else {
+         obj = dbx_is_object(args[rc], &otype);
+         if (otype == 2) {
+            dbx_ibuffer_add(pmeth, isolate, n, str, (void *) node::Buffer::Data(obj), (int) node::Buffer::Length(obj), 0, 2);
+         }
+         else {
+            str = DBX_TO_STRING(args[rc]);
+            dbx_ibuffer_add(pmeth, isolate, n, str, NULL, 0, 0, 2);
+         }
+      }
+   }
+   prefix_argc = n;
+
+   no_items = dbx_gdoc_count(isolate, doc, prefix_argc);
+   if (no_items < 0) {
+      isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "Too many levels in the document on SetDocument", 1)));
+      dbx_request_memory_free(pcon, pmeth, 0);
+      return;
+   }
+
+   len = (int) pmeth->ibuffer_used;
+   prefix = (unsigned char *) dbx_malloc(len + 32, 0);
+   pbatch = dbx_batch_alloc(DBX_CMND_GSET, no_items, 2);
+   if (!prefix || !pbatch) {
+      if (prefix) dbx_free((void *) prefix, 0);
+      if (pbatch) dbx_batch_free(pbatch);
+      isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) "No memory available for SetDocument", 1)));
+      dbx_request_memory_free(pcon, pmeth, 0);
+      return;
+   }
+   memcpy((void *) prefix, (void *) pmeth->ibuffer, (size_t) len);
+   pmeth->ibuffer_used = 0;
+   pmeth->pbatch = pbatch;
+   pmeth->p_dbxfun = dbx_setmany;
+
+   dbx_gdoc_flatten(isolate, pmeth, pbatch, prefix, len, prefix_argc, doc, path, 0);
+   dbx_free((void *) prefix, 0);
+
+   if (pcon->log_transmissions) {
+      dbx_log_transmission(pcon, pmeth, (char *) "mglobal::setdocument");
+   }
+
+   if (pbatch->no_items == 0) {
+      rc = CACHE_SUCCESS;
+   }
+   else if (!pcon->net_connection && pcon->dbtype == DBX_DBTYPE_YOTTADB && pcon->tlevel) {
+      rc = ydb_transaction_task(pmeth, YDB_TPCTX_DB);
+   }
+   else {
+      rc = dbx_setmany(pmeth);
+   }
+
+   DBX_DBFUN_END(c);
+
+   if (rc != CACHE_SUCCESS && pcon->error_mode == 1) {
+      isolate->ThrowException(Exception::Error(dbx_new_string8(isolate, (char *) pcon->error, 1)));
+      dbx_request_memory_free(pcon, pmeth, 0);
+      return;
+   }
+
+   args.GetReturnValue().Set(dbx_batch_result(isolate, pcon, pbatch));
+   dbx_request_memory_free(pcon, pmeth, 0);
+   return;
+}
+
+
 void mglobal::Reset(const FunctionCallbackInfo<Value>& args)
 {
    int rc;
@@ -1483,6 +1884,7 @@ void mglobal::Close(const FunctionCallbackInfo<Value>& args)
       dbx_free((void *) pvalp, 0);
    }
    gx->pkey = NULL;
+   dbx_gprefix_free(&(gx->pprefix)); /* v2.5.35 */
 /*
    cx->delete_mglobal_template(gx);
 */
@@ -1490,3 +1892,209 @@ void mglobal::Close(const FunctionCallbackInfo<Value>& args)
    return;
 }
 
+
+/* v2.5.35 Set key 'n' of a query record (n = -1 for the global name) */
+int dbx_gdoc_key(DBXCON *pcon, DBXQR *pqr, int n, char *key, unsigned short *key16, int len)
+{
+   if (len < 0) {
+      len = 0;
+   }
+   if (pcon->utf16) {
+      DBXVAL *pval = (n < 0) ? &(pqr->global_name16) : &(pqr->keys[n]);
+      if (len >= (int) pval->cvalue.len_alloc) {
+         len = (int) pval->cvalue.len_alloc - 1;
+      }
+      memcpy((void *) pval->cvalue.buf16_addr, (void *) key16, (size_t) len * sizeof(unsigned short));
+      pval->cvalue.len_used = len;
+      pval->type = DBX_DTYPE_STR16;
+   }
+   else {
+      ydb_buffer_t *pbuf = (n < 0) ? &(pqr->global_name) : &(pqr->ykeys[n]);
+      if (len >= (int) pbuf->len_alloc) {
+         len = (int) pbuf->len_alloc - 1;
+      }
+      memcpy((void *) pbuf->buf_addr, (void *) key, (size_t) len);
+      pbuf->buf_addr[len] = '\0';
+      pbuf->len_used = len;
+      if (n >= 0) {
+         pqr->keys[n].svalue.len_used = len;
+         pqr->keys[n].type = DBX_DTYPE_STR8;
+      }
+   }
+   return 0;
+}
+
+
+/* v2.5.35 Copy the global name and keys of one query record to another */
+int dbx_gdoc_copy(DBXCON *pcon, DBXQR *pqr_to, DBXQR *pqr_from)
+{
+   int n;
+
+   if (pcon->utf16) {
+      dbx_gdoc_key(pcon, pqr_to, -1, NULL, pqr_from->global_name16.cvalue.buf16_addr, (int) pqr_from->global_name16.cvalue.len_used);
+      for (n = 0; n < pqr_from->keyn; n ++) {
+         dbx_gdoc_key(pcon, pqr_to, n, NULL, pqr_from->keys[n].cvalue.buf16_addr, (int) pqr_from->keys[n].cvalue.len_used);
+      }
+   }
+   else {
+      dbx_gdoc_key(pcon, pqr_to, -1, pqr_from->global_name.buf_addr, NULL, (int) pqr_from->global_name.len_used);
+      for (n = 0; n < pqr_from->keyn; n ++) {
+         dbx_gdoc_key(pcon, pqr_to, n, pqr_from->ykeys[n].buf_addr, NULL, (int) pqr_from->ykeys[n].len_used);
+      }
+   }
+   pqr_to->keyn = pqr_from->keyn;
+   return 0;
+}
+
+
+/* v2.5.35 Return 1 if the node in 'pqr' lies below the base node */
+int dbx_gdoc_match(DBXCON *pcon, DBXQR *pqr, DBXQR *pqr_base)
+{
+   int n;
+
+   if (pqr->keyn <= pqr_base->keyn) {
+      return 0;
+   }
+   for (n = 0; n < pqr_base->keyn; n ++) {
+      if (pcon->utf16) {
+         if (pqr->keys[n].cvalue.len_used != pqr_base->keys[n].cvalue.len_used || memcmp((void *) pqr->keys[n].cvalue.buf16_addr, (void *) pqr_base->keys[n].cvalue.buf16_addr, (size_t) pqr->keys[n].cvalue.len_used * sizeof(unsigned short))) {
+            return 0;
+         }
+      }
+      else {
+         if (pqr->ykeys[n].len_used != pqr_base->ykeys[n].len_used || memcmp((void *) pqr->ykeys[n].buf_addr, (void *) pqr_base->ykeys[n].buf_addr, (size_t) pqr->ykeys[n].len_used)) {
+            return 0;
+         }
+      }
+   }
+   return 1;
+}
+
+
+/* v2.5.35 Return key 'n' of a query record as a JavaScript string */
+v8::Local<v8::String> dbx_gdoc_key_string(v8::Isolate * isolate, DBXCON *pcon, DBXQR *pqr, int n)
+{
+   return pcon->utf16 ? dbx_new_string16n(isolate, pqr->keys[n].cvalue.buf16_addr, pqr->keys[n].cvalue.len_used) : dbx_new_string8n(isolate, pqr->ykeys[n].buf_addr, pqr->ykeys[n].len_used, pcon->utf8);
+}
+
+
+/* v2.5.35 Return the number of nodes that a document will be written to (-1 if there are too many levels for a global reference) */
+int dbx_gdoc_count(v8::Isolate * isolate, v8::Local<v8::Object> doc, int argc)
+{
+   int n, otype, count, count1;
+   v8::Local<v8::Context> icontext = isolate->GetCurrentContext();
+   v8::Local<v8::Value> value;
+
+#if DBX_NODE_VERSION >= 120000
+   v8::Local<v8::Array> a = doc->GetPropertyNames(icontext).ToLocalChecked();
+#else
+   v8::Local<v8::Array> a = doc->GetPropertyNames();
+#endif
+
+   if ((argc + 2) >= DBX_MAXARGS) {
+      return -1;
+   }
+
+   count = 0;
+   for (n = 0; n < (int) a->Length(); n ++) {
+      value = DBX_GET(doc, DBX_GET(a, n));
+      if (value->IsUndefined() || value->IsFunction()) {
+         continue;
+      }
+      dbx_is_object(value, &otype);
+      if (otype == 1 && !value->IsDate()) {
+         count1 = dbx_gdoc_count(isolate, DBX_TO_OBJECT(value), argc + 1);
+         if (count1 < 0) {
+            return -1;
+         }
+         count += count1;
+      }
+      else {
+         count ++;
+      }
+   }
+   return count;
+}
+
+
+/* v2.5.35 Add a set request to the batch for each node of a document: a value held under the empty property name is written to the parent node */
+int dbx_gdoc_flatten(v8::Isolate * isolate, DBXMETH *pmeth, DBXBATCH *pbatch, unsigned char *prefix, int prefix_len, int prefix_argc, v8::Local<v8::Object> doc, v8::Local<v8::Value> *path, int depth)
+{
+   int n, nx, len, otype, dsort, dtype;
+   unsigned char *p;
+   DBXBITEM *pitem;
+   v8::Local<v8::Context> icontext = isolate->GetCurrentContext();
+   v8::Local<v8::Value> name;
+   v8::Local<v8::Value> value;
+   v8::Local<v8::Object> obj;
+   v8::Local<v8::String> str;
+
+#if DBX_NODE_VERSION >= 120000
+   v8::Local<v8::Array> a = doc->GetPropertyNames(icontext).ToLocalChecked();
+#else
+   v8::Local<v8::Array> a = doc->GetPropertyNames();
+#endif
+
+   for (n = 0; n < (int) a->Length(); n ++) {
+      name = DBX_GET(a, n);
+      value = DBX_GET(doc, name);
+      if (value->IsUndefined() || value->IsFunction()) {
+         continue;
+      }
+      obj = dbx_is_object(value, &otype);
+      str = DBX_TO_STRING(name);
+      if (otype == 1 && !value->IsDate()) {
+         path[depth] = str;
+         dbx_gdoc_flatten(isolate, pmeth, pbatch, prefix, prefix_len, prefix_argc, obj, path, depth + 1);
+         continue;
+      }
+      if (pbatch->no_items >= pbatch->no_alloc) {
+         break;
+      }
+
+      pitem = &(pbatch->items[pbatch->no_items]);
+      pitem->offset = pmeth->ibuffer_used;
+
+      /* the encoded base reference */
+      for (nx = 0, p = prefix; nx < prefix_argc && p < (prefix + prefix_len); nx ++) {
+         len = (int) dbx_get_block_size(p, 0, &dsort, &dtype);
+         pmeth->args[nx].cvalue.pstr = 0;
+         pmeth->args[nx].type = dtype;
+         dbx_ibuffer_add(pmeth, isolate, nx, str, (void *) (p + 5), len, 0, 2);
+         p += (5 + len);
+      }
+
+      /* the path to the node: the value under the empty property name belongs to the parent */
+      for (len = 0; len < depth; len ++, nx ++) {
+         pmeth->args[nx].cvalue.pstr = 0;
+         pmeth->args[nx].type = DBX_DTYPE_STR;
+         dbx_ibuffer_add(pmeth, isolate, nx, DBX_TO_STRING(path[len]), NULL, 0, 0, 2);
+      }
+      if (dbx_string8_length(isolate, str, 0) > 0) {
+         pmeth->args[nx].cvalue.pstr = 0;
+         pmeth->args[nx].type = DBX_DTYPE_STR;
+         dbx_ibuffer_add(pmeth, isolate, nx, str, NULL, 0, 0, 2);
+         nx ++;
+      }
+
+      pmeth->args[nx].cvalue.pstr = 0;
+      pmeth->args[nx].type = DBX_DTYPE_STR;
+      if (otype == 2) {
+         dbx_ibuffer_add(pmeth, isolate, nx, str, (void *) node::Buffer::Data(obj), (int) node::Buffer::Length(obj), 0, 2);
+      }
+      else {
+         dbx_ibuffer_add(pmeth, isolate, nx, value->IsNull() ? dbx_new_string8(isolate, (char *) "", 0) : DBX_TO_STRING(value), NULL, 0, 0, 2);
+      }
+      nx ++;
+
+      pitem->len = pmeth->ibuffer_used - pitem->offset;
+      pitem->argc = nx;
+      pitem->rc = CACHE_SUCCESS;
+      pitem->ooffset = 0;
+      pitem->olen = 0;
+      pbatch->no_items ++;
+   }
+
+   return pbatch->no_items;
+}
+
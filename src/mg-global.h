@@ -44,6 +44,7 @@ public:
    unsigned short global_name16[256];
    int            global_name16_len;
    DBXVAL         *pkey;
+   DBXGPREFIX     *pprefix; /* v2.5.35 */
    DBX_DBNAME     *c;
 
    static v8::Persistent<v8::Function>       constructor;
@@ -72,6 +73,8 @@ public:
    static void       Lock        (const v8::FunctionCallbackInfo<v8::Value>& args);
    static void       Unlock      (const v8::FunctionCallbackInfo<v8::Value>& args);
    static void       Merge       (const v8::FunctionCallbackInfo<v8::Value>& args);
+   static void       GetDocument (const v8::FunctionCallbackInfo<v8::Value>& args);
+   static void       SetDocument (const v8::FunctionCallbackInfo<v8::Value>& args);
    static void       Reset       (const v8::FunctionCallbackInfo<v8::Value>& args);
    static void       Close       (const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -80,6 +83,13 @@ private:
    static void       New         (const v8::FunctionCallbackInfo<v8::Value>& args);
 };
 
+int                     dbx_gdoc_key            (DBXCON *pcon, DBXQR *pqr, int n, char *key, unsigned short *key16, int len);
+int                     dbx_gdoc_copy           (DBXCON *pcon, DBXQR *pqr_to, DBXQR *pqr_from);
+int                     dbx_gdoc_match          (DBXCON *pcon, DBXQR *pqr, DBXQR *pqr_base);
+v8::Local<v8::String>   dbx_gdoc_key_string     (v8::Isolate * isolate, DBXCON *pcon, DBXQR *pqr, int n);
+int                     dbx_gdoc_count          (v8::Isolate * isolate, v8::Local<v8::Object> doc, int argc);
+int                     dbx_gdoc_flatten        (v8::Isolate * isolate, DBXMETH *pmeth, DBXBATCH *pbatch, unsigned char *prefix, int prefix_len, int prefix_argc, v8::Local<v8::Object> doc, v8::Local<v8::Value> *path, int depth);
+
 
 #endif
 
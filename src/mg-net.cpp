@@ -288,6 +288,8 @@ int netx_tcp_connect(DBXCON *pcon, int context)
 
    pcon->open = 0;
    pcon->error_code = 0;
+   pcon->recv_buf_used = 0; /* v2.5.35 */
+   pcon->recv_buf_pos = 0;
    connected = 0;
    getaddrinfo_ok = 0;
    spin_count = 0;
@@ -696,55 +698,864 @@ int netx_tcp_command(DBXMETH *pmeth, int command, int context)
    int len, rc;
    unsigned int netbuf_used;
    unsigned char *netbuf;
+   DBXCON *pcon = pmeth->pcon;
+
+   rc = CACHE_SUCCESS;
+   pcon->error[0] = '\0';
+
+   netbuf = netx_tcp_frame(pmeth, command, &netbuf_used); /* v2.5.35 */
+
+/*
+   {
+      char buffer[256];
+      sprintf(buffer, "netx_tcp_command SEND cmnd=%d; size=%d; netbuf_used=%d;", command, pmeth->ibuffer_used, netbuf_used);
+      dbx_log_buffer(pcon, (char *) netbuf, (int) netbuf_used, buffer, 0);
+   }
+*/
+
+#if !defined(_WIN32)
+   /* v2.5.35 */
+   if (netx_pool_command(pcon, command)) {
+      len = netx_tcp_command_pool(pmeth, netbuf, netbuf_used);
+      if (len < 0) {
+         return len;
+      }
+   }
+   else if (pcon->net_pipeline) {
+      len = netx_tcp_command_pipe(pmeth, netbuf, netbuf_used);
+      if (len < 0) {
+         return len;
+      }
+   }
+   else {
+#endif
+
+   rc = netx_tcp_write(pcon, (unsigned char *) netbuf, netbuf_used);
+   if (rc < 0) { /* v2.2.21 */
+      netx_tcp_disconnect(pcon, 0);
+      return rc;
+   }
+
+   len = netx_tcp_response(pmeth, 0); /* v2.5.35 */
+   if (len < 0) { /* v2.2.21 */
+      netx_tcp_disconnect(pcon, 0);
+      return len;
+   }
+
+#if !defined(_WIN32)
+   }
+#endif
+
+   rc = netx_tcp_result(pmeth, command, len); /* v2.5.35 */
+
+   return rc;
+}
+
+
+/* v2.5.35 Terminate the request's argument buffer and fill in the frame header (the first DBX_IBUFFER_OFFSET Bytes) */
+unsigned char * netx_tcp_frame(DBXMETH *pmeth, int command, unsigned int *netbuf_used)
+{
+   unsigned char *netbuf;
+   DBXCON *pcon = pmeth->pcon;
+
+   dbx_add_block_size(pmeth->ibuffer, pmeth->ibuffer_used, 0,  DBX_DSORT_EOD, DBX_DTYPE_STR8);
+   pmeth->ibuffer_used += 5;
+
+   netbuf = (pmeth->ibuffer - DBX_IBUFFER_OFFSET);
+   *netbuf_used = (pmeth->ibuffer_used + DBX_IBUFFER_OFFSET);
+   dbx_add_block_size(netbuf, 0, *netbuf_used,  0, command);
+
+   /* v2.4.26 */
+   if (pcon->utf8 == 2)
+      netbuf[9] = 255;
+   else
+      netbuf[9] = 0;
+
+   return netbuf;
+}
+
+
+/* v2.5.35 Interpret the response (of length len) held in the request's output buffer */
+int netx_tcp_result(DBXMETH *pmeth, int command, int len)
+{
+   int rc;
+   DBXCON *pcon = pmeth->pcon;
+
+   if (pmeth->output_val.type == DBX_DTYPE_OREF) {
+      pmeth->output_val.svalue.buf_addr[len] = '\0';
+      pmeth->output_val.num.oref = (int) strtol(pmeth->output_val.svalue.buf_addr, NULL, 10);
+      pmeth->output_val.num.int32 = pmeth->output_val.num.oref;
+   }
+
+   rc = CACHE_SUCCESS;
+   if (pmeth->output_val.sort == DBX_DSORT_ERROR) {
+      rc = CACHE_FAILURE;
+      if (len > 0) {
+         strncpy(pcon->error, pmeth->output_val.svalue.buf_addr, len);
+         pcon->error[len] = '\0';
+         len = 0;
+      }
+   }
+/*
+   {
+      char buffer[256];
+      sprintf(buffer, "netx_tcp_command RECV cmnd=%d; len=%d; sort=%d; type=%d; oref=%d; rc=%d; error=%s;", command, len, pmeth->output_val.sort, pmeth->output_val.type, pmeth->output_val.num.oref, rc, pcon->error);
+      dbx_log_buffer(pcon, pmeth->output_val.svalue.buf_addr, len, buffer, 0);
+   }
+*/
+   pmeth->output_val.svalue.len_used = len;
+
+   /* v2.5.35 a transaction pins the requests that would otherwise use the connection pool or event loop transport to the primary session */
+   if ((pcon->p_netpool || pcon->net_async) && rc == CACHE_SUCCESS) {
+      if (command == DBX_CMND_TSTART) {
+         pcon->net_tlevel ++;
+      }
+      else if (command == DBX_CMND_TCOMMIT && pcon->net_tlevel > 0) {
+         pcon->net_tlevel --;
+      }
+      else if (command == DBX_CMND_TROLLBACK) {
+         pcon->net_tlevel = 0;
+      }
+   }
+
+   return rc;
+}
+
+
+/* v2.5.35 Read the response to the next command on the connection: returns the length of the data or a read error */
+int netx_tcp_response(DBXMETH *pmeth, int context)
+{
+   int len, rc;
    char *p;
    DBXCON *pcon = pmeth->pcon;
 
-   rc = CACHE_SUCCESS;
-   pcon->error[0] = '\0';
+   rc = netx_tcp_read(pcon, (unsigned char *) pmeth->output_val.svalue.buf_addr, 5, pcon->timeout, 1);
+   pmeth->output_val.svalue.buf_addr[5] = '\0';
+
+   if (rc < 0) {
+      return rc;
+   }
+
+   len = dbx_get_block_size((unsigned char *) pmeth->output_val.svalue.buf_addr, 0, &(pmeth->output_val.sort), &(pmeth->output_val.type));
+
+   /* v2.2.22 */
+   if (len >= (int) pmeth->output_val.svalue.len_alloc) {
+      p = (char *) dbx_malloc(sizeof(char) * (len + 2), 301);
+
+      if (p) {
+         if (pmeth->output_val.svalue.buf_addr) {
+            dbx_free((void *) pmeth->output_val.svalue.buf_addr, 301);
+         }
+         pmeth->output_val.svalue.buf_addr = (char *) p;
+         pmeth->output_val.svalue.len_alloc = len;
+      }
+   }
+   if (len > 0) {
+      rc = netx_tcp_read(pcon, (unsigned char *) pmeth->output_val.svalue.buf_addr, len, pcon->timeout, 1);
+      if (rc < 0) {
+         return rc;
+      }
+   }
+
+   return len;
+}
+
+
+#if !defined(_WIN32)
+
+/* v2.5.35 Release the DB lock for the duration of a network exchange, but only if this thread holds it for the current command alone */
+/* A nested lock (stack > 0) belongs to a caller issuing a sequence of commands that must not be interleaved (e.g. a cursor or document walk) */
+int netx_db_unlock(DBXCON *pcon)
+{
+   if (pcon->use_mutex && pcon->p_mutex->thid == dbx_current_thread_id() && pcon->p_mutex->stack == 0) {
+      dbx_mutex_unlock(pcon->p_mutex);
+      return 1;
+   }
+   return 0;
+}
+
+
+int netx_db_relock(DBXCON *pcon, int unlocked)
+{
+   if (unlocked) {
+      dbx_mutex_lock(pcon->p_mutex, 0);
+   }
+   return 0;
+}
+
+
+/* v2.5.35 Connection pool (open options 'connection_pool_size', 'connection_pool_max' and 'connection_health_check'):
+   Stateless commands are sent over one of a pool of sessions (each a separate socket to the DB Superserver) and the
+   DB lock is released for the round trip, so requests from different threads proceed in parallel.
+   Commands that depend on server process state (locks, transactions, classes, SQL) always use the primary session.
+   So do functions, which may rely on local variables or locks in the server process, unless 'connection_pool_functions' is set.
+*/
+int netx_pool_command(DBXCON *pcon, int command)
+{
+   if (!pcon->p_netpool || pcon->net_tlevel) {
+      return 0;
+   }
+
+   switch (command) {
+      case DBX_CMND_GSET:
+      case DBX_CMND_GGET:
+      case DBX_CMND_GNEXT:
+      case DBX_CMND_GNEXTDATA:
+      case DBX_CMND_GPREVIOUS:
+      case DBX_CMND_GPREVIOUSDATA:
+      case DBX_CMND_GDELETE:
+      case DBX_CMND_GDEFINED:
+      case DBX_CMND_GINCREMENT:
+      case DBX_CMND_GMERGE:
+      case DBX_CMND_GBATCH:
+      case DBX_CMND_GNNODE:
+      case DBX_CMND_GNNODEDATA:
+      case DBX_CMND_GPNODE:
+      case DBX_CMND_GPNODEDATA:
+      case DBX_CMND_GNAMENEXT:
+      case DBX_CMND_GNAMEPREVIOUS:
+         return 1;
+      case DBX_CMND_FUNCTION:
+         return pcon->net_pool_functions;
+      default:
+         return 0;
+   }
+}
+
+
+int netx_pool_init(DBXCON *pcon)
+{
+   int n;
+   DBXNETPOOL *ppool;
+   DBXCON *psess;
+
+   ppool = (DBXNETPOOL *) dbx_malloc(sizeof(DBXNETPOOL), 0);
+   if (!ppool) {
+      strcpy(pcon->error, "No memory available for the connection pool");
+      return CACHE_FAILURE;
+   }
+   memset((void *) ppool, 0, sizeof(DBXNETPOOL));
+   pthread_mutex_init(&(ppool->mutex), NULL);
+   pthread_cond_init(&(ppool->cond), NULL);
+
+   ppool->size = pcon->net_pool_size;
+   ppool->max = pcon->net_pool_max;
+   if (ppool->max > DBX_NETPOOL_MAX) {
+      ppool->max = DBX_NETPOOL_MAX;
+   }
+   if (ppool->size > ppool->max) {
+      ppool->max = ppool->size;
+   }
+   ppool->health_check = pcon->net_health_check;
+
+   for (n = 0; n < ppool->size; n ++) {
+      psess = netx_pool_session(pcon, ppool);
+      if (!psess) {
+         pcon->p_netpool = ppool;
+         netx_pool_close(pcon);
+         return CACHE_FAILURE;
+      }
+      ppool->psess[ppool->no_sessions ++] = psess;
+      ppool->pidle[ppool->no_idle ++] = psess;
+   }
+   pcon->p_netpool = ppool;
+
+   return CACHE_SUCCESS;
+}
+
+
+/* Open a new session modelled on the primary connection */
+DBXCON * netx_pool_session(DBXCON *pcon, DBXNETPOOL *ppool)
+{
+   DBXCON *psess;
+
+   psess = netx_pool_session_alloc(pcon);
+   if (!psess) {
+      strcpy(pcon->error, "No memory available for the connection pool");
+      return NULL;
+   }
+
+   if (netx_pool_connect(psess, ppool) != CACHE_SUCCESS) {
+      strcpy(pcon->error, psess->error);
+      netx_pool_session_free(psess);
+      return NULL;
+   }
+
+   return psess;
+}
+
+
+/* Create (but do not connect) a session modelled on the primary connection */
+DBXCON * netx_pool_session_alloc(DBXCON *pcon)
+{
+   DBXCON *psess;
+
+   psess = (DBXCON *) dbx_malloc(sizeof(DBXCON), 0);
+   if (!psess) {
+      return NULL;
+   }
+   /* the session takes the connection's settings; everything that holds state (buffers, locks, queues) starts afresh */
+   memcpy((void *) psess, (void *) pcon, sizeof(DBXCON));
+   psess->open = 0;
+   psess->use_mutex = 0;
+   psess->p_mutex = NULL;
+   psess->p_isc_so = NULL;
+   psess->p_ydb_so = NULL;
+   psess->cli_socket = (SOCKET) 0;
+   psess->pmeth_base = NULL;
+   psess->tlevel = 0;
+   psess->p_async = NULL;
+   psess->recv_buf = NULL;
+   psess->recv_buf_used = 0;
+   psess->recv_buf_pos = 0;
+   psess->net_pipeline = 0;
+   psess->pipe_broken = 0;
+   psess->pipe_depth = 0;
+   psess->pipe_depth_max = 0;
+   psess->pipe_turns = 0;
+   psess->pipe_head = NULL;
+   psess->pipe_tail = NULL;
+   pthread_mutex_init(&(psess->pipe_mutex), NULL);
+   psess->net_tlevel = 0;
+   psess->p_netpool = NULL;
+   psess->p_netuv = NULL;
+   psess->p_zv = &(psess->zv);
+   psess->error[0] = '\0';
+
+   return psess;
+}
+
+
+int netx_pool_session_free(DBXCON *psess)
+{
+   if (psess->recv_buf) {
+      dbx_free((void *) psess->recv_buf, 0);
+   }
+   pthread_mutex_destroy(&(psess->pipe_mutex));
+   dbx_free((void *) psess, 0);
+   return 0;
+}
+
+
+int netx_pool_connect(DBXCON *psess, DBXNETPOOL *ppool)
+{
+   int rc;
+
+   rc = netx_tcp_connect(psess, 0);
+   if (rc == CACHE_SUCCESS) {
+      psess->open = 1;
+      netx_tcp_handshake(psess, 0);
+   }
+   if (!psess->open) {
+      if (ppool) {
+         DBX_ATOMIC_INC_STAT(&(ppool->failures));
+      }
+      return CACHE_NOCON;
+   }
+   psess->net_last_used = time(NULL);
+   if (ppool) {
+      psess->net_generation = ppool->generation;
+      DBX_ATOMIC_INC_STAT(&(ppool->connects));
+   }
+
+   return CACHE_SUCCESS;
+}
+
+
+/* Take an idle session, opening a new one if the pool is below its maximum size: otherwise wait for one to be released */
+DBXCON * netx_pool_acquire(DBXCON *pcon, char *error)
+{
+   int rc;
+   time_t now;
+   struct timespec ts;
+   struct timeval tp;
+   struct pollfd pfd;
+   DBXNETPOOL *ppool = pcon->p_netpool;
+   DBXCON *psess;
+
+   psess = NULL;
+   pthread_mutex_lock(&(ppool->mutex));
+   while (!ppool->no_idle && ppool->no_sessions >= ppool->max) {
+      ppool->no_waiting ++;
+      ppool->waits ++;
+      gettimeofday(&tp, NULL);
+      ts.tv_sec = tp.tv_sec + pcon->timeout;
+      ts.tv_nsec = tp.tv_usec * 1000;
+      rc = pthread_cond_timedwait(&(ppool->cond), &(ppool->mutex), &ts);
+      ppool->no_waiting --;
+      if (rc == ETIMEDOUT && !ppool->no_idle) {
+         pthread_mutex_unlock(&(ppool->mutex));
+         sprintf(error, "Connection Pool: No session became available within the timeout period (%d seconds)", pcon->timeout);
+         return NULL;
+      }
+   }
+   ppool->acquired ++;
+   if (ppool->no_idle) {
+      psess = ppool->pidle[-- ppool->no_idle];
+      pthread_mutex_unlock(&(ppool->mutex));
+   }
+   else {
+      ppool->no_sessions ++; /* reserve the slot and connect outside the pool mutex */
+      pthread_mutex_unlock(&(ppool->mutex));
+
+      psess = netx_pool_session(pcon, ppool);
+
+      pthread_mutex_lock(&(ppool->mutex));
+      if (psess) {
+         ppool->psess[ppool->no_sessions - 1] = psess;
+      }
+      else {
+         ppool->no_sessions --;
+         pthread_cond_signal(&(ppool->cond));
+      }
+      pthread_mutex_unlock(&(ppool->mutex));
+      if (!psess) {
+         strcpy(error, "Connection Pool: Unable to open a new session: ");
+         strncat(error, pcon->error, DBX_ERROR_SIZE - 64);
+      }
+      return psess;
+   }
+
+   /* health check: an idle session should have nothing to read, so a readable socket means it was closed by the server */
+   now = time(NULL);
+   rc = 0;
+   if (!psess->open || psess->net_generation != ppool->generation) {
+      rc = 1;
+   }
+   else if (ppool->health_check > 0 && (now - psess->net_last_used) >= ppool->health_check) {
+      pfd.fd = psess->cli_socket;
+      pfd.events = POLLIN;
+      pfd.revents = 0;
+      if (NETX_POLL(&pfd, 1, 0) != 0) {
+         rc = 1;
+      }
+   }
+   if (rc) {
+      netx_tcp_disconnect(psess, 0);
+      strcpy(psess->nspace, pcon->nspace);
+      DBX_ATOMIC_INC_STAT(&(ppool->reconnects));
+      if (netx_pool_connect(psess, ppool) != CACHE_SUCCESS) {
+         strcpy(error, "Connection Pool: Unable to reconnect a session: ");
+         strncat(error, psess->error, DBX_ERROR_SIZE - 64);
+         netx_pool_release(pcon, psess);
+         return NULL;
+      }
+   }
+
+   return psess;
+}
+
+
+int netx_pool_release(DBXCON *pcon, DBXCON *psess)
+{
+   DBXNETPOOL *ppool = pcon->p_netpool;
+
+   psess->net_last_used = time(NULL);
+
+   pthread_mutex_lock(&(ppool->mutex));
+   ppool->pidle[ppool->no_idle ++] = psess;
+   if (ppool->no_waiting) {
+      pthread_cond_signal(&(ppool->cond));
+   }
+   pthread_mutex_unlock(&(ppool->mutex));
+
+   return 0;
+}
+
+
+int netx_pool_close(DBXCON *pcon)
+{
+   int n;
+   DBXNETPOOL *ppool = pcon->p_netpool;
+
+   if (!ppool) {
+      return 0;
+   }
+   pcon->p_netpool = NULL;
+
+   for (n = 0; n < ppool->no_sessions; n ++) {
+      if (ppool->psess[n]) {
+         netx_tcp_disconnect(ppool->psess[n], 0);
+         netx_pool_session_free(ppool->psess[n]);
+      }
+   }
+   pthread_cond_destroy(&(ppool->cond));
+   pthread_mutex_destroy(&(ppool->mutex));
+   dbx_free((void *) ppool, 0);
+
+   return 0;
+}
+
+
+/* Send a command over a pooled session */
+int netx_tcp_command_pool(DBXMETH *pmeth, unsigned char *netbuf, unsigned int netbuf_used)
+{
+   int len, unlocked;
+   char error[DBX_ERROR_SIZE];
+   DBXCON *pcon = pmeth->pcon;
+   DBXCON *psess;
+
+   unlocked = netx_db_unlock(pcon);
+
+   psess = netx_pool_acquire(pcon, error);
+   if (!psess) {
+      netx_db_relock(pcon, unlocked);
+      strcpy(pcon->error, error);
+      return NETX_READ_NOCON;
+   }
+
+   pmeth->pcon = psess;
+   psess->error[0] = '\0';
+   len = netx_tcp_write(psess, (unsigned char *) netbuf, netbuf_used);
+   if (len >= 0) {
+      len = netx_tcp_response(pmeth, 0);
+   }
+   if (len < 0) {
+      netx_tcp_disconnect(psess, 0); /* reconnected when next acquired */
+      strcpy(error, psess->error);
+   }
+   pmeth->pcon = pcon;
+
+   netx_pool_release(pcon, psess);
+   netx_db_relock(pcon, unlocked);
+
+   if (len < 0) {
+      strcpy(pcon->error, error);
+   }
+   return len;
+}
+
+
+/* v2.5.35 Event loop transport (open option 'net_async'):
+   Asynchronous requests for stateless commands are written to a dedicated session socket driven by the event loop
+   (uv_tcp_t) instead of occupying a thread for the round trip.  Responses are framed incrementally as data arrives
+   and matched to requests in the order in which they were sent; the request's after_work callback is then invoked
+   directly on the event loop thread.
+*/
+int netx_uv_command(DBXMETH *pmeth)
+{
+   DBXCON *pcon = pmeth->pcon;
+
+   if (pcon->net_tlevel || pcon->utf16) {
+      return 0;
+   }
+   if (pmeth->p_dbxfun == (int (*) (struct tagDBXMETH * pmeth)) dbx_get) {
+      return DBX_CMND_GGET;
+   }
+   if (pmeth->p_dbxfun == (int (*) (struct tagDBXMETH * pmeth)) dbx_set) {
+      return DBX_CMND_GSET;
+   }
+   if (pmeth->p_dbxfun == (int (*) (struct tagDBXMETH * pmeth)) dbx_defined) {
+      return DBX_CMND_GDEFINED;
+   }
+   if (pmeth->p_dbxfun == (int (*) (struct tagDBXMETH * pmeth)) dbx_delete) {
+      return DBX_CMND_GDELETE;
+   }
+   if (pmeth->p_dbxfun == (int (*) (struct tagDBXMETH * pmeth)) dbx_next) {
+      return DBX_CMND_GNEXT;
+   }
+   if (pmeth->p_dbxfun == (int (*) (struct tagDBXMETH * pmeth)) dbx_previous) {
+      return DBX_CMND_GPREVIOUS;
+   }
+   if (pmeth->p_dbxfun == (int (*) (struct tagDBXMETH * pmeth)) dbx_increment) {
+      return DBX_CMND_GINCREMENT;
+   }
+   /* functions may rely on state held by the primary session's server process (see netx_pool_command) */
+   if (pmeth->p_dbxfun == (int (*) (struct tagDBXMETH * pmeth)) dbx_function) {
+      return pcon->net_pool_functions ? DBX_CMND_FUNCTION : 0;
+   }
+   return 0;
+}
+
+
+/* EVENT LOOP THREAD : Start opening the transport's session: the connect and handshake are made by a worker thread */
+/* requests are passed to the thread pool until the socket has been handed to libuv (netx_uv_open_callback) */
+int netx_uv_init(DBXCON *pcon, uv_loop_t *loop)
+{
+   DBXNETUV *pnetuv;
+   DBXCON *psess;
+
+   pnetuv = (DBXNETUV *) dbx_malloc(sizeof(DBXNETUV), 0);
+   if (!pnetuv) {
+      return CACHE_FAILURE;
+   }
+   memset((void *) pnetuv, 0, sizeof(DBXNETUV));
+   /* read before the session copies the namespace: a change made meanwhile will be picked up by the next request */
+   pnetuv->generation = DBX_ATOMIC_LOAD(&(pcon->net_generation));
+
+   psess = netx_pool_session_alloc(pcon);
+   if (!psess) {
+      dbx_free((void *) pnetuv, 0);
+      return CACHE_FAILURE;
+   }
+
+   pnetuv->pcon = pcon;
+   pnetuv->psess = psess;
+   pnetuv->timeout = pcon->timeout;
+   pnetuv->opening = 1;
+   pnetuv->open_req.data = (void *) pnetuv;
+
+   if (uv_queue_work(loop, &(pnetuv->open_req), netx_uv_open_task, netx_uv_open_callback) != 0) {
+      netx_pool_session_free(psess);
+      dbx_free((void *) pnetuv, 0);
+      return CACHE_FAILURE;
+   }
+
+   pcon->p_netuv = (void *) pnetuv;
+   return CACHE_SUCCESS;
+}
+
+
+/* ASYNC THREAD : Connect the session; only the session is used here, never the connection */
+void netx_uv_open_task(uv_work_t *req)
+{
+   DBXNETUV *pnetuv = (DBXNETUV *) req->data;
+
+   if (netx_pool_connect(pnetuv->psess, NULL) != CACHE_SUCCESS) {
+      netx_pool_session_free(pnetuv->psess);
+      pnetuv->psess = NULL;
+   }
+   return;
+}
+
+
+/* EVENT LOOP THREAD : Hand the session's socket to libuv, or give up on the transport if the session could not be opened */
+void netx_uv_open_callback(uv_work_t *req, int status)
+{
+   DBXNETUV *pnetuv = (DBXNETUV *) req->data;
+   DBXCON *psess = pnetuv->psess;
+   uv_loop_t *loop = req->loop;
+
+   pnetuv->opening = 0;
+   pnetuv->psess = NULL;
+
+   /* the connection was closed (or the transport discarded) while the session was being opened */
+   if (pnetuv->closing) {
+      if (psess) {
+         netx_tcp_disconnect(psess, 0);
+         netx_pool_session_free(psess);
+      }
+      dbx_free((void *) pnetuv, 0);
+      return;
+   }
+
+   pnetuv->rbuf_size = NETX_RECV_BUFFER;
+   if (psess) {
+      pnetuv->rbuf = (unsigned char *) dbx_malloc(sizeof(char) * pnetuv->rbuf_size, 0);
+   }
+
+   if (!psess || !pnetuv->rbuf || uv_tcp_init(loop, &(pnetuv->handle)) != 0) {
+      if (psess) {
+         netx_tcp_disconnect(psess, 0);
+         netx_pool_session_free(psess);
+      }
+      if (pnetuv->rbuf) {
+         dbx_free((void *) pnetuv->rbuf, 0);
+      }
+      pnetuv->pcon->p_netuv = NULL;
+      pnetuv->pcon->net_async = 0; /* fall back to the thread pool */
+      dbx_free((void *) pnetuv, 0);
+      return;
+   }
+   pnetuv->handle.data = (void *) pnetuv;
+   pnetuv->handles = 1;
+
+   if (uv_tcp_open(&(pnetuv->handle), (uv_os_sock_t) psess->cli_socket) != 0) {
+      netx_tcp_disconnect(psess, 0);
+      netx_pool_session_free(psess);
+      pnetuv->pcon->p_netuv = NULL;
+      pnetuv->pcon->net_async = 0;
+      /* the close callback releases pnetuv */
+      pnetuv->closing = 1;
+      pnetuv->shutdown = 1;
+      uv_close((uv_handle_t *) &(pnetuv->handle), netx_uv_close_callback);
+      return;
+   }
+   /* the socket now belongs to libuv */
+   netx_pool_session_free(psess);
+
+   uv_tcp_nodelay(&(pnetuv->handle), 1);
+   uv_timer_init(loop, &(pnetuv->timer));
+   pnetuv->timer.data = (void *) pnetuv;
+   uv_unref((uv_handle_t *) &(pnetuv->timer));
+   pnetuv->handles = 2;
+
+   uv_read_start((uv_stream_t *) &(pnetuv->handle), netx_uv_alloc_callback, netx_uv_read_callback);
+   /* the handle only keeps the loop alive while requests are outstanding */
+   uv_unref((uv_handle_t *) &(pnetuv->handle));
+   return;
+}
+
+
+/* EVENT LOOP THREAD : Write the request; its after_work callback is invoked when the response arrives */
+int netx_uv_submit(DBXMETH *pmeth, int command, void *req, void *after_work_cb)
+{
+   uv_buf_t buf;
+   unsigned int netbuf_used;
+   DBXNETUV *pnetuv = (DBXNETUV *) pmeth->pcon->p_netuv;
+
+   buf.base = (char *) netx_tcp_frame(pmeth, command, &netbuf_used);
+   buf.len = netbuf_used;
+
+   pmeth->net_command = command;
+   pmeth->net_error[0] = '\0';
+   pmeth->p_async = (void *) pnetuv;
+   pmeth->p_async_req = req;
+   pmeth->p_async_cb = after_work_cb;
+   pmeth->p_async_next = NULL;
+
+   if (pnetuv->tail) {
+      pnetuv->tail->p_async_next = pmeth;
+   }
+   else {
+      pnetuv->head = pmeth;
+   }
+   pnetuv->tail = pmeth;
+
+   if (pnetuv->pending ++ == 0) {
+      pnetuv->last_activity = uv_now(pnetuv->handle.loop);
+      uv_ref((uv_handle_t *) &(pnetuv->handle));
+      uv_timer_start(&(pnetuv->timer), netx_uv_timer_callback, 1000, 1000);
+   }
+   if (pnetuv->pending > pnetuv->pending_max) {
+      pnetuv->pending_max = pnetuv->pending;
+   }
+   pnetuv->sent ++;
+
+   if (uv_write(&(pmeth->net_write), (uv_stream_t *) &(pnetuv->handle), &buf, 1, netx_uv_write_callback) != 0) {
+      netx_uv_fail(pnetuv, (char *) "TCP Write Error: Unable to queue the request on the event loop");
+   }
+
+   return 0;
+}
+
 
-   dbx_add_block_size(pmeth->ibuffer, pmeth->ibuffer_used, 0,  DBX_DSORT_EOD, DBX_DTYPE_STR8);
-   pmeth->ibuffer_used += 5;
+void netx_uv_write_callback(uv_write_t *req, int status)
+{
+   DBXNETUV *pnetuv = (DBXNETUV *) req->handle->data;
 
-   netbuf = (pmeth->ibuffer - DBX_IBUFFER_OFFSET);
-   netbuf_used = (pmeth->ibuffer_used + DBX_IBUFFER_OFFSET);
-   dbx_add_block_size(netbuf, 0, netbuf_used,  0, command);
+   if (status < 0 && status != UV_ECANCELED) {
+      netx_uv_fail(pnetuv, (char *) "TCP Write Error: Cannot Write Data");
+   }
+   return;
+}
 
-   /* v2.4.26 */
-   if (pcon->utf8 == 2)
-      netbuf[9] = 255;
-   else
-      netbuf[9] = 0;
 
+void netx_uv_alloc_callback(uv_handle_t *handle, size_t suggested_size, uv_buf_t *buf)
+{
+   DBXNETUV *pnetuv = (DBXNETUV *) handle->data;
 
-/*
-   {
-      char buffer[256];
-      sprintf(buffer, "netx_tcp_command SEND cmnd=%d; size=%d; netbuf_used=%d;", command, pmeth->ibuffer_used, netbuf_used);
-      dbx_log_buffer(pcon, (char *) netbuf, (int) netbuf_used, buffer, 0);
+   if ((pnetuv->rbuf_size - pnetuv->rbuf_used) < (NETX_RECV_BUFFER / 2)) {
+      netx_uv_rbuf_size(pnetuv, pnetuv->rbuf_used + NETX_RECV_BUFFER);
    }
-*/
+   buf->base = (char *) (pnetuv->rbuf + pnetuv->rbuf_used);
+   buf->len = pnetuv->rbuf_size - pnetuv->rbuf_used;
+   return;
+}
 
-   rc = netx_tcp_write(pcon, (unsigned char *) netbuf, netbuf_used);
-   if (rc < 0) { /* v2.2.21 */
-      netx_tcp_disconnect(pcon, 0);
-      return rc;
+
+int netx_uv_rbuf_size(DBXNETUV *pnetuv, unsigned int size)
+{
+   unsigned char *p;
+
+   if (size <= pnetuv->rbuf_size) {
+      return 0;
+   }
+   p = (unsigned char *) dbx_malloc(sizeof(char) * size, 0);
+   if (!p) {
+      return -1;
+   }
+   if (pnetuv->rbuf_used) {
+      memcpy((void *) p, (void *) pnetuv->rbuf, (size_t) pnetuv->rbuf_used);
    }
+   dbx_free((void *) pnetuv->rbuf, 0);
+   pnetuv->rbuf = p;
+   pnetuv->rbuf_size = size;
+   return 0;
+}
 
-   rc = netx_tcp_read(pcon, (unsigned char *) pmeth->output_val.svalue.buf_addr, 5, pcon->timeout, 1);
-   pmeth->output_val.svalue.buf_addr[5] = '\0';
 
-   if (rc < 0) { /* v2.2.21 */
-      netx_tcp_disconnect(pcon, 0);
-      return rc;
+/* EVENT LOOP THREAD : Frame the data received so far; each complete response completes the request at the head of the queue */
+void netx_uv_read_callback(uv_stream_t *stream, ssize_t nread, const uv_buf_t *buf)
+{
+   int len, sort, type;
+   unsigned int pos;
+   DBXNETUV *pnetuv = (DBXNETUV *) stream->data;
+
+   if (nread < 0) {
+      netx_uv_fail(pnetuv, (char *) "TCP Read Error: Server closed the connection without having returned any data");
+      return;
+   }
+   if (nread == 0) {
+      return;
    }
+   pnetuv->rbuf_used += (unsigned int) nread;
+   pnetuv->last_activity = uv_now(pnetuv->handle.loop);
+   pnetuv->reads ++;
 
-   len = dbx_get_block_size((unsigned char *) pmeth->output_val.svalue.buf_addr, 0, &(pmeth->output_val.sort), &(pmeth->output_val.type));
+   pnetuv->in_callback = 1;
+   pos = 0;
+   while ((pnetuv->rbuf_used - pos) >= 5 && !pnetuv->broken) {
+      len = dbx_get_block_size(pnetuv->rbuf + pos, 0, &sort, &type);
+      if ((pnetuv->rbuf_used - pos) < (unsigned int) (len + 5)) {
+         break;
+      }
+      if (!pnetuv->head) {
+         pnetuv->in_callback = 0;
+         netx_uv_fail(pnetuv, (char *) "TCP Read Error: Response received with no request outstanding");
+         return;
+      }
+      netx_uv_deliver(pnetuv, pnetuv->rbuf + pos + 5, len, sort, type);
+      pos += (len + 5);
+   }
+   pnetuv->in_callback = 0;
 
-   /* v2.2.22 */
-   if (len >= (int) pmeth->output_val.svalue.len_alloc) {
-      p = (char *) dbx_malloc(sizeof(char) * (len + 2), 301);
+   if (pos) {
+      pnetuv->rbuf_used -= pos;
+      if (pnetuv->rbuf_used) {
+         memmove((void *) pnetuv->rbuf, (void *) (pnetuv->rbuf + pos), (size_t) pnetuv->rbuf_used);
+      }
+   }
+   /* make room for the whole of a large response */
+   if (pnetuv->rbuf_used >= 5) {
+      len = dbx_get_block_size(pnetuv->rbuf, 0, &sort, &type);
+      netx_uv_rbuf_size(pnetuv, (unsigned int) (len + 5 + NETX_RECV_BUFFER));
+   }
 
-      if (p) {
+   if (pnetuv->closing && pnetuv->pending == 0) {
+      netx_uv_shutdown(pnetuv);
+   }
+   return;
+}
+
+
+int netx_uv_deliver(DBXNETUV *pnetuv, unsigned char *data, int len, int sort, int type)
+{
+   char *p;
+   DBXMETH *pmeth;
+
+   pmeth = pnetuv->head;
+   pnetuv->head = pmeth->p_async_next;
+   if (!pnetuv->head) {
+      pnetuv->tail = NULL;
+   }
+
+   /* the error is kept with the request: the connection's error buffer belongs to threads holding the DB lock */
+   if (sort == DBX_DSORT_ERROR) {
+      if (len >= DBX_ERROR_SIZE) {
+         len = DBX_ERROR_SIZE - 1;
+      }
+      memcpy((void *) pmeth->net_error, (void *) data, (size_t) len);
+      pmeth->net_error[len] = '\0';
+      len = 0;
+   }
+   else if (len >= (int) pmeth->output_val.svalue.len_alloc) {
+      p = (char *) dbx_malloc(sizeof(char) * (len + 2), 301);
+      if (!p) {
+         strcpy(pmeth->net_error, "No memory available for the response");
+         len = 0;
+      }
+      else {
          if (pmeth->output_val.svalue.buf_addr) {
             dbx_free((void *) pmeth->output_val.svalue.buf_addr, 301);
          }
@@ -753,38 +1564,354 @@ int netx_tcp_command(DBXMETH *pmeth, int command, int context)
       }
    }
    if (len > 0) {
-      rc = netx_tcp_read(pcon, (unsigned char *) pmeth->output_val.svalue.buf_addr, len, pcon->timeout, 1);
-      if (rc < 0) { /* v2.2.21 */
-         netx_tcp_disconnect(pcon, 0);
-         return rc;
+      memcpy((void *) pmeth->output_val.svalue.buf_addr, (void *) data, (size_t) len);
+   }
+   pmeth->output_val.sort = sort;
+   pmeth->output_val.type = type;
+
+   netx_tcp_result(pmeth, pmeth->net_command, len);
+
+   netx_uv_complete(pnetuv, pmeth);
+   return 0;
+}
+
+
+int netx_uv_complete(DBXNETUV *pnetuv, DBXMETH *pmeth)
+{
+   pnetuv->received ++;
+   if (-- pnetuv->pending == 0) {
+      uv_timer_stop(&(pnetuv->timer));
+      if (!pnetuv->broken) {
+         uv_unref((uv_handle_t *) &(pnetuv->handle));
       }
    }
+   /* the callback releases pmeth */
+   ((uv_after_work_cb) pmeth->p_async_cb)((uv_work_t *) pmeth->p_async_req, 0);
+   return 0;
+}
 
-   if (pmeth->output_val.type == DBX_DTYPE_OREF) {
-      pmeth->output_val.svalue.buf_addr[len] = '\0';
-      pmeth->output_val.num.oref = (int) strtol(pmeth->output_val.svalue.buf_addr, NULL, 10);
-      pmeth->output_val.num.int32 = pmeth->output_val.num.oref;
+
+void netx_uv_timer_callback(uv_timer_t *handle)
+{
+   DBXNETUV *pnetuv = (DBXNETUV *) handle->data;
+   char error[128];
+
+   if (pnetuv->pending && pnetuv->timeout > 0 && (uv_now(handle->loop) - pnetuv->last_activity) >= ((uint64_t) pnetuv->timeout * 1000)) {
+      sprintf(error, "TCP Read Error: Server did not respond within the timeout period (%d seconds)", pnetuv->timeout);
+      netx_uv_fail(pnetuv, error);
    }
+   return;
+}
 
-   rc = CACHE_SUCCESS;
-   if (pmeth->output_val.sort == DBX_DSORT_ERROR) {
-      rc = CACHE_FAILURE;
-      if (len > 0) {
-         strncpy(pcon->error, pmeth->output_val.svalue.buf_addr, len);
-         pcon->error[len] = '\0';
-         len = 0;
+
+/* EVENT LOOP THREAD : The stream is out of step or closed: close the handles and fail the outstanding requests */
+int netx_uv_fail(DBXNETUV *pnetuv, char *error)
+{
+   if (pnetuv->broken) {
+      return 0;
+   }
+   pnetuv->broken = 1;
+   strcpy(pnetuv->error, error);
+   netx_uv_shutdown(pnetuv);
+   return 0;
+}
+
+
+int netx_uv_shutdown(DBXNETUV *pnetuv)
+{
+   if (pnetuv->shutdown) {
+      return 0;
+   }
+   pnetuv->shutdown = 1;
+   pnetuv->broken = 1;
+   uv_read_stop((uv_stream_t *) &(pnetuv->handle));
+   uv_timer_stop(&(pnetuv->timer));
+   /* queued writes are cancelled (and their callbacks invoked) before the close callback */
+   uv_close((uv_handle_t *) &(pnetuv->handle), netx_uv_close_callback);
+   uv_close((uv_handle_t *) &(pnetuv->timer), netx_uv_close_callback);
+   return 0;
+}
+
+
+void netx_uv_close_callback(uv_handle_t *handle)
+{
+   DBXMETH *pmeth;
+   DBXNETUV *pnetuv = (DBXNETUV *) handle->data;
+
+   if (-- pnetuv->handles > 0) {
+      return;
+   }
+
+   while ((pmeth = pnetuv->head)) {
+      pnetuv->head = pmeth->p_async_next;
+      strcpy(pmeth->net_error, pnetuv->error[0] ? pnetuv->error : "TCP Error: The connection was closed");
+      pmeth->output_val.svalue.len_used = 0;
+      netx_uv_complete(pnetuv, pmeth);
+   }
+   pnetuv->tail = NULL;
+
+   if (pnetuv->closing) {
+      dbx_free((void *) pnetuv->rbuf, 0);
+      dbx_free((void *) pnetuv, 0);
+   }
+   return;
+}
+
+
+/* EVENT LOOP THREAD : Called when the connection is closed; outstanding requests are allowed to complete first */
+int netx_uv_close(DBXCON *pcon)
+{
+   DBXNETUV *pnetuv = (DBXNETUV *) pcon->p_netuv;
+
+   if (!pnetuv) {
+      return 0;
+   }
+   pcon->p_netuv = NULL;
+   pnetuv->closing = 1;
+
+   if (pnetuv->opening) {
+      return 0; /* netx_uv_open_callback releases pnetuv */
+   }
+   if (pnetuv->shutdown) {
+      if (pnetuv->handles == 0) {
+         dbx_free((void *) pnetuv->rbuf, 0);
+         dbx_free((void *) pnetuv, 0);
       }
    }
-/*
-   {
-      char buffer[256];
-      sprintf(buffer, "netx_tcp_command RECV cmnd=%d; len=%d; sort=%d; type=%d; oref=%d; rc=%d; error=%s;", command, len, pmeth->output_val.sort, pmeth->output_val.type, pmeth->output_val.num.oref, rc, pcon->error);
-      dbx_log_buffer(pcon, pmeth->output_val.svalue.buf_addr, len, buffer, 0);
+   else if (pnetuv->pending == 0 && !pnetuv->in_callback) {
+      netx_uv_shutdown(pnetuv);
    }
+   return 0;
+}
+
+
+/* v2.5.35 Pipelined mode (open option 'pipeline'):
+   Commands are written to the socket in the order in which they join the connection's in-flight queue (both under the DB lock).
+   The DB lock is then released so that other threads can send their commands while this one waits for its turn to read.
+   Responses arrive in the order the commands were sent, so only the request at the head of the queue reads from the socket.
 */
-   pmeth->output_val.svalue.len_used = len;
+int netx_tcp_command_pipe(DBXMETH *pmeth, unsigned char *netbuf, unsigned int netbuf_used)
+{
+   int len, rc, head, unlocked;
+   DBXCON *pcon = pmeth->pcon;
 
-   return rc;
+   head = netx_pipe_enter(pmeth);
+
+   rc = netx_tcp_write(pcon, (unsigned char *) netbuf, netbuf_used);
+   if (rc < 0) {
+      /* the responses to the commands already in flight can no longer be relied on */
+      pthread_mutex_lock(&(pcon->pipe_mutex));
+      pcon->pipe_broken = 1;
+      pthread_mutex_unlock(&(pcon->pipe_mutex));
+      netx_tcp_disconnect(pcon, 0);
+   }
+
+   unlocked = netx_db_unlock(pcon);
+
+   if (!head) {
+      dbx_completion_wait(&(pmeth->pipe_turn), pcon->timeout);
+   }
+
+   len = rc;
+   if (rc >= 0) {
+      if (pcon->pipe_broken) {
+         strcpy(pcon->error, "TCP Read Error: The connection was lost while the command was in flight");
+         len = NETX_READ_ERROR;
+      }
+      else {
+         len = netx_tcp_response(pmeth, 0);
+         if (len < 0) {
+            pcon->pipe_broken = 1;
+            netx_tcp_disconnect(pcon, 0);
+         }
+      }
+   }
+
+   netx_pipe_leave(pmeth);
+   netx_db_relock(pcon, unlocked);
+
+   return len;
+}
+
+
+/* v2.5.35 Join the connection's in-flight queue: returns 1 if there is nothing ahead of this request */
+int netx_pipe_enter(DBXMETH *pmeth)
+{
+   int head;
+   DBXCON *pcon = pmeth->pcon;
+
+   pmeth->pipe_next = NULL;
+   pmeth->pipe_turn.word = 0;
+
+   pthread_mutex_lock(&(pcon->pipe_mutex));
+   if (pcon->pipe_tail) {
+      pcon->pipe_tail->pipe_next = pmeth;
+      head = 0;
+   }
+   else {
+      pcon->pipe_head = pmeth;
+      head = 1;
+   }
+   pcon->pipe_tail = pmeth;
+   pcon->pipe_depth ++;
+   if (pcon->pipe_depth > pcon->pipe_depth_max) {
+      pcon->pipe_depth_max = pcon->pipe_depth;
+   }
+   pthread_mutex_unlock(&(pcon->pipe_mutex));
+
+   return head;
+}
+
+
+/* v2.5.35 Leave the in-flight queue and pass the socket to the next request */
+int netx_pipe_leave(DBXMETH *pmeth)
+{
+   DBXMETH *pnext;
+   DBXCON *pcon = pmeth->pcon;
+
+   pthread_mutex_lock(&(pcon->pipe_mutex));
+   pnext = pmeth->pipe_next;
+   pcon->pipe_head = pnext;
+   if (!pnext) {
+      pcon->pipe_tail = NULL;
+      pcon->pipe_broken = 0;
+   }
+   else {
+      pcon->pipe_turns ++;
+   }
+   pcon->pipe_depth --;
+   pthread_mutex_unlock(&(pcon->pipe_mutex));
+
+   pmeth->pipe_next = NULL;
+   if (pnext) {
+      dbx_completion_signal(&(pnext->pipe_turn));
+   }
+
+   return 0;
+}
+
+#endif /* #if !defined(_WIN32) */
+
+
+/* v2.5.35 Send the batch as a stream of commands (a window at a time) and collect the responses in order */
+int netx_tcp_command_batch(DBXMETH *pmeth, DBXBATCH *pbatch, int context)
+{
+#if !defined(_WIN32)
+   int rc, unlocked;
+   char error[DBX_ERROR_SIZE];
+   DBXCON *pcon = pmeth->pcon;
+   DBXCON *psess;
+
+   if (netx_pool_command(pcon, pbatch->command)) {
+      unlocked = netx_db_unlock(pcon);
+      psess = netx_pool_acquire(pcon, error);
+      if (!psess) {
+         netx_db_relock(pcon, unlocked);
+         strcpy(pcon->error, error);
+         return CACHE_FAILURE;
+      }
+      pmeth->pcon = psess;
+      rc = netx_tcp_command_stream(pmeth, pbatch, context);
+      pmeth->pcon = pcon;
+      strcpy(error, psess->error);
+      netx_pool_release(pcon, psess);
+      netx_db_relock(pcon, unlocked);
+      strcpy(pcon->error, error);
+      return rc;
+   }
+
+   if (pmeth->pcon->net_pipeline) {
+      /* the DB lock is held so nothing more can be sent: wait for the commands already in flight to be answered */
+      if (!netx_pipe_enter(pmeth)) {
+         dbx_completion_wait(&(pmeth->pipe_turn), pmeth->pcon->timeout);
+      }
+      rc = netx_tcp_command_stream(pmeth, pbatch, context);
+      netx_pipe_leave(pmeth);
+      return rc;
+   }
+#endif
+
+   return netx_tcp_command_stream(pmeth, pbatch, context);
+}
+
+
+int netx_tcp_command_stream(DBXMETH *pmeth, DBXBATCH *pbatch, int context)
+{
+   int i, i1, n, len, rc;
+   unsigned int size, frame_len;
+   unsigned char *p;
+   DBXBITEM *pitem;
+   DBXCON *pcon = pmeth->pcon;
+
+   rc = CACHE_SUCCESS;
+   pcon->error[0] = '\0';
+
+   for (i = 0; i < pbatch->no_items; i = i1) {
+
+      size = 0;
+      for (i1 = i; i1 < pbatch->no_items && (i1 - i) < DBX_BATCH_WINDOW; i1 ++) {
+         pitem = &(pbatch->items[i1]);
+         frame_len = DBX_IBUFFER_OFFSET + pitem->len + 5;
+         if (i1 > i && (size + frame_len) > DBX_BATCH_WINDOW_SIZE) {
+            break;
+         }
+         if ((size + frame_len) > pbatch->nbuffer_size) {
+            p = (unsigned char *) dbx_malloc(sizeof(char) * (size + frame_len + DBX_BATCH_WINDOW_SIZE), 0);
+            if (!p) {
+               strcpy(pcon->error, "No memory available for batched request");
+               return CACHE_FAILURE;
+            }
+            if (pbatch->nbuffer) {
+               memcpy((void *) p, (void *) pbatch->nbuffer, (size_t) size);
+               dbx_free((void *) pbatch->nbuffer, 0);
+            }
+            pbatch->nbuffer = p;
+            pbatch->nbuffer_size = (size + frame_len + DBX_BATCH_WINDOW_SIZE);
+         }
+
+         /* same framing as netx_tcp_command: header, argument blocks, end-of-data */
+         p = pbatch->nbuffer + size;
+         memcpy((void *) p, (void *) (pmeth->ibuffer - DBX_IBUFFER_OFFSET), (size_t) DBX_IBUFFER_OFFSET);
+         memcpy((void *) (p + DBX_IBUFFER_OFFSET), (void *) (pmeth->ibuffer + pitem->offset), (size_t) pitem->len);
+         dbx_add_block_size(p + DBX_IBUFFER_OFFSET, pitem->len, 0,  DBX_DSORT_EOD, DBX_DTYPE_STR8);
+         dbx_add_block_size(p, 0, frame_len,  0, pitem->command);
+         if (pcon->utf8 == 2)
+            p[9] = 255;
+         else
+            p[9] = 0;
+         size += frame_len;
+      }
+
+      rc = netx_tcp_write(pcon, pbatch->nbuffer, (int) size);
+      if (rc < 0) {
+         netx_tcp_disconnect(pcon, 0);
+         return rc;
+      }
+
+      for (n = i; n < i1; n ++) {
+         len = netx_tcp_response(pmeth, 0);
+         if (len < 0) {
+            netx_tcp_disconnect(pcon, 0);
+            return len;
+         }
+         pmeth->output_val.svalue.len_used = len;
+
+         rc = CACHE_SUCCESS;
+         if (pmeth->output_val.sort == DBX_DSORT_ERROR) {
+            rc = CACHE_FAILURE;
+            if (len > 0) {
+               if (len >= DBX_ERROR_SIZE) {
+                  len = DBX_ERROR_SIZE - 1;
+               }
+               strncpy(pcon->error, pmeth->output_val.svalue.buf_addr, len);
+               pcon->error[len] = '\0';
+            }
+         }
+         dbx_batch_add_result(pbatch, n, pmeth->output_val.svalue.buf_addr, len, rc, pcon->error);
+      }
+   }
+
+   return CACHE_SUCCESS;
 }
 
 
@@ -795,8 +1922,7 @@ int netx_tcp_connect_ex(DBXCON *pcon, xLPSOCKADDR p_srv_addr, socklen_netx srv_a
 #else
    int flags, n, error;
    socklen_netx len;
-   fd_set rset, wset;
-   struct timeval tval;
+   struct pollfd pfd; /* v2.5.35 */
 #endif
 
 #if defined(SOLARIS) && BIT64PLAT
@@ -844,14 +1970,11 @@ int netx_tcp_connect_ex(DBXCON *pcon, xLPSOCKADDR p_srv_addr, socklen_netx srv_a
 
       if (n != 0) {
 
-         FD_ZERO(&rset);
-         FD_SET(pcon->cli_socket, &rset);
+         pfd.fd = pcon->cli_socket;
+         pfd.events = POLLIN | POLLOUT;
+         pfd.revents = 0;
 
-         wset = rset;
-         tval.tv_sec = timeout;
-         tval.tv_usec = timeout;
-
-         n = NETX_SELECT((int) (pcon->cli_socket + 1), &rset, &wset, NULL, &tval);
+         n = NETX_POLL(&pfd, 1, timeout * 1000); /* v2.5.35 */
 
          if (n == 0) {
             close(pcon->cli_socket);
@@ -859,7 +1982,7 @@ int netx_tcp_connect_ex(DBXCON *pcon, xLPSOCKADDR p_srv_addr, socklen_netx srv_a
 
             return (-2);
          }
-         if (NETX_FD_ISSET(pcon->cli_socket, &rset) || NETX_FD_ISSET(pcon->cli_socket, &wset)) {
+         if (pfd.revents & (POLLIN | POLLOUT | POLLERR | POLLHUP)) {
 
             len = sizeof(error);
             if (NETX_GETSOCKOPT(pcon->cli_socket, SOL_SOCKET, SO_ERROR, (void *) &error, &len) < 0) {
@@ -919,7 +2042,10 @@ int netx_tcp_disconnect(DBXCON *pcon, int context)
 
    }
 
+   pcon->cli_socket = (SOCKET) 0; /* v2.5.35 */
    pcon->open = 0;
+   pcon->recv_buf_used = 0; /* v2.5.35 */
+   pcon->recv_buf_pos = 0;
 
    return 0;
 
@@ -976,12 +2102,20 @@ int netx_tcp_write(DBXCON *pcon, unsigned char *data, int size)
 
 
 
+/* v2.5.35 Reads are served from a connection-level receive buffer (NETX_RECV_BUFFER) so that one recv() normally
+   returns a response's header and data together.  Requests for more than the buffer size are read directly into
+   the caller's buffer.  On UNIX systems poll() is used to apply the timeout (select() fails for descriptors >= FD_SETSIZE).
+*/
 int netx_tcp_read(DBXCON *pcon, unsigned char *data, int size, int timeout, int context)
 {
-   int result, n;
+   int result, n, avail;
    int len;
+#if defined(_WIN32)
    fd_set rset, eset;
    struct timeval tval;
+#else
+   struct pollfd pfd;
+#endif
    unsigned long spin_count;
 
 
@@ -991,20 +2125,50 @@ int netx_tcp_read(DBXCON *pcon, unsigned char *data, int size, int timeout, int
 
    result = 0;
 
+#if defined(_WIN32)
    tval.tv_sec = timeout;
    tval.tv_usec = 0;
+#endif
 
    spin_count = 0;
    len = 0;
+
+   avail = pcon->recv_buf_used - pcon->recv_buf_pos;
+   if (avail > 0) {
+      len = (avail < size) ? avail : size;
+      memcpy((void *) data, (void *) (pcon->recv_buf + pcon->recv_buf_pos), (size_t) len);
+      pcon->recv_buf_pos += len;
+      if (len == size || !context) {
+         return len;
+      }
+   }
+   pcon->recv_buf_used = 0;
+   pcon->recv_buf_pos = 0;
+
+   if (!pcon->recv_buf) {
+      pcon->recv_buf = (unsigned char *) dbx_malloc(sizeof(char) * NETX_RECV_BUFFER, 0);
+   }
+
    for (;;) {
       spin_count ++;
 
+#if defined(_WIN32)
       FD_ZERO(&rset);
       FD_ZERO(&eset);
       FD_SET(pcon->cli_socket, &rset);
       FD_SET(pcon->cli_socket, &eset);
 
       n = NETX_SELECT((int) (pcon->cli_socket + 1), &rset, NULL, &eset, &tval);
+#else
+      pfd.fd = pcon->cli_socket;
+      pfd.events = POLLIN;
+      pfd.revents = 0;
+
+      n = NETX_POLL(&pfd, 1, timeout * 1000);
+      if (n < 0 && errno == EINTR) {
+         continue;
+      }
+#endif
 
       if (n == 0) {
          sprintf(pcon->error, "TCP Read Error: Server did not respond within the timeout period (%d seconds)", timeout);
@@ -1012,13 +2176,30 @@ int netx_tcp_read(DBXCON *pcon, unsigned char *data, int size, int timeout, int
          break;
       }
 
+#if defined(_WIN32)
       if (n < 0 || !NETX_FD_ISSET(pcon->cli_socket, &rset)) {
+#else
+      if (n < 0 || !(pfd.revents & (POLLIN | POLLHUP))) {
+#endif
           strcpy(pcon->error, "TCP Read Error: Server closed the connection without having returned any data");
           result = NETX_READ_ERROR;
          break;
       }
 
-      n = NETX_RECV(pcon->cli_socket, (char *) data + len, size - len, 0);
+      if (pcon->recv_buf && (size - len) < NETX_RECV_BUFFER) {
+         n = NETX_RECV(pcon->cli_socket, (char *) pcon->recv_buf, NETX_RECV_BUFFER, 0);
+         if (n > 0) {
+            pcon->recv_buf_used = n;
+            if (n > (size - len)) {
+               n = (size - len);
+            }
+            memcpy((void *) (data + len), (void *) pcon->recv_buf, (size_t) n);
+            pcon->recv_buf_pos = n;
+         }
+      }
+      else {
+         n = NETX_RECV(pcon->cli_socket, (char *) data + len, size - len, 0);
+      }
 
       if (n < 1) {
          if (n == 0) {
@@ -160,6 +160,7 @@ typedef size_t          socklen_netx;
 #define NETX_GETSOCKOPT              getsockopt
 #define NETX_GETSOCKNAME             getsockname
 #define NETX_SELECT                  select
+#define NETX_POLL                    poll /* v2.5.35 */
 #define NETX_RECV                    recv
 #define NETX_SEND                    send
 #define NETX_SHUTDOWN                shutdown
@@ -389,6 +390,44 @@ int                     netx_load_winsock             (DBXCON *pcon, int context
 int                     netx_tcp_connect              (DBXCON *pcon, int context);
 int                     netx_tcp_handshake            (DBXCON *pcon, int context);
 int                     netx_tcp_command              (DBXMETH *pmeth, int command, int context);
+unsigned char *         netx_tcp_frame                (DBXMETH *pmeth, int command, unsigned int *netbuf_used);
+int                     netx_tcp_result               (DBXMETH *pmeth, int command, int len);
+int                     netx_tcp_command_batch        (DBXMETH *pmeth, DBXBATCH *pbatch, int context);
+int                     netx_tcp_command_stream       (DBXMETH *pmeth, DBXBATCH *pbatch, int context);
+int                     netx_tcp_response             (DBXMETH *pmeth, int context);
+#if !defined(_WIN32)
+int                     netx_tcp_command_pipe         (DBXMETH *pmeth, unsigned char *netbuf, unsigned int netbuf_used);
+int                     netx_db_unlock                (DBXCON *pcon);
+int                     netx_db_relock                (DBXCON *pcon, int unlocked);
+int                     netx_pool_command             (DBXCON *pcon, int command);
+int                     netx_pool_init                (DBXCON *pcon);
+DBXCON *                netx_pool_session             (DBXCON *pcon, DBXNETPOOL *ppool);
+DBXCON *                netx_pool_session_alloc       (DBXCON *pcon);
+int                     netx_pool_session_free        (DBXCON *psess);
+int                     netx_pool_connect             (DBXCON *psess, DBXNETPOOL *ppool);
+DBXCON *                netx_pool_acquire             (DBXCON *pcon, char *error);
+int                     netx_pool_release             (DBXCON *pcon, DBXCON *psess);
+int                     netx_pool_close               (DBXCON *pcon);
+int                     netx_tcp_command_pool         (DBXMETH *pmeth, unsigned char *netbuf, unsigned int netbuf_used);
+int                     netx_uv_command               (DBXMETH *pmeth);
+int                     netx_uv_init                  (DBXCON *pcon, uv_loop_t *loop);
+void                    netx_uv_open_task             (uv_work_t *req);
+void                    netx_uv_open_callback         (uv_work_t *req, int status);
+int                     netx_uv_submit                (DBXMETH *pmeth, int command, void *req, void *after_work_cb);
+void                    netx_uv_write_callback        (uv_write_t *req, int status);
+void                    netx_uv_alloc_callback        (uv_handle_t *handle, size_t suggested_size, uv_buf_t *buf);
+int                     netx_uv_rbuf_size             (DBXNETUV *pnetuv, unsigned int size);
+void                    netx_uv_read_callback         (uv_stream_t *stream, ssize_t nread, const uv_buf_t *buf);
+int                     netx_uv_deliver               (DBXNETUV *pnetuv, unsigned char *data, int len, int sort, int type);
+int                     netx_uv_complete              (DBXNETUV *pnetuv, DBXMETH *pmeth);
+void                    netx_uv_timer_callback        (uv_timer_t *handle);
+int                     netx_uv_fail                  (DBXNETUV *pnetuv, char *error);
+int                     netx_uv_shutdown              (DBXNETUV *pnetuv);
+void                    netx_uv_close_callback        (uv_handle_t *handle);
+int                     netx_uv_close                 (DBXCON *pcon);
+int                     netx_pipe_enter               (DBXMETH *pmeth);
+int                     netx_pipe_leave               (DBXMETH *pmeth);
+#endif
 int                     netx_tcp_connect_ex           (DBXCON *pcon, xLPSOCKADDR p_srv_addr, socklen_netx srv_addr_len, int timeout);
 int                     netx_tcp_disconnect           (DBXCON *pcon, int context);
 int                     netx_tcp_write                (DBXCON *pcon, unsigned char *data, int size);
@@ -0,0 +1,209 @@
+/*
+   ----------------------------------------------------------------------------
+   | mg-dbx: Tests for the 8-bit/16-bit character conversions                 |
+   | Author: Chris Munt cmunt@mgateway.com                                    |
+   |                    chris.e.munt@gmail.com                                |
+   | Copyright (c) 2019-2026 MGateway Ltd                                     |
+   | Surrey UK.                                                               |
+   | All rights reserved.                                                     |
+   |                                                                          |
+   | http://www.mgateway.com                                                  |
+   |                                                                          |
+   | Licensed under the Apache License, Version 2.0 (the "License"); you may  |
+   | not use this file except in compliance with the License.                 |
+   | You may obtain a copy of the License at                                  |
+   |                                                                          |
+   | http://www.apache.org/licenses/LICENSE-2.0                               |
+   |                                                                          |
+   | Unless required by applicable law or agreed to in writing, software      |
+   | distributed under the License is distributed on an "AS IS" BASIS,        |
+   | WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. |
+   | See the License for the specific language governing permissions and      |
+   | limitations under the License.                                           |
+   |                                                                          |
+   ----------------------------------------------------------------------------
+*/
+
+/*
+   The SSE2 conversions (dbx_char8_to_char16 and dbx_char16_to_char8) are checked against the scalar code, and both against the
+   expected result, over random lengths, buffer alignments and contents.  The module does not depend on Node.js, so the test is
+   built and run on its own (from the repository root):
+
+      g++ -O2 -Isrc test/test-char16.cpp src/mg-char16.cpp -o test-char16 && ./test-char16
+
+   Without SSE2 (other than on x86) both functions run the scalar code and the test checks that alone.
+   The exit status is 0 if all the checks pass.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mg-char16.h"
+
+#define TEST_MAX_LEN             4096
+#define TEST_GUARD               32
+#define TEST_ROUNDS              20000
+
+static unsigned int test_seed = 12345;
+static int test_failures = 0;
+
+static unsigned int test_random(void)
+{
+   test_seed = test_seed * 1103515245 + 12345;
+   return (test_seed >> 8) & 0xffffff;
+}
+
+
+static void test_fail(const char *test, unsigned int len, unsigned int align_from, unsigned int align_to, unsigned int n)
+{
+   if (test_failures < 20) {
+      printf("FAIL %s: len=%u; from+%u; to+%u; first difference at %u\n", test, len, align_from, align_to, n);
+   }
+   test_failures ++;
+}
+
+
+/* Fill with 'fill', convert 'len' characters at the given alignments and check the result and the guard areas either side */
+static void test_char8_to_char16(unsigned char *from, unsigned int len, unsigned int align_from, unsigned int align_to)
+{
+   unsigned int n;
+   static unsigned short to[TEST_MAX_LEN + (2 * TEST_GUARD)], to_scalar[TEST_MAX_LEN + (2 * TEST_GUARD)];
+   unsigned char *src;
+
+   src = from + align_from;
+   memset((void *) to, 0xa5, sizeof(to));
+   memset((void *) to_scalar, 0xa5, sizeof(to_scalar));
+
+   dbx_char8_to_char16(to + TEST_GUARD / 2 + align_to, src, len);
+   dbx_char8_to_char16_scalar(to_scalar + TEST_GUARD / 2 + align_to, src, len);
+
+   for (n = 0; n < (sizeof(to) / sizeof(to[0])); n ++) {
+      if (to[n] != to_scalar[n]) {
+         test_fail("char8_to_char16 (sse2 v scalar)", len, align_from, align_to, n);
+         return;
+      }
+   }
+   for (n = 0; n < len; n ++) {
+      if (to[TEST_GUARD / 2 + align_to + n] != (unsigned short) src[n]) {
+         test_fail("char8_to_char16 (expected)", len, align_from, align_to, n);
+         return;
+      }
+   }
+   for (n = 0; n < (TEST_GUARD / 2 + align_to); n ++) {
+      if (to[n] != 0xa5a5) {
+         test_fail("char8_to_char16 (guard before)", len, align_from, align_to, n);
+         return;
+      }
+   }
+   for (n = TEST_GUARD / 2 + align_to + len; n < (sizeof(to) / sizeof(to[0])); n ++) {
+      if (to[n] != 0xa5a5) {
+         test_fail("char8_to_char16 (guard after)", len, align_from, align_to, n);
+         return;
+      }
+   }
+}
+
+
+static void test_char16_to_char8(unsigned short *from, unsigned int len, unsigned int align_from, unsigned int align_to)
+{
+   unsigned int n;
+   static unsigned char to[TEST_MAX_LEN + (2 * TEST_GUARD)], to_scalar[TEST_MAX_LEN + (2 * TEST_GUARD)];
+   unsigned short *src;
+
+   src = from + align_from;
+   memset((void *) to, 0xa5, sizeof(to));
+   memset((void *) to_scalar, 0xa5, sizeof(to_scalar));
+
+   dbx_char16_to_char8(to + TEST_GUARD / 2 + align_to, src, len);
+   dbx_char16_to_char8_scalar(to_scalar + TEST_GUARD / 2 + align_to, src, len);
+
+   if (memcmp((void *) to, (void *) to_scalar, sizeof(to))) {
+      for (n = 0; to[n] == to_scalar[n]; n ++) {
+         ;
+      }
+      test_fail("char16_to_char8 (sse2 v scalar)", len, align_from, align_to, n);
+      return;
+   }
+   for (n = 0; n < len; n ++) {
+      if (to[TEST_GUARD / 2 + align_to + n] != (unsigned char) (src[n] & 0xff)) {
+         test_fail("char16_to_char8 (expected)", len, align_from, align_to, n);
+         return;
+      }
+   }
+   for (n = 0; n < (TEST_GUARD / 2 + align_to); n ++) {
+      if (to[n] != 0xa5) {
+         test_fail("char16_to_char8 (guard before)", len, align_from, align_to, n);
+         return;
+      }
+   }
+   for (n = TEST_GUARD / 2 + align_to + len; n < sizeof(to); n ++) {
+      if (to[n] != 0xa5) {
+         test_fail("char16_to_char8 (guard after)", len, align_from, align_to, n);
+         return;
+      }
+   }
+}
+
+
+int main(int argc, char *argv[])
+{
+   unsigned int n, round, len, align_from, align_to, range, checks;
+   static unsigned char from8[TEST_MAX_LEN + TEST_GUARD];
+   static unsigned short from16[TEST_MAX_LEN + TEST_GUARD];
+
+#if defined(DBX_SSE2)
+   printf("SSE2 conversions are checked against the scalar code\n");
+#else
+   printf("SSE2 is not available: the scalar code is checked\n");
+#endif
+
+   checks = 0;
+
+   /* every 8-bit value, and every 16-bit value, in one buffer */
+   for (n = 0; n < 256; n ++) {
+      from8[n] = (unsigned char) n;
+   }
+   test_char8_to_char16(from8, 256, 0, 0);
+   checks ++;
+   for (n = 0; n < 0x10000; n += TEST_MAX_LEN) {
+      for (len = 0; len < TEST_MAX_LEN; len ++) {
+         from16[len] = (unsigned short) (n + len);
+      }
+      test_char16_to_char8(from16, TEST_MAX_LEN, 0, 0);
+      checks ++;
+   }
+
+   /* every length (and alignment) around the sixteen character blocks */
+   for (len = 0; len <= 80; len ++) {
+      for (align_from = 0; align_from < 16; align_from ++) {
+         for (align_to = 0; align_to < 16; align_to ++) {
+            for (n = 0; n < (len + align_from); n ++) {
+               from8[n] = (unsigned char) test_random();
+               from16[n] = (unsigned short) test_random();
+            }
+            test_char8_to_char16(from8, len, align_from, align_to);
+            test_char16_to_char8(from16, len, align_from, align_to);
+            checks += 2;
+         }
+      }
+   }
+
+   /* random lengths, alignments and contents: 16-bit values are drawn from 0x00-0xFF, 0x00-0x7FF or the full range */
+   for (round = 0; round < TEST_ROUNDS; round ++) {
+      len = test_random() % (TEST_MAX_LEN - 16);
+      align_from = test_random() % 16;
+      align_to = test_random() % 16;
+      range = (round % 3 == 0) ? 0x100 : (round % 3 == 1) ? 0x800 : 0x10000;
+      for (n = 0; n < (len + align_from); n ++) {
+         from8[n] = (unsigned char) test_random();
+         from16[n] = (unsigned short) (test_random() % range);
+      }
+      test_char8_to_char16(from8, len, align_from, align_to);
+      test_char16_to_char8(from16, len, align_from, align_to);
+      checks += 2;
+   }
+
+   printf("%u checks; %d failed\n", checks, test_failures);
+   return test_failures ? 1 : 0;
+}